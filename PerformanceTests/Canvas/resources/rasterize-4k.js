@@ -0,0 +1,72 @@
+// Records a 4K canvas laid out like a long text page and times how long it
+// takes to play the recording back into a bitmap, which happens the first
+// time the pixels are read. The test turns on the 2D canvas display list
+// mode, which makes the recording, and parallel rasterization, which the
+// thread count applies to. It fails if the canvas is not recording.
+function runRasterize4KTest(threadCount) {
+    var width = 3840;
+    var height = 2160;
+    var canvas;
+
+    if (window.internals) {
+        window.internals.settings.setDisplayList2dCanvasEnabled(true);
+        window.internals.settings.setParallelRasterizationEnabled(true);
+        window.internals.settings.setRasterizationThreadCount(threadCount);
+    }
+
+    function drawPage(ctx) {
+        ctx.fillStyle = "white";
+        ctx.fillRect(0, 0, width, height);
+
+        var header = ctx.createLinearGradient(0, 0, 0, 160);
+        header.addColorStop(0, "#2a5db0");
+        header.addColorStop(1, "#8fb3ec");
+        ctx.fillStyle = header;
+        ctx.fillRect(0, 0, width, 160);
+
+        var columnWidth = 900;
+        for (var column = 0; column < 4; ++column) {
+            var left = 60 + column * (columnWidth + 60);
+            var line = 0;
+            for (var y = 220; y < height - 40; y += 24) {
+                if (++line % 12 == 0) {
+                    ctx.fillStyle = "rgba(" + (column * 60) + ", 120, 200, 0.3)";
+                    ctx.beginPath();
+                    ctx.arc(left + columnWidth / 2, y + 60, 50, 0, 2 * Math.PI);
+                    ctx.fill();
+                    ctx.strokeRect(left, y, columnWidth, 120);
+                    y += 120;
+                    continue;
+                }
+                ctx.fillStyle = "#222";
+                ctx.font = "18px sans-serif";
+                ctx.fillText("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.", left, y);
+            }
+        }
+    }
+
+    if (!window.internals)
+        PerfTestRunner.log("window.internals is not available. Run with the DisplayList2dCanvas and ParallelRasterization features enabled.");
+
+    PerfTestRunner.measureTime({
+        description: "Measures rasterizing a recorded 3840x2160 canvas page on up to " + threadCount + " thread(s).",
+        setup: function () {
+            canvas = document.createElement("canvas");
+            canvas.width = width;
+            canvas.height = height;
+            drawPage(canvas.getContext("2d"));
+            if (window.internals && !window.internals.isCanvasRecording(canvas))
+                throw new Error("The canvas is not recording, so there is nothing to rasterize.");
+        },
+        run: function () {
+            canvas.getContext("2d").getImageData(0, 0, 1, 1);
+        },
+        done: function () {
+            if (window.internals) {
+                window.internals.settings.setDisplayList2dCanvasEnabled(false);
+                window.internals.settings.setParallelRasterizationEnabled(false);
+                window.internals.settings.setRasterizationThreadCount(0);
+            }
+        }
+    });
+}
@@ -276,21 +276,16 @@ void ScriptStreamer::notifyAppendData(ScriptResource* resource)
     if (!m_firstDataChunkReceived) {
         m_firstDataChunkReceived = true;
         const char* histogramName = startedStreamingHistogramName(m_scriptType);
-        // Check the size of the first data chunk. The expectation is that if
-        // the first chunk is small, there won't be a second one. In those
-        // cases, it doesn't make sense to stream at all.
-        if (resource->resourceBuffer()->size() < kSmallScriptThreshold) {
+        if (!isLargeEnoughToStream(resource)) {
             suppressStreaming();
             blink::Platform::current()->histogramEnumeration(histogramName, 0, 2);
             return;
         }
-        if (ScriptStreamerThread::shared()->isRunningTask()) {
-            // At the moment we only have one thread for running the tasks. A
-            // new task shouldn't be queued before the running task completes,
-            // because the running task can block and wait for data from the
-            // network. At the moment we are only streaming parser blocking
-            // scripts, but this code can still be hit when multiple frames are
-            // loading simultaneously.
+        if (!ScriptStreamerThread::shared()->hasIdleThread()) {
+            // A new task shouldn't be queued behind a running task, because
+            // the running task can block and wait for data from the network.
+            // All the threads can be busy when several frames are loading
+            // simultaneously.
             suppressStreaming();
             blink::Platform::current()->histogramEnumeration(histogramName, 0, 2);
             return;
@@ -337,6 +332,21 @@ ScriptStreamer::ScriptStreamer(ScriptResource* resource, v8::ScriptCompiler::Str
 {
 }
 
+bool ScriptStreamer::isLargeEnoughToStream(ScriptResource* resource)
+{
+    // Content-Length is the best hint when the server sends it. It counts
+    // the bytes on the wire, which may be compressed, so it can only tell us
+    // that a script is large; it can't rule streaming out.
+    long long expectedContentLength = resource->response().expectedContentLength();
+    if (expectedContentLength > 0 && static_cast<unsigned long long>(expectedContentLength) >= kSmallScriptThreshold)
+        return true;
+
+    // Otherwise check the size of the first data chunk. The expectation is
+    // that if the first chunk is small, there won't be a second one. In those
+    // cases, it doesn't make sense to stream at all.
+    return resource->resourceBuffer()->size() >= kSmallScriptThreshold;
+}
+
 void ScriptStreamer::notifyFinishedToClient()
 {
     ASSERT(isMainThread());
@@ -386,9 +396,9 @@ bool ScriptStreamer::startStreamingInternal(PendingScript& script, Settings* set
         // Resource -> don't stream.
         return false;
     }
-    // We cannot filter out short scripts, even if we wait for the HTTP headers
-    // to arrive. In general, the web servers don't seem to send the
-    // Content-Length HTTP header for scripts.
+    // We cannot filter out short scripts here, since the HTTP headers haven't
+    // arrived yet. That is done when the first data chunk arrives (see
+    // isLargeEnoughToStream).
 
     WTF::TextEncoding textEncoding(resource->encoding());
     const char* encodingName = textEncoding.name();
@@ -22,8 +22,9 @@ class SourceStream;
 
 // ScriptStreamer streams incomplete script data to V8 so that it can be parsed
 // while it's loaded. PendingScript holds a reference to ScriptStreamer. At the
-// moment, ScriptStreamer is only used for parser blocking scripts; this means
-// that the Document stays stable and no other scripts are executing while we're
+// moment, ScriptStreamer is only used for parser blocking scripts (including
+// the ones inserted with document.write) and deferred scripts; this means that
+// the Document stays stable and no other scripts are executing while we're
 // streaming. It is possible, though, that Document and the PendingScript are
 // destroyed while the streaming is in progress, and ScriptStreamer handles it
 // gracefully.
@@ -89,6 +90,11 @@ public:
         kSmallScriptThreshold = 0;
     }
 
+    static void setSmallScriptThresholdForTesting(size_t threshold)
+    {
+        kSmallScriptThreshold = threshold;
+    }
+
     static size_t smallScriptThreshold() { return kSmallScriptThreshold; }
 
 private:
@@ -100,6 +106,10 @@ private:
 
     void notifyFinishedToClient();
 
+    // Decides, when the first data chunk arrives, whether the script is
+    // large enough to be worth streaming.
+    static bool isLargeEnoughToStream(ScriptResource*);
+
     static const char* startedStreamingHistogramName(PendingScript::Type);
 
     static bool startStreamingInternal(PendingScript&, Settings*, ScriptState*, PendingScript::Type);
@@ -277,6 +277,82 @@ TEST_F(ScriptStreamingTest, EmptyScripts)
     EXPECT_FALSE(sourceCode.streamer());
 }
 
+TEST_F(ScriptStreamingTest, ContentLengthHintEnablesStreaming)
+{
+    // A small first data chunk normally suppresses streaming, but not when
+    // Content-Length says that the script is large.
+    ScriptStreamer::setSmallScriptThresholdForTesting(100 * 1024);
+    m_resource->setResponse(ResourceResponse(KURL(), "application/javascript", 200 * 1024, "utf-8", String()));
+    ScriptStreamer::startStreaming(pendingScript(), m_settings.get(), m_scope.scriptState(), PendingScript::ParsingBlocking);
+    TestScriptResourceClient client;
+    pendingScript().watchForLoad(&client);
+
+    appendData("function foo() {");
+    EXPECT_TRUE(ScriptStreamerThread::shared()->isRunningTask());
+    appendPadding();
+    appendData("return 5; }");
+    finish();
+    processTasksUntilStreamingComplete();
+    EXPECT_TRUE(client.finished());
+
+    bool errorOccurred = false;
+    ScriptSourceCode sourceCode = pendingScript().getSource(KURL(), errorOccurred);
+    EXPECT_FALSE(errorOccurred);
+    EXPECT_TRUE(sourceCode.streamer());
+}
+
+TEST_F(ScriptStreamingTest, SmallFirstChunkSuppressesStreaming)
+{
+    ScriptStreamer::setSmallScriptThresholdForTesting(100 * 1024);
+    ScriptStreamer::startStreaming(pendingScript(), m_settings.get(), m_scope.scriptState(), PendingScript::ParsingBlocking);
+    TestScriptResourceClient client;
+    pendingScript().watchForLoad(&client);
+
+    appendData("function foo() { return 5; }");
+    EXPECT_FALSE(ScriptStreamerThread::shared()->isRunningTask());
+    finish();
+    EXPECT_TRUE(client.finished());
+
+    bool errorOccurred = false;
+    ScriptSourceCode sourceCode = pendingScript().getSource(KURL(), errorOccurred);
+    EXPECT_FALSE(errorOccurred);
+    EXPECT_FALSE(sourceCode.streamer());
+}
+
+TEST_F(ScriptStreamingTest, ConcurrentStreams)
+{
+    // A second script can be streamed while the first one is still waiting
+    // for data from the network.
+    ResourceRequest secondRequest("http://www.streaming-test.com/second.js");
+    ScriptResource* secondResource = new ScriptResource(secondRequest, "text/utf-8");
+    secondResource->setLoading(true);
+    OwnPtrWillBeRawPtr<PendingScriptWrapper> secondPendingScript = PendingScriptWrapper::create(0, secondResource);
+
+    ScriptStreamer::startStreaming(pendingScript(), m_settings.get(), m_scope.scriptState(), PendingScript::ParsingBlocking);
+    ScriptStreamer::startStreaming(secondPendingScript->get(), m_settings.get(), m_scope.scriptState(), PendingScript::Deferred);
+    TestScriptResourceClient client;
+    TestScriptResourceClient secondClient;
+    pendingScript().watchForLoad(&client);
+    secondPendingScript->get().watchForLoad(&secondClient);
+
+    appendData("function foo() {");
+    const char secondData[] = "function bar() {";
+    secondResource->appendData(secondData, strlen(secondData));
+    appendData("return 5; }");
+    secondResource->appendData("}", 1);
+    finish();
+    secondResource->finish();
+    secondResource->setLoading(false);
+    processTasksUntilStreamingComplete();
+    EXPECT_TRUE(client.finished());
+    EXPECT_TRUE(secondClient.finished());
+
+    bool errorOccurred = false;
+    EXPECT_TRUE(pendingScript().getSource(KURL(), errorOccurred).streamer());
+    EXPECT_TRUE(secondPendingScript->get().getSource(KURL(), errorOccurred).streamer());
+    EXPECT_FALSE(errorOccurred);
+}
+
 } // namespace
 
 } // namespace blink
@@ -35,31 +35,49 @@ ScriptStreamerThread* ScriptStreamerThread::shared()
     return s_sharedThread;
 }
 
-void ScriptStreamerThread::postTask(WebThread::Task* task)
+void ScriptStreamerThread::postTask(ScriptStreamingTask* task)
 {
     ASSERT(isMainThread());
+    size_t threadIndex;
+    {
+        MutexLocker locker(m_mutex);
+        ASSERT(m_runningTasks < maxThreads);
+        threadIndex = m_threadBusy.find(false);
+        RELEASE_ASSERT(threadIndex != kNotFound);
+        m_threadBusy[threadIndex] = true;
+        ++m_runningTasks;
+    }
+    task->m_threadIndex = threadIndex;
+    platformThread(threadIndex).postTask(task);
+}
+
+bool ScriptStreamerThread::hasIdleThread() const
+{
     MutexLocker locker(m_mutex);
-    ASSERT(!m_runningTask);
-    m_runningTask = true;
-    platformThread().postTask(task);
+    return m_runningTasks < maxThreads;
 }
 
-void ScriptStreamerThread::taskDone()
+void ScriptStreamerThread::taskDone(size_t threadIndex)
 {
     MutexLocker locker(m_mutex);
-    ASSERT(m_runningTask);
-    m_runningTask = false;
+    ASSERT(m_threadBusy[threadIndex]);
+    ASSERT(m_runningTasks);
+    m_threadBusy[threadIndex] = false;
+    --m_runningTasks;
 }
 
-blink::WebThread& ScriptStreamerThread::platformThread()
+blink::WebThread& ScriptStreamerThread::platformThread(size_t threadIndex)
 {
-    if (!isRunning())
-        m_thread = adoptPtr(blink::Platform::current()->createThread("ScriptStreamerThread"));
-    return *m_thread;
+    ASSERT(isMainThread());
+    if (m_threads.size() <= threadIndex)
+        m_threads.resize(threadIndex + 1);
+    if (!m_threads[threadIndex])
+        m_threads[threadIndex] = adoptPtr(blink::Platform::current()->createThread("ScriptStreamerThread"));
+    return *m_threads[threadIndex];
 }
 
 ScriptStreamingTask::ScriptStreamingTask(v8::ScriptCompiler::ScriptStreamingTask* task, ScriptStreamer* streamer)
-    : m_v8Task(adoptPtr(task)), m_streamer(streamer) { }
+    : m_v8Task(adoptPtr(task)), m_streamer(streamer), m_threadIndex(kNotFound) { }
 
 void ScriptStreamingTask::run()
 {
@@ -70,7 +88,7 @@ void ScriptStreamingTask::run()
     // Post a task to the main thread to signal that V8 has completed the
     // streaming.
     callOnMainThread(WTF::bind(&ScriptStreamer::streamingComplete, m_streamer));
-    ScriptStreamerThread::shared()->taskDone();
+    ScriptStreamerThread::shared()->taskDone(m_threadIndex);
 }
 
 } // namespace blink
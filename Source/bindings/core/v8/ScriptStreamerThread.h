@@ -8,14 +8,19 @@
 #include "platform/TaskSynchronizer.h"
 #include "public/platform/WebThread.h"
 #include "wtf/OwnPtr.h"
+#include "wtf/Vector.h"
 
 #include <v8.h>
 
 namespace blink {
 
 class ScriptStreamer;
+class ScriptStreamingTask;
 
-// A singleton thread for running background tasks for script streaming.
+// A singleton pool of threads for running background tasks for script
+// streaming. A streaming task blocks its thread while it waits for data from
+// the network, so each concurrently streamed script needs a thread of its
+// own. The threads are created lazily.
 class ScriptStreamerThread {
     WTF_MAKE_NONCOPYABLE(ScriptStreamerThread);
 public:
@@ -23,23 +28,28 @@ public:
     static void shutdown();
     static ScriptStreamerThread* shared();
 
-    void postTask(WebThread::Task*);
+    // The task must only be posted if hasIdleThread() returns true.
+    void postTask(ScriptStreamingTask*);
+
+    bool hasIdleThread() const;
 
     bool isRunningTask() const
     {
         MutexLocker locker(m_mutex);
-        return m_runningTask;
+        return m_runningTasks;
     }
 
-    void taskDone();
+    void taskDone(size_t threadIndex);
+
+    // Only one parser-blocking script per document streams at a time, but
+    // deferred scripts and other frames compete for the same threads.
+    static const size_t maxThreads = 3;
 
 private:
     ScriptStreamerThread()
-        : m_runningTask(false) { }
-
-    bool isRunning() const
+        : m_runningTasks(0)
     {
-        return !!m_thread;
+        m_threadBusy.fill(false, maxThreads);
     }
 
     void markAsCompleted(TaskSynchronizer* taskSynchronizer)
@@ -47,13 +57,12 @@ private:
         taskSynchronizer->taskCompleted();
     }
 
-    blink::WebThread& platformThread();
+    blink::WebThread& platformThread(size_t threadIndex);
 
-    // At the moment, we only use one thread, so we can only stream one script
-    // at a time. FIXME: Use a thread pool and stream multiple scripts.
-    WTF::OwnPtr<blink::WebThread> m_thread;
-    bool m_runningTask;
-    mutable Mutex m_mutex; // Guards m_runningTask.
+    Vector<OwnPtr<blink::WebThread>, maxThreads> m_threads; // Only used by the main thread.
+    Vector<bool, maxThreads> m_threadBusy;
+    size_t m_runningTasks;
+    mutable Mutex m_mutex; // Guards m_threadBusy and m_runningTasks.
 };
 
 class ScriptStreamingTask : public WebThread::Task {
@@ -63,8 +72,11 @@ public:
     virtual void run() OVERRIDE;
 
 private:
+    friend class ScriptStreamerThread;
+
     WTF::OwnPtr<v8::ScriptCompiler::ScriptStreamingTask> m_v8Task;
     ScriptStreamer* m_streamer;
+    size_t m_threadIndex; // Set by ScriptStreamerThread::postTask.
 };
 
 
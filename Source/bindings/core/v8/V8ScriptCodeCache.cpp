@@ -0,0 +1,224 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "bindings/core/v8/V8ScriptCodeCache.h"
+
+#include "core/fetch/CachedMetadata.h"
+#include "platform/TraceEvent.h"
+#include "wtf/Threading.h"
+
+namespace blink {
+
+namespace {
+
+// Once this many sources have been compiled exactly once, an arbitrary record
+// is forgotten; that source is then treated as new if it shows up again.
+const size_t maxCompiledOnceSources = 4096;
+
+// A stored record holds the source it was produced from, so that a key
+// collision can never hand V8 the code of another script:
+//   uint32_t source length | uint8_t is8Bit | source characters | CachedMetadata
+const size_t recordHeaderSize = sizeof(uint32_t) + sizeof(uint8_t);
+
+size_t sourceCharactersSize(const String& source)
+{
+    return source.is8Bit() ? source.length() : source.length() * sizeof(UChar);
+}
+
+const char* sourceCharacters(const String& source)
+{
+    return source.is8Bit() ? reinterpret_cast<const char*>(source.characters8()) : reinterpret_cast<const char*>(source.characters16());
+}
+
+void serializeRecord(const String& source, const Vector<char>& metadata, Vector<char>& record)
+{
+    uint32_t length = source.length();
+    uint8_t is8Bit = source.is8Bit();
+    record.reserveInitialCapacity(recordHeaderSize + sourceCharactersSize(source) + metadata.size());
+    record.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    record.append(reinterpret_cast<const char*>(&is8Bit), sizeof(is8Bit));
+    record.append(sourceCharacters(source), sourceCharactersSize(source));
+    record.appendVector(metadata);
+}
+
+// Returns the offset of the CachedMetadata in |record|, or 0 if |record| was
+// not produced from exactly |source|.
+size_t metadataOffsetIfRecordMatches(const Vector<char>& record, const String& source)
+{
+    if (record.size() < recordHeaderSize)
+        return 0;
+    uint32_t length;
+    memcpy(&length, record.data(), sizeof(length));
+    uint8_t is8Bit = record[sizeof(length)];
+    // The same text held as 8-bit and as 16-bit characters is treated as a
+    // different source rather than converted on every lookup.
+    if (length != source.length() || static_cast<bool>(is8Bit) != source.is8Bit())
+        return 0;
+    size_t charactersSize = sourceCharactersSize(source);
+    // The CachedMetadata needs at least its type ID and one byte of data.
+    if (record.size() - recordHeaderSize <= charactersSize + sizeof(unsigned))
+        return 0;
+    if (memcmp(record.data() + recordHeaderSize, sourceCharacters(source), charactersSize))
+        return 0;
+    return recordHeaderSize + charactersSize;
+}
+
+class MemoryStorage FINAL : public V8ScriptCodeCache::Storage {
+public:
+    MemoryStorage()
+        : m_size(0)
+    {
+    }
+
+    virtual bool load(uint64_t key, Vector<char>& data) OVERRIDE
+    {
+        HashMap<uint64_t, Vector<char> >::const_iterator it = m_entries.find(key);
+        if (it == m_entries.end())
+            return false;
+        data = it->value;
+        return true;
+    }
+
+    virtual void store(uint64_t key, const char* data, size_t size) OVERRIDE
+    {
+        if (size > capacity)
+            return;
+        HashMap<uint64_t, Vector<char> >::iterator it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            m_size -= it->value.size();
+            it->value.clear();
+            it->value.append(data, size);
+        } else {
+            Vector<char> entry;
+            entry.append(data, size);
+            m_entries.add(key, entry);
+            m_insertionOrder.append(key);
+        }
+        m_size += size;
+
+        while (m_size > capacity) {
+            uint64_t oldest = m_insertionOrder.takeFirst();
+            m_size -= m_entries.get(oldest).size();
+            m_entries.remove(oldest);
+        }
+    }
+
+private:
+    static const size_t capacity = 8 * 1024 * 1024;
+
+    HashMap<uint64_t, Vector<char> > m_entries;
+    Deque<uint64_t> m_insertionOrder;
+    size_t m_size;
+};
+
+} // namespace
+
+V8ScriptCodeCache& V8ScriptCodeCache::shared()
+{
+    AtomicallyInitializedStatic(V8ScriptCodeCache&, cache = *new V8ScriptCodeCache);
+    return cache;
+}
+
+V8ScriptCodeCache::V8ScriptCodeCache()
+    : m_storage(adoptPtr(new MemoryStorage))
+{
+}
+
+uint64_t V8ScriptCodeCache::keyForSource(const String& source)
+{
+    // StringImpl caches its hash, so this is cheap for sources which have
+    // been hashed before. The key only picks the record; the record is used
+    // only if its source matches in full.
+    return (static_cast<uint64_t>(source.impl()->hash()) << 32) | source.length();
+}
+
+V8ScriptCodeCache::CacheAction V8ScriptCodeCache::cacheActionFor(const String& source, unsigned dataTypeID, Vector<char>& data)
+{
+    ASSERT(!source.isEmpty());
+    uint64_t key = keyForSource(source);
+
+    MutexLocker locker(m_mutex);
+    Vector<char> record;
+    bool hasStaleCache = false;
+    size_t metadataOffset = m_storage->load(key, record) ? metadataOffsetIfRecordMatches(record, source) : 0;
+    if (metadataOffset) {
+        RefPtr<CachedMetadata> metadata = CachedMetadata::deserialize(record.data() + metadataOffset, record.size() - metadataOffset);
+        // Data produced by another version of V8 is replaced below.
+        if (metadata->dataTypeID() == dataTypeID) {
+            data.clear();
+            data.append(metadata->data(), metadata->size());
+            ++m_statistics.hits;
+            m_statistics.sourceCharactersSaved += source.length();
+            return ConsumeCache;
+        }
+        hasStaleCache = true;
+    }
+
+    ++m_statistics.misses;
+    if (m_compiledOnce.contains(key) || hasStaleCache) {
+        m_compiledOnce.remove(key);
+        return ProduceCache;
+    }
+
+    if (m_compiledOnce.size() >= maxCompiledOnceSources)
+        m_compiledOnce.remove(m_compiledOnce.begin());
+    m_compiledOnce.add(key);
+    return CompileWithoutCache;
+}
+
+void V8ScriptCodeCache::storeCache(const String& source, unsigned dataTypeID, const char* data, size_t size)
+{
+    TRACE_EVENT1("v8", "V8ScriptCodeCache::storeCache", "size", size);
+    RefPtr<CachedMetadata> metadata = CachedMetadata::create(dataTypeID, data, size);
+    Vector<char> record;
+    serializeRecord(source, metadata->serialize(), record);
+
+    MutexLocker locker(m_mutex);
+    m_storage->store(keyForSource(source), record.data(), record.size());
+    ++m_statistics.producedCaches;
+    m_statistics.producedBytes += size;
+}
+
+void V8ScriptCodeCache::didConsumeCache(size_t sourceLength)
+{
+    MutexLocker locker(m_mutex);
+    ++m_statistics.hits;
+    m_statistics.sourceCharactersSaved += sourceLength;
+}
+
+void V8ScriptCodeCache::didMissCache()
+{
+    MutexLocker locker(m_mutex);
+    ++m_statistics.misses;
+}
+
+void V8ScriptCodeCache::didProduceCache(size_t size)
+{
+    MutexLocker locker(m_mutex);
+    ++m_statistics.producedCaches;
+    m_statistics.producedBytes += size;
+}
+
+V8ScriptCodeCache::Statistics V8ScriptCodeCache::statistics() const
+{
+    MutexLocker locker(m_mutex);
+    return m_statistics;
+}
+
+void V8ScriptCodeCache::setStorageForTesting(PassOwnPtr<Storage> storage)
+{
+    MutexLocker locker(m_mutex);
+    m_storage = storage;
+}
+
+void V8ScriptCodeCache::resetForTesting()
+{
+    MutexLocker locker(m_mutex);
+    m_storage = adoptPtr(new MemoryStorage);
+    m_compiledOnce.clear();
+    m_statistics = Statistics();
+}
+
+} // namespace blink
@@ -0,0 +1,102 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8ScriptCodeCache_h
+#define V8ScriptCodeCache_h
+
+#include "wtf/Deque.h"
+#include "wtf/HashMap.h"
+#include "wtf/HashSet.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/OwnPtr.h"
+#include "wtf/PassOwnPtr.h"
+#include "wtf/ThreadingPrimitives.h"
+#include "wtf/Vector.h"
+#include "wtf/text/WTFString.h"
+
+namespace blink {
+
+// Keeps V8 code caches for scripts that have no Resource to carry
+// CachedMetadata, i.e. inline scripts and the scripts of dedicated workers,
+// when they are compiled with V8CacheOptionsCode. Entries are looked up by a
+// hash of the source text, and hold the full source they were produced from;
+// cached data is only handed out for an identical source, so a hash collision
+// only costs a full compile.
+//
+// The cache for a script is produced the second time its source is compiled,
+// so that scripts which only ever run once don't pay for producing it. The
+// cache is shared between the main thread and worker threads.
+class V8ScriptCodeCache {
+    WTF_MAKE_NONCOPYABLE(V8ScriptCodeCache);
+public:
+    // Where the cached data is kept. The default storage is an in-memory,
+    // size-bounded stand-in for the embedder's cache.
+    class Storage {
+    public:
+        virtual ~Storage() { }
+        virtual bool load(uint64_t key, Vector<char>& data) = 0;
+        virtual void store(uint64_t key, const char* data, size_t) = 0;
+    };
+
+    struct Statistics {
+        Statistics()
+            : hits(0)
+            , misses(0)
+            , producedCaches(0)
+            , producedBytes(0)
+            , sourceCharactersSaved(0)
+        {
+        }
+
+        unsigned hits;
+        unsigned misses;
+        unsigned producedCaches;
+        size_t producedBytes;
+        // Source characters which were compiled from a cache instead of parsed.
+        size_t sourceCharactersSaved;
+    };
+
+    enum CacheAction {
+        CompileWithoutCache,
+        ProduceCache,
+        ConsumeCache
+    };
+
+    static V8ScriptCodeCache& shared();
+
+    // Scripts shorter than this are not worth caching. The same threshold
+    // applies to scripts cached through their Resource.
+    static const unsigned minimumSourceLength = 1024;
+
+    // Decides how to compile |source|. For ConsumeCache, |data| is filled in
+    // with the cached data produced for |dataTypeID|.
+    CacheAction cacheActionFor(const String& source, unsigned dataTypeID, Vector<char>& data);
+    void storeCache(const String& source, unsigned dataTypeID, const char* data, size_t);
+
+    // Resource-backed scripts keep their caches in CachedMetadata but report
+    // to the same statistics.
+    void didConsumeCache(size_t sourceLength);
+    void didMissCache();
+    void didProduceCache(size_t);
+
+    Statistics statistics() const;
+
+    void setStorageForTesting(PassOwnPtr<Storage>);
+    void resetForTesting();
+
+private:
+    V8ScriptCodeCache();
+
+    static uint64_t keyForSource(const String&);
+
+    mutable Mutex m_mutex; // Guards all the members below.
+    OwnPtr<Storage> m_storage;
+    // Sources compiled once so far. Bounded, see cacheActionFor().
+    HashSet<uint64_t> m_compiledOnce;
+    Statistics m_statistics;
+};
+
+} // namespace blink
+
+#endif // V8ScriptCodeCache_h
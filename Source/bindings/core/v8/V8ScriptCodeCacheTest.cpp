@@ -0,0 +1,185 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "bindings/core/v8/V8ScriptCodeCache.h"
+
+#include "wtf/HashMap.h"
+#include "wtf/text/StringBuilder.h"
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+// Stands in for the embedder's disk cache: data is copied in and out, and
+// nothing is shared with the V8ScriptCodeCache.
+class TestStorage : public V8ScriptCodeCache::Storage {
+public:
+    TestStorage()
+        : m_loadCount(0)
+        , m_storeCount(0)
+        , m_collideAllKeys(false)
+    {
+    }
+
+    virtual bool load(uint64_t key, Vector<char>& data) OVERRIDE
+    {
+        ++m_loadCount;
+        HashMap<uint64_t, Vector<char> >::const_iterator it = m_entries.find(storedKey(key));
+        if (it == m_entries.end())
+            return false;
+        data = it->value;
+        return true;
+    }
+
+    virtual void store(uint64_t key, const char* data, size_t size) OVERRIDE
+    {
+        ++m_storeCount;
+        Vector<char> entry;
+        entry.append(data, size);
+        m_entries.set(storedKey(key), entry);
+    }
+
+    unsigned loadCount() const { return m_loadCount; }
+    unsigned storeCount() const { return m_storeCount; }
+
+    // Makes every source land on the same record.
+    void setCollideAllKeys(bool collide) { m_collideAllKeys = collide; }
+
+private:
+    uint64_t storedKey(uint64_t key) const { return m_collideAllKeys ? 1 : key; }
+
+    HashMap<uint64_t, Vector<char> > m_entries;
+    unsigned m_loadCount;
+    unsigned m_storeCount;
+    bool m_collideAllKeys;
+};
+
+class V8ScriptCodeCacheTest : public ::testing::Test {
+public:
+    virtual void SetUp() OVERRIDE
+    {
+        cache().resetForTesting();
+        m_storage = new TestStorage;
+        cache().setStorageForTesting(adoptPtr(m_storage));
+    }
+
+    virtual void TearDown() OVERRIDE
+    {
+        cache().resetForTesting();
+        m_storage = 0;
+    }
+
+    static V8ScriptCodeCache& cache() { return V8ScriptCodeCache::shared(); }
+
+    static String source(const char* name)
+    {
+        StringBuilder builder;
+        builder.append("var ");
+        builder.append(name);
+        builder.append(" = function() { return 1 + 1; };");
+        while (builder.length() < V8ScriptCodeCache::minimumSourceLength)
+            builder.append(" // padding");
+        return builder.toString();
+    }
+
+protected:
+    TestStorage* m_storage;
+};
+
+const unsigned tag = 42;
+
+TEST_F(V8ScriptCodeCacheTest, ProducesOnSecondCompile)
+{
+    String script = source("a");
+    Vector<char> data;
+    EXPECT_EQ(V8ScriptCodeCache::CompileWithoutCache, cache().cacheActionFor(script, tag, data));
+    EXPECT_EQ(V8ScriptCodeCache::ProduceCache, cache().cacheActionFor(script, tag, data));
+
+    const char producedData[] = "compiled code";
+    cache().storeCache(script, tag, producedData, sizeof(producedData));
+    EXPECT_EQ(1u, m_storage->storeCount());
+
+    EXPECT_EQ(V8ScriptCodeCache::ConsumeCache, cache().cacheActionFor(script, tag, data));
+    ASSERT_EQ(sizeof(producedData), data.size());
+    EXPECT_EQ(0, memcmp(producedData, data.data(), data.size()));
+
+    V8ScriptCodeCache::Statistics statistics = cache().statistics();
+    EXPECT_EQ(1u, statistics.hits);
+    EXPECT_EQ(2u, statistics.misses);
+    EXPECT_EQ(1u, statistics.producedCaches);
+    EXPECT_EQ(sizeof(producedData), statistics.producedBytes);
+    EXPECT_EQ(script.length(), statistics.sourceCharactersSaved);
+}
+
+TEST_F(V8ScriptCodeCacheTest, KeyedByContent)
+{
+    // A different String with the same contents finds the cache.
+    String script = source("a");
+    Vector<char> data;
+    cache().cacheActionFor(script, tag, data);
+    cache().cacheActionFor(script, tag, data);
+    cache().storeCache(script, tag, "x", 1);
+
+    String sameContents = source("a");
+    ASSERT_NE(script.impl(), sameContents.impl());
+    EXPECT_EQ(V8ScriptCodeCache::ConsumeCache, cache().cacheActionFor(sameContents, tag, data));
+
+    // A different script doesn't.
+    EXPECT_EQ(V8ScriptCodeCache::CompileWithoutCache, cache().cacheActionFor(source("b"), tag, data));
+}
+
+TEST_F(V8ScriptCodeCacheTest, KeyCollisionIsNotConsumed)
+{
+    // When two sources land on the same record, the record belongs to the
+    // one that produced it and must not be handed out for the other.
+    m_storage->setCollideAllKeys(true);
+    String script = source("a");
+    Vector<char> data;
+    cache().cacheActionFor(script, tag, data);
+    cache().cacheActionFor(script, tag, data);
+    cache().storeCache(script, tag, "x", 1);
+
+    String other = source("b");
+    ASSERT_EQ(script.length(), other.length());
+    EXPECT_NE(V8ScriptCodeCache::ConsumeCache, cache().cacheActionFor(other, tag, data));
+    EXPECT_EQ(V8ScriptCodeCache::ConsumeCache, cache().cacheActionFor(script, tag, data));
+}
+
+TEST_F(V8ScriptCodeCacheTest, StaleDataIsReplaced)
+{
+    // Data produced with another tag, e.g. by another version of V8, is not
+    // consumed, and is replaced right away.
+    String script = source("a");
+    Vector<char> data;
+    cache().cacheActionFor(script, tag, data);
+    cache().cacheActionFor(script, tag, data);
+    cache().storeCache(script, tag, "x", 1);
+
+    EXPECT_EQ(V8ScriptCodeCache::ProduceCache, cache().cacheActionFor(script, tag + 1, data));
+    cache().storeCache(script, tag + 1, "y", 1);
+    EXPECT_EQ(V8ScriptCodeCache::ConsumeCache, cache().cacheActionFor(script, tag + 1, data));
+    ASSERT_EQ(1u, data.size());
+    EXPECT_EQ('y', data[0]);
+}
+
+TEST_F(V8ScriptCodeCacheTest, ResourceStatistics)
+{
+    String script = source("a");
+    cache().didMissCache();
+    cache().didProduceCache(100);
+    cache().didConsumeCache(script.length());
+
+    V8ScriptCodeCache::Statistics statistics = cache().statistics();
+    EXPECT_EQ(1u, statistics.hits);
+    EXPECT_EQ(1u, statistics.misses);
+    EXPECT_EQ(1u, statistics.producedCaches);
+    EXPECT_EQ(100u, statistics.producedBytes);
+    EXPECT_EQ(script.length(), statistics.sourceCharactersSaved);
+}
+
+} // namespace
+
+} // namespace blink
@@ -31,10 +31,12 @@
 #include "bindings/core/v8/V8Binding.h"
 #include "bindings/core/v8/V8GCController.h"
 #include "bindings/core/v8/V8RecursionScope.h"
+#include "bindings/core/v8/V8ScriptCodeCache.h"
 #include "bindings/core/v8/V8ThrowException.h"
 #include "core/dom/ExecutionContext.h"
 #include "core/fetch/CachedMetadata.h"
 #include "core/fetch/ScriptResource.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/TraceEvent.h"
 
 namespace blink {
@@ -69,6 +71,10 @@ v8::Local<v8::Script> compileAndProduceCache(v8::Isolate* isolate, v8::Handle<v8
     v8::Local<v8::Script> script = v8::ScriptCompiler::Compile(isolate, &source, options);
     const v8::ScriptCompiler::CachedData* cachedData = source.GetCachedData();
     if (resource && cachedData) {
+        if (options == v8::ScriptCompiler::kProduceCodeCache) {
+            V8ScriptCodeCache::shared().didMissCache();
+            V8ScriptCodeCache::shared().didProduceCache(cachedData->length);
+        }
         resource->clearCachedMetadata();
         resource->setCachedMetadata(
             cacheTag,
@@ -88,9 +94,43 @@ v8::Local<v8::Script> compileAndConsumeCache(v8::Isolate* isolate, v8::Handle<v8
         cachedMetadata->size(),
         v8::ScriptCompiler::CachedData::BufferNotOwned);
     v8::ScriptCompiler::Source source(code, origin, cachedData);
+    if (options == v8::ScriptCompiler::kConsumeCodeCache)
+        V8ScriptCodeCache::shared().didConsumeCache(code->Length());
     return v8::ScriptCompiler::Compile(isolate, &source, options);
 }
 
+// For scripts without a Resource, e.g. inline and worker scripts.
+v8::Local<v8::Script> compileWithScriptCodeCache(v8::Isolate* isolate, v8::Handle<v8::String> code, v8::ScriptOrigin origin)
+{
+    // Strings made by v8String() are backed by the original StringImpl, so
+    // this doesn't copy the source.
+    String sourceString = toCoreString(code);
+    unsigned cacheTag = V8ScriptRunner::tagForCodeCache();
+    V8ScriptCodeCache& codeCache = V8ScriptCodeCache::shared();
+    Vector<char> data;
+    switch (codeCache.cacheActionFor(sourceString, cacheTag, data)) {
+    case V8ScriptCodeCache::ConsumeCache: {
+        v8::ScriptCompiler::CachedData* cachedData = new v8::ScriptCompiler::CachedData(
+            reinterpret_cast<const uint8_t*>(data.data()),
+            data.size(),
+            v8::ScriptCompiler::CachedData::BufferNotOwned);
+        v8::ScriptCompiler::Source source(code, origin, cachedData);
+        return v8::ScriptCompiler::Compile(isolate, &source, v8::ScriptCompiler::kConsumeCodeCache);
+    }
+    case V8ScriptCodeCache::ProduceCache: {
+        v8::ScriptCompiler::Source source(code, origin);
+        v8::Local<v8::Script> script = v8::ScriptCompiler::Compile(isolate, &source, v8::ScriptCompiler::kProduceCodeCache);
+        if (const v8::ScriptCompiler::CachedData* cachedData = source.GetCachedData())
+            codeCache.storeCache(sourceString, cacheTag, reinterpret_cast<const char*>(cachedData->data), cachedData->length);
+        return script;
+    }
+    case V8ScriptCodeCache::CompileWithoutCache:
+        break;
+    }
+    v8::ScriptCompiler::Source source(code, origin);
+    return v8::ScriptCompiler::Compile(isolate, &source, v8::ScriptCompiler::kNoCompileOptions);
+}
+
 } // namespace
 
 v8::Local<v8::Script> V8ScriptRunner::compileScript(const ScriptSourceCode& source, v8::Isolate* isolate, AccessControlStatus corsStatus, V8CacheOptions cacheOptions)
@@ -128,7 +168,9 @@ v8::Local<v8::Script> V8ScriptRunner::compileScript(v8::Handle<v8::String> code,
             resource->clearCachedMetadata();
             resource->setCachedMetadata(streamer->cachedDataType(), reinterpret_cast<const char*>(newCachedData->data), newCachedData->length);
         }
-    } else if (!resource || !resource->url().protocolIsInHTTPFamily() || code->Length() < 1024) {
+    } else if (!resource && cacheOptions == V8CacheOptionsCode && code->Length() >= V8ScriptCodeCache::minimumSourceLength && RuntimeEnabledFeatures::v8ScriptCodeCacheEnabled()) {
+        script = compileWithScriptCodeCache(isolate, code, origin);
+    } else if (!resource || !resource->url().protocolIsInHTTPFamily() || code->Length() < V8ScriptCodeCache::minimumSourceLength) {
         v8::ScriptCompiler::Source source(code, origin);
         script = v8::ScriptCompiler::Compile(isolate, &source, v8::ScriptCompiler::kNoCompileOptions);
     } else {
@@ -6,7 +6,9 @@
 #include "bindings/core/v8/V8ScriptRunner.h"
 
 #include "bindings/core/v8/V8Binding.h"
+#include "bindings/core/v8/V8ScriptCodeCache.h"
 #include "core/fetch/ScriptResource.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/heap/Handle.h"
 #include <gtest/gtest.h>
 #include <v8.h>
@@ -141,6 +143,42 @@ TEST_F(V8ScriptRunnerTest, codeOptions)
     // EXPECT_TRUE(m_resource->cachedMetadata(tagForCodeCache()));
 }
 
+TEST_F(V8ScriptRunnerTest, resourcelessUsesScriptCodeCache)
+{
+    bool wasEnabled = RuntimeEnabledFeatures::v8ScriptCodeCacheEnabled();
+    RuntimeEnabledFeatures::setV8ScriptCodeCacheEnabled(true);
+    V8ScriptCodeCache::shared().resetForTesting();
+
+    // Inline and worker scripts have no Resource; with code caching on, they
+    // go through the content-keyed cache instead.
+    EXPECT_TRUE(compileScript(V8CacheOptionsCode));
+    EXPECT_EQ(1u, V8ScriptCodeCache::shared().statistics().misses);
+    EXPECT_TRUE(compileScript(V8CacheOptionsCode));
+    EXPECT_TRUE(compileScript(V8CacheOptionsCode));
+    V8ScriptCodeCache::Statistics statistics = V8ScriptCodeCache::shared().statistics();
+    EXPECT_EQ(3u, statistics.hits + statistics.misses);
+
+    V8ScriptCodeCache::shared().resetForTesting();
+    RuntimeEnabledFeatures::setV8ScriptCodeCacheEnabled(wasEnabled);
+}
+
+TEST_F(V8ScriptRunnerTest, resourcelessCacheOptionsOff)
+{
+    bool wasEnabled = RuntimeEnabledFeatures::v8ScriptCodeCacheEnabled();
+    RuntimeEnabledFeatures::setV8ScriptCodeCacheEnabled(true);
+    V8ScriptCodeCache::shared().resetForTesting();
+
+    EXPECT_TRUE(compileScript(V8CacheOptionsOff));
+    EXPECT_TRUE(compileScript(V8CacheOptionsOff));
+    EXPECT_TRUE(compileScript(V8CacheOptionsParse));
+    V8ScriptCodeCache::Statistics statistics = V8ScriptCodeCache::shared().statistics();
+    EXPECT_EQ(0u, statistics.hits + statistics.misses);
+    EXPECT_EQ(0u, statistics.producedCaches);
+
+    V8ScriptCodeCache::shared().resetForTesting();
+    RuntimeEnabledFeatures::setV8ScriptCodeCacheEnabled(wasEnabled);
+}
+
 } // namespace
 
 } // namespace blink
@@ -33,6 +33,7 @@
 
 #include "bindings/core/v8/ScriptValue.h"
 #include "bindings/core/v8/V8Binding.h"
+#include "bindings/core/v8/V8CacheOptions.h"
 #include "wtf/OwnPtr.h"
 #include "wtf/ThreadingPrimitives.h"
 #include "wtf/text/TextPosition.h"
@@ -54,6 +55,10 @@ public:
     bool isExecutionTerminating() const;
     void evaluate(const ScriptSourceCode&, RefPtrWillBeRawPtr<ErrorEvent>* = 0);
 
+    // How the scripts of the worker use the V8 code cache. Taken from the
+    // Settings of the document that started the worker.
+    void setV8CacheOptions(V8CacheOptions v8CacheOptions) { m_v8CacheOptions = v8CacheOptions; }
+
     // Prevents future JavaScript execution. See
     // scheduleExecutionTermination, isExecutionForbidden.
     void forbidExecution();
@@ -97,6 +102,7 @@ private:
     String m_disableEvalPending;
     bool m_executionForbidden;
     bool m_executionScheduledToTerminate;
+    V8CacheOptions m_v8CacheOptions;
     mutable Mutex m_scheduledTerminationMutex;
 
     // |m_globalScopeExecutionState| refers to a stack object
@@ -1991,6 +1991,17 @@ void Document::updateLayoutIgnorePendingStylesheets(Document::RunPostLayoutTasks
         view()->flushAnyPendingPostLayoutTasks();
 }
 
+void Document::updateLayoutIgnorePendingStylesheetsForNode(Node* node)
+{
+    ASSERT(node);
+    updateLayoutIgnorePendingStylesheets();
+
+    // A deferred renderer only has an estimated position and size.
+    RenderObject* renderer = node->renderer();
+    if (renderer && renderer->markLayoutDeferredAncestorsForLayout())
+        updateLayoutIgnorePendingStylesheets();
+}
+
 PassRefPtr<RenderStyle> Document::styleForElementIgnoringPendingStylesheets(Element* element)
 {
     ASSERT_ARG(element, element->document() == this);
@@ -462,6 +462,9 @@ public:
         RunPostLayoutTasksSynchronously,
     };
     void updateLayoutIgnorePendingStylesheets(RunPostLayoutTasks = RunPostLayoutTasksAsyhnchronously);
+    // Also lays out the node's renderer if its layout was deferred, for callers
+    // that read the node's geometry.
+    void updateLayoutIgnorePendingStylesheetsForNode(Node*);
     PassRefPtr<RenderStyle> styleForElementIgnoringPendingStylesheets(Element*);
     PassRefPtr<RenderStyle> styleForPage(int pageIndex);
 
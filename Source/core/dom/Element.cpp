@@ -447,7 +447,7 @@ bool Element::shouldIgnoreAttributeCase() const
 
 void Element::scrollIntoView(bool alignToTop)
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (!renderer())
         return;
@@ -462,7 +462,7 @@ void Element::scrollIntoView(bool alignToTop)
 
 void Element::scrollIntoViewIfNeeded(bool centerIfNeeded)
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (!renderer())
         return;
@@ -507,7 +507,7 @@ static double adjustForLocalZoom(LayoutUnit value, RenderObject& renderer)
 
 int Element::offsetLeft()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBoxModelObject* renderer = renderBoxModelObject())
         return lroundf(adjustForLocalZoom(renderer->offsetLeft(), *renderer));
     return 0;
@@ -515,7 +515,7 @@ int Element::offsetLeft()
 
 int Element::offsetTop()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBoxModelObject* renderer = renderBoxModelObject())
         return lroundf(adjustForLocalZoom(renderer->pixelSnappedOffsetTop(), *renderer));
     return 0;
@@ -523,7 +523,7 @@ int Element::offsetTop()
 
 int Element::offsetWidth()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBoxModelObject* renderer = renderBoxModelObject())
         return adjustLayoutUnitForAbsoluteZoom(renderer->pixelSnappedOffsetWidth(), *renderer).round();
     return 0;
@@ -531,7 +531,7 @@ int Element::offsetWidth()
 
 int Element::offsetHeight()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBoxModelObject* renderer = renderBoxModelObject())
         return adjustLayoutUnitForAbsoluteZoom(renderer->pixelSnappedOffsetHeight(), *renderer).round();
     return 0;
@@ -547,7 +547,7 @@ Element* Element::offsetParentForBindings()
 
 Element* Element::offsetParent()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderObject* renderer = this->renderer())
         return renderer->offsetParent();
     return 0;
@@ -555,7 +555,7 @@ Element* Element::offsetParent()
 
 int Element::clientLeft()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (RenderBox* renderer = renderBox())
         return adjustLayoutUnitForAbsoluteZoom(roundToInt(renderer->clientLeft()), *renderer);
@@ -564,7 +564,7 @@ int Element::clientLeft()
 
 int Element::clientTop()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (RenderBox* renderer = renderBox())
         return adjustLayoutUnitForAbsoluteZoom(roundToInt(renderer->clientTop()), *renderer);
@@ -573,7 +573,7 @@ int Element::clientTop()
 
 int Element::clientWidth()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     // When in strict mode, clientWidth for the document element should return the width of the containing frame.
     // When in quirks mode, clientWidth for the body element should return the width of the containing frame.
@@ -593,7 +593,7 @@ int Element::clientWidth()
 
 int Element::clientHeight()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     // When in strict mode, clientHeight for the document element should return the height of the containing frame.
     // When in quirks mode, clientHeight for the body element should return the height of the containing frame.
@@ -614,7 +614,7 @@ int Element::clientHeight()
 
 double Element::scrollLeft()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (document().documentElement() != this) {
         if (RenderBox* rend = renderBox())
@@ -637,7 +637,7 @@ double Element::scrollLeft()
 
 double Element::scrollTop()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (document().documentElement() != this) {
         if (RenderBox* rend = renderBox())
@@ -660,7 +660,7 @@ double Element::scrollTop()
 
 void Element::setScrollLeft(double newLeft)
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (document().documentElement() != this) {
         if (RenderBox* rend = renderBox())
@@ -706,7 +706,7 @@ void Element::setScrollLeft(const Dictionary& scrollOptionsHorizontal, Exception
 
 void Element::setScrollTop(double newTop)
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (document().documentElement() != this) {
         if (RenderBox* rend = renderBox())
@@ -752,7 +752,7 @@ void Element::setScrollTop(const Dictionary& scrollOptionsVertical, ExceptionSta
 
 int Element::scrollWidth()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBox* rend = renderBox())
         return adjustLayoutUnitForAbsoluteZoom(rend->scrollWidth(), *rend).toDouble();
     return 0;
@@ -760,7 +760,7 @@ int Element::scrollWidth()
 
 int Element::scrollHeight()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBox* rend = renderBox())
         return adjustLayoutUnitForAbsoluteZoom(rend->scrollHeight(), *rend).toDouble();
     return 0;
@@ -768,7 +768,7 @@ int Element::scrollHeight()
 
 IntRect Element::boundsInRootViewSpace()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     FrameView* view = document().view();
     if (!view)
@@ -800,7 +800,7 @@ IntRect Element::boundsInRootViewSpace()
 
 PassRefPtrWillBeRawPtr<ClientRectList> Element::getClientRects()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     RenderBoxModelObject* renderBoxModelObject = this->renderBoxModelObject();
     if (!renderBoxModelObject)
@@ -817,7 +817,7 @@ PassRefPtrWillBeRawPtr<ClientRectList> Element::getClientRects()
 
 PassRefPtrWillBeRawPtr<ClientRect> Element::getBoundingClientRect()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     Vector<FloatQuad> quads;
     if (isSVGElement() && renderer() && !renderer()->isSVGRoot()) {
@@ -2040,7 +2040,7 @@ void Element::focus(bool restorePreviousSelection, FocusType type)
         return;
 
     // Setting the focused node above might have invalidated the layout due to scripts.
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (!isFocusable())
         return;
 
@@ -2297,7 +2297,7 @@ void Element::insertAdjacentHTML(const String& where, const String& markup, Exce
 String Element::innerText()
 {
     // We need to update layout, since plainText uses line boxes in the render tree.
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (!renderer())
         return textContent(true);
@@ -61,6 +61,16 @@ CachePolicy FetchContext::cachePolicy(Document*) const
     return CachePolicyVerify;
 }
 
+size_t FetchContext::maxConcurrentLoadsPerHost() const
+{
+    return 6;
+}
+
+size_t FetchContext::maxLowPriorityLoadsWhileRenderBlocked() const
+{
+    return 1;
+}
+
 void FetchContext::dispatchWillSendRequest(DocumentLoader*, unsigned long, ResourceRequest&, const ResourceResponse&, const FetchInitiatorInfo&)
 {
 }
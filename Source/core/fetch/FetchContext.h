@@ -69,6 +69,10 @@ public:
     virtual void setFirstPartyForCookies(ResourceRequest&);
     virtual CachePolicy cachePolicy(Document*) const;
 
+    // Limits applied by the ResourceLoadScheduler.
+    virtual size_t maxConcurrentLoadsPerHost() const;
+    virtual size_t maxLowPriorityLoadsWhileRenderBlocked() const;
+
     virtual void dispatchDidChangeResourcePriority(unsigned long identifier, ResourceLoadPriority, int intraPriorityValue);
     virtual void dispatchWillSendRequest(DocumentLoader*, unsigned long identifier, ResourceRequest&, const ResourceResponse& redirectResponse, const FetchInitiatorInfo& = FetchInitiatorInfo());
     virtual void dispatchDidLoadResourceFromMemoryCache(const ResourceRequest&, const ResourceResponse&);
@@ -49,6 +49,8 @@ static const unsigned cDeferredPruneDeadCapacityFactor = 2;
 static const int cMinDelayBeforeLiveDecodedPrune = 1; // Seconds.
 static const double cMaxPruneDeferralDelay = 0.5; // Seconds.
 static const float cTargetPrunePercentage = .95f; // Percentage of capacity toward which we prune, to avoid immediately pruning again.
+static const unsigned cProtectedSegmentMinFrequency = 1; // Cache hits seen before a resource is promoted out of probation.
+static const float cMaxProtectedDeadPercentage = .8f; // Share of the dead capacity that protected resources may hold.
 
 MemoryCache* memoryCache()
 {
@@ -91,6 +93,55 @@ void MemoryCacheLRUList::trace(Visitor* visitor)
     visitor->trace(m_tail);
 }
 
+MemoryCacheFrequencySketch::MemoryCacheFrequencySketch()
+{
+    clear();
+}
+
+void MemoryCacheFrequencySketch::clear()
+{
+    memset(m_counters, 0, sizeof(m_counters));
+    m_additions = 0;
+}
+
+size_t MemoryCacheFrequencySketch::index(unsigned hash, size_t row)
+{
+    // Derive one independent-looking hash per row from the URL hash.
+    static const unsigned seeds[depth] = { 0x97cb3127, 0xc2b2ae35, 0x27d4eb2f, 0x165667b1 };
+    return WTF::intHash(hash ^ seeds[row]) & (width - 1);
+}
+
+void MemoryCacheFrequencySketch::increment(unsigned hash)
+{
+    bool incremented = false;
+    for (size_t row = 0; row < depth; ++row) {
+        uint8_t& counter = m_counters[row][index(hash, row)];
+        if (counter < maxCount) {
+            ++counter;
+            incremented = true;
+        }
+    }
+    if (incremented && ++m_additions >= sampleSize)
+        age();
+}
+
+unsigned MemoryCacheFrequencySketch::estimate(unsigned hash) const
+{
+    unsigned frequency = maxCount;
+    for (size_t row = 0; row < depth; ++row)
+        frequency = std::min<unsigned>(frequency, m_counters[row][index(hash, row)]);
+    return frequency;
+}
+
+void MemoryCacheFrequencySketch::age()
+{
+    for (size_t row = 0; row < depth; ++row) {
+        for (size_t column = 0; column < width; ++column)
+            m_counters[row][column] >>= 1;
+    }
+    m_additions /= 2;
+}
+
 inline MemoryCache::MemoryCache()
     : m_inPruneResources(false)
     , m_prunePending(false)
@@ -102,6 +153,12 @@ inline MemoryCache::MemoryCache()
     , m_delayBeforeLiveDecodedPrune(cMinDelayBeforeLiveDecodedPrune)
     , m_liveSize(0)
     , m_deadSize(0)
+    , m_maxDeadDecodedCapacity(cDefaultCacheCapacity)
+    , m_maxDeadDecodedCapacityIsSet(false)
+    , m_deadDecodedSize(0)
+    , m_protectedDeadSize(0)
+    , m_demotionCursor(nullptr)
+    , m_demotionListIndex(0)
 #ifdef MEMORY_CACHE_STATS
     , m_statsTimer(this, &MemoryCache::dumpStats)
 #endif
@@ -132,6 +189,7 @@ void MemoryCache::trace(Visitor* visitor)
         visitor->trace(m_liveDecodedResources[i]);
     visitor->trace(m_resources);
     visitor->trace(m_liveResources);
+    visitor->trace(m_demotionCursor);
 #endif
 }
 
@@ -157,6 +215,11 @@ void MemoryCache::add(Resource* resource)
     m_resources.set(resource->url().string(), MemoryCacheEntry::create(resource));
     update(resource, 0, resource->size(), true);
 
+    // Adding is not a request for the resource, but a URL that was hit before
+    // it got evicted is admitted straight into the protected segment.
+    if (m_frequencySketch.estimate(StringHash::hash(resource->url().string())) >= cProtectedSegmentMinFrequency)
+        setSegment(m_resources.get(resource->url()), MemoryCacheProtectedSegment);
+
     WTF_LOG(ResourceLoading, "MemoryCache::add Added '%s', resource %p\n", resource->url().string().latin1().data(), resource);
 }
 
@@ -262,8 +325,86 @@ void MemoryCache::pruneLiveResources()
     }
 }
 
+void MemoryCache::pruneDeadDecodedData()
+{
+    if (m_deadDecodedSize <= m_maxDeadDecodedCapacity)
+        return;
+
+    size_t targetSize = static_cast<size_t>(m_maxDeadDecodedCapacity * cTargetPrunePercentage);
+
+    // Drop decoded data only, starting from the least valuable resources.
+    // The encoded data stays, so a later hit only costs a decode.
+    for (int i = m_allResources.size() - 1; i >= 0; i--) {
+        MemoryCacheEntry* current = m_allResources[i].m_tail;
+        while (current) {
+            MemoryCacheEntry* previous = current->m_previousInAllResourcesList;
+            if (current->m_decodedSize && !current->m_resource->hasClients() && !current->m_resource->isPreloaded() && current->m_resource->isLoaded()) {
+                current->m_resource->pruneDecodedData();
+                if (m_deadDecodedSize <= targetSize)
+                    return;
+            }
+            if (previous && !contains(previous->m_resource.get()))
+                break;
+            current = previous;
+        }
+    }
+}
+
+void MemoryCache::demoteProtectedResources(size_t deadCapacity)
+{
+    size_t maxProtectedDeadSize = static_cast<size_t>(deadCapacity * cMaxProtectedDeadPercentage);
+    if (m_protectedDeadSize <= maxProtectedDeadSize || m_allResources.isEmpty())
+        return;
+
+    if (m_demotionListIndex >= m_allResources.size()) {
+        m_demotionListIndex = m_allResources.size() - 1;
+        m_demotionCursor = nullptr;
+    }
+
+    // Walk from the least valuable entries towards the most valuable ones,
+    // resuming where the previous walk stopped and wrapping around at most
+    // once.
+    for (size_t listsVisited = 0; listsVisited <= m_allResources.size(); ++listsVisited) {
+        MemoryCacheEntry* current = m_demotionCursor;
+        if (!current)
+            current = m_allResources[m_demotionListIndex].m_tail;
+        while (current && m_protectedDeadSize > maxProtectedDeadSize) {
+            MemoryCacheEntry* previous = current->m_previousInAllResourcesList;
+            if (current->m_segment == MemoryCacheProtectedSegment && !current->m_resource->hasClients())
+                setSegment(current, MemoryCacheProbationarySegment);
+            current = previous;
+        }
+        if (current) {
+            m_demotionCursor = current;
+            return;
+        }
+        m_demotionCursor = nullptr;
+        m_demotionListIndex = m_demotionListIndex ? m_demotionListIndex - 1 : m_allResources.size() - 1;
+        if (m_protectedDeadSize <= maxProtectedDeadSize)
+            return;
+    }
+}
+
+void MemoryCache::setSegment(MemoryCacheEntry* entry, MemoryCacheSegment segment)
+{
+    if (entry->m_segment == segment)
+        return;
+    entry->m_segment = segment;
+    if (entry->m_resource->hasClients() || !contains(entry->m_resource.get()))
+        return;
+    size_t size = entry->m_resource->size();
+    if (segment == MemoryCacheProtectedSegment) {
+        m_protectedDeadSize += size;
+    } else {
+        ASSERT(m_protectedDeadSize >= size);
+        m_protectedDeadSize -= size;
+    }
+}
+
 void MemoryCache::pruneDeadResources()
 {
+    pruneDeadDecodedData();
+
     size_t capacity = deadCapacity();
     if (!m_deadSize || (capacity && m_deadSize <= capacity))
         return;
@@ -292,7 +433,20 @@ void MemoryCache::pruneDeadResources()
     if (targetSize && m_deadSize <= targetSize)
         return;
 
-    bool canShrinkLRULists = true;
+    // Keep protected resources from monopolizing the dead capacity, so that
+    // new resources get a chance to prove themselves.
+    demoteProtectedResources(capacity);
+
+    pruneDeadResourcesInSegment(MemoryCacheProbationarySegment, targetSize);
+    if (targetSize && m_deadSize <= targetSize)
+        return;
+    pruneDeadResourcesInSegment(MemoryCacheProtectedSegment, targetSize);
+}
+
+void MemoryCache::pruneDeadResourcesInSegment(MemoryCacheSegment segment, size_t targetSize)
+{
+    int size = m_allResources.size();
+    bool canShrinkLRULists = segment == MemoryCacheProtectedSegment;
     for (int i = size - 1; i >= 0; i--) {
         // Remove from the tail, since this is the least frequently accessed of the objects.
         MemoryCacheEntry* current = m_allResources[i].m_tail;
@@ -302,7 +456,7 @@ void MemoryCache::pruneDeadResources()
             // Protect 'previous' so it can't get deleted during destroyDecodedData().
             MemoryCacheEntry* previous = current->m_previousInAllResourcesList;
             ASSERT(!previous || contains(previous->m_resource.get()));
-            if (!current->m_resource->hasClients() && !current->m_resource->isPreloaded() && current->m_resource->isLoaded()) {
+            if (current->m_segment == segment && !current->m_resource->hasClients() && !current->m_resource->isPreloaded() && current->m_resource->isLoaded()) {
                 // Destroy our decoded data. This will remove us from
                 // m_liveDecodedResources, and possibly move us to a different
                 // LRU list in m_allResources.
@@ -323,7 +477,7 @@ void MemoryCache::pruneDeadResources()
         while (current) {
             MemoryCacheEntry* previous = current->m_previousInAllResourcesList;
             ASSERT(!previous || contains(previous->m_resource.get()));
-            if (!current->m_resource->hasClients() && !current->m_resource->isPreloaded()
+            if (current->m_segment == segment && !current->m_resource->hasClients() && !current->m_resource->isPreloaded()
                 && !current->m_resource->isCacheValidator() && current->m_resource->canDelete()
                 && current->m_resource->type() != Resource::MainResource) {
                 // Main Resources in the cache are only substitue data that was
@@ -354,10 +508,18 @@ void MemoryCache::setCapacities(size_t minDeadBytes, size_t maxDeadBytes, size_t
     m_minDeadCapacity = minDeadBytes;
     m_maxDeadCapacity = maxDeadBytes;
     m_maxDeferredPruneDeadCapacity = cDeferredPruneDeadCapacityFactor * maxDeadBytes;
+    if (!m_maxDeadDecodedCapacityIsSet)
+        m_maxDeadDecodedCapacity = maxDeadBytes;
     m_capacity = totalBytes;
     prune();
 }
 
+void MemoryCache::setMaxDeadDecodedCapacity(size_t bytes)
+{
+    m_maxDeadDecodedCapacity = bytes;
+    m_maxDeadDecodedCapacityIsSet = true;
+}
+
 bool MemoryCache::evict(MemoryCacheEntry* entry)
 {
     ASSERT(WTF::isMainThread());
@@ -408,6 +570,9 @@ void MemoryCache::removeFromLRUList(MemoryCacheEntry* entry, MemoryCacheLRUList*
     entry->m_nextInAllResourcesList = nullptr;
     entry->m_previousInAllResourcesList = nullptr;
 
+    if (m_demotionCursor == entry)
+        m_demotionCursor = previous;
+
     if (next)
         next->m_previousInAllResourcesList = previous;
     else
@@ -517,6 +682,13 @@ void MemoryCache::makeLive(Resource* resource)
     ASSERT(m_deadSize >= resource->size());
     m_liveSize += resource->size();
     m_deadSize -= resource->size();
+    MemoryCacheEntry* entry = m_resources.get(resource->url());
+    ASSERT(m_deadDecodedSize >= entry->m_decodedSize);
+    m_deadDecodedSize -= entry->m_decodedSize;
+    if (entry->m_segment == MemoryCacheProtectedSegment) {
+        ASSERT(m_protectedDeadSize >= resource->size());
+        m_protectedDeadSize -= resource->size();
+    }
 }
 
 void MemoryCache::makeDead(Resource* resource)
@@ -525,7 +697,11 @@ void MemoryCache::makeDead(Resource* resource)
         return;
     m_liveSize -= resource->size();
     m_deadSize += resource->size();
-    removeFromLiveDecodedResourcesList(m_resources.get(resource->url()));
+    MemoryCacheEntry* entry = m_resources.get(resource->url());
+    m_deadDecodedSize += entry->m_decodedSize;
+    if (entry->m_segment == MemoryCacheProtectedSegment)
+        m_protectedDeadSize += resource->size();
+    removeFromLiveDecodedResourcesList(entry);
 }
 
 void MemoryCache::update(Resource* resource, size_t oldSize, size_t newSize, bool wasAccessed)
@@ -544,13 +720,33 @@ void MemoryCache::update(Resource* resource, size_t oldSize, size_t newSize, boo
         insertInLRUList(entry, lruListFor(entry->m_accessCount, newSize));
 
     ptrdiff_t delta = newSize - oldSize;
+    size_t decodedSize = newSize ? resource->decodedSize() : 0;
     if (resource->hasClients()) {
         ASSERT(delta >= 0 || m_liveSize >= static_cast<size_t>(-delta) );
         m_liveSize += delta;
     } else {
         ASSERT(delta >= 0 || m_deadSize >= static_cast<size_t>(-delta) );
         m_deadSize += delta;
+        if (entry->m_segment == MemoryCacheProtectedSegment) {
+            ASSERT(delta >= 0 || m_protectedDeadSize >= static_cast<size_t>(-delta));
+            m_protectedDeadSize += delta;
+        }
+        ASSERT(m_deadDecodedSize + decodedSize >= entry->m_decodedSize);
+        m_deadDecodedSize = m_deadDecodedSize + decodedSize - entry->m_decodedSize;
     }
+    entry->m_decodedSize = decodedSize;
+}
+
+void MemoryCache::updateForAccess(Resource* resource)
+{
+    if (!contains(resource))
+        return;
+    update(resource, resource->size(), resource->size(), true);
+
+    unsigned hash = StringHash::hash(resource->url().string());
+    m_frequencySketch.increment(hash);
+    if (m_frequencySketch.estimate(hash) >= cProtectedSegmentMinFrequency)
+        setSegment(m_resources.get(resource->url()), MemoryCacheProtectedSegment);
 }
 
 void MemoryCache::updateDecodedResource(Resource* resource, UpdateReason reason, MemoryCacheLiveResourcePriority priority)
@@ -582,6 +778,12 @@ MemoryCacheLiveResourcePriority MemoryCache::priority(Resource* resource) const
     return entry->m_liveResourcePriority;
 }
 
+MemoryCacheSegment MemoryCache::segment(Resource* resource) const
+{
+    ASSERT(contains(resource));
+    return m_resources.get(resource->url())->m_segment;
+}
+
 void MemoryCache::removeURLFromCache(ExecutionContext* context, const KURL& url)
 {
     if (context->isWorkerGlobalScope()) {
@@ -659,7 +861,7 @@ void MemoryCache::prune(Resource* justReleasedResource)
 
     if (m_inPruneResources)
         return;
-    if (m_liveSize + m_deadSize <= m_capacity && m_maxDeadCapacity && m_deadSize <= m_maxDeadCapacity) // Fast path.
+    if (m_liveSize + m_deadSize <= m_capacity && m_maxDeadCapacity && m_deadSize <= m_maxDeadCapacity && m_deadDecodedSize <= m_maxDeadDecodedCapacity) // Fast path.
         return;
 
     // To avoid burdening the current thread with repetitive pruning jobs,
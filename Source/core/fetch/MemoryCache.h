@@ -68,6 +68,14 @@ enum MemoryCacheLiveResourcePriority {
     MemoryCacheLiveResourcePriorityUnknown
 };
 
+// Segments of the segmented LRU. Resources enter the cache on probation and
+// are promoted once the frequency sketch has seen their URL often enough.
+// Probationary resources are always evicted before protected ones.
+enum MemoryCacheSegment {
+    MemoryCacheProbationarySegment = 0,
+    MemoryCacheProtectedSegment
+};
+
 enum UpdateReason {
     UpdateForAccess,
     UpdateForPropertyChange
@@ -85,6 +93,8 @@ public:
     bool m_inLiveDecodedResourcesList;
     unsigned m_accessCount;
     MemoryCacheLiveResourcePriority m_liveResourcePriority;
+    MemoryCacheSegment m_segment;
+    size_t m_decodedSize; // The decoded size last accounted for by the cache.
     double m_lastDecodedAccessTime; // Used as a thrash guard
 
     RawPtrWillBeMember<MemoryCacheEntry> m_previousInLiveResourcesList;
@@ -98,6 +108,8 @@ private:
         , m_inLiveDecodedResourcesList(false)
         , m_accessCount(0)
         , m_liveResourcePriority(MemoryCacheLiveResourcePriorityLow)
+        , m_segment(MemoryCacheProbationarySegment)
+        , m_decodedSize(0)
         , m_lastDecodedAccessTime(0.0)
         , m_previousInLiveResourcesList(nullptr)
         , m_nextInLiveResourcesList(nullptr)
@@ -120,6 +132,34 @@ public:
     void trace(Visitor*);
 };
 
+// A count-min sketch of how often each URL has been requested, used as the
+// admission filter of the segmented LRU (in the spirit of TinyLFU). The
+// sketch outlives cache entries, so a URL that keeps coming back is protected
+// as soon as it is re-added, while one-off resources stay on probation.
+// Counters saturate at 15 and are periodically halved so that the history
+// adapts to changing access patterns.
+class MemoryCacheFrequencySketch {
+public:
+    MemoryCacheFrequencySketch();
+
+    void increment(unsigned hash);
+    unsigned estimate(unsigned hash) const;
+    void clear();
+
+    static const unsigned maxCount = 15;
+
+private:
+    static const size_t depth = 4;
+    static const size_t width = 1024;
+    static const size_t sampleSize = 10 * width;
+
+    static size_t index(unsigned hash, size_t row);
+    void age();
+
+    uint8_t m_counters[depth][width];
+    size_t m_additions;
+};
+
 }
 
 WTF_ALLOW_MOVE_INIT_AND_COMPARE_WITH_MEM_FUNCTIONS(blink::MemoryCacheLRUList);
@@ -182,6 +222,11 @@ public:
     //  - maxDeadBytes: The maximum number of bytes that dead resources should consume when the cache is not under pressure.
     //  - totalBytes: The maximum number of bytes that the cache should consume overall.
     void setCapacities(size_t minDeadBytes, size_t maxDeadBytes, size_t totalBytes);
+    // Bounds the decoded bytes held by dead resources, independently of the
+    // dead capacity which accounts for encoded and decoded bytes together.
+    // Until this is called, it follows the max dead capacity, i.e. it adds no
+    // extra constraint.
+    void setMaxDeadDecodedCapacity(size_t bytes);
     void setDelayBeforeLiveDecodedPrune(double seconds) { m_delayBeforeLiveDecodedPrune = seconds; }
     void setMaxPruneDeferralDelay(double seconds) { m_maxPruneDeferralDelay = seconds; }
 
@@ -191,7 +236,9 @@ public:
 
     // Called to adjust a resource's size, lru list position, and access count.
     void update(Resource*, size_t oldSize, size_t newSize, bool wasAccessed = false);
-    void updateForAccess(Resource* resource) { update(resource, resource->size(), resource->size(), true); }
+    // Records a cache hit. Only hits count towards promoting a resource out
+    // of probation.
+    void updateForAccess(Resource*);
     void updateDecodedResource(Resource*, UpdateReason, MemoryCacheLiveResourcePriority = MemoryCacheLiveResourcePriorityUnknown);
 
     void makeLive(Resource*);
@@ -211,9 +258,12 @@ public:
     size_t capacity() const { return m_capacity; }
     size_t liveSize() const { return m_liveSize; }
     size_t deadSize() const { return m_deadSize; }
+    size_t maxDeadDecodedCapacity() const { return m_maxDeadDecodedCapacity; }
+    size_t deadDecodedSize() const { return m_deadDecodedSize; }
 
     // Exposed for testing
     MemoryCacheLiveResourcePriority priority(Resource*) const;
+    MemoryCacheSegment segment(Resource*) const;
 
     // TaskObserver implementation
     virtual void willProcessTask() OVERRIDE;
@@ -243,6 +293,10 @@ private:
     // pruneDeadResources() - Flush decoded and encoded data from resources not referenced by Web pages.
     // pruneLiveResources() - Flush decoded data from resources still referenced by Web pages.
     void pruneDeadResources(); // Automatically decide how much to prune.
+    void pruneDeadDecodedData();
+    void pruneDeadResourcesInSegment(MemoryCacheSegment, size_t targetSize);
+    void demoteProtectedResources(size_t deadCapacity);
+    void setSegment(MemoryCacheEntry*, MemoryCacheSegment);
     void pruneLiveResources();
     void pruneNow(double currentTime);
 
@@ -264,6 +318,18 @@ private:
 
     size_t m_liveSize; // The number of bytes currently consumed by "live" resources in the cache.
     size_t m_deadSize; // The number of bytes currently consumed by "dead" resources in the cache.
+    size_t m_maxDeadDecodedCapacity;
+    bool m_maxDeadDecodedCapacityIsSet;
+    size_t m_deadDecodedSize; // The part of m_deadSize that is decoded data.
+    size_t m_protectedDeadSize; // The part of m_deadSize that is held by protected resources.
+
+    MemoryCacheFrequencySketch m_frequencySketch;
+
+    // Where demoteProtectedResources() stopped, so that the next call does not
+    // rescan the entries that it already looked at. A null cursor means the
+    // tail of m_allResources[m_demotionListIndex].
+    RawPtrWillBeMember<MemoryCacheEntry> m_demotionCursor;
+    size_t m_demotionListIndex;
 
     // Size-adjusted and popularity-aware LRU list collection for cache objects. This collection can hold
     // more resources than the cached resource map, since it can also hold "stale" multiple versions of objects that are
@@ -404,4 +404,176 @@ TEST_F(MemoryCacheTest, RemoveDuringRevalidation)
     EXPECT_FALSE(memoryCache()->contains(resource3.get()));
 }
 
+TEST_F(MemoryCacheTest, FrequencySketch)
+{
+    MemoryCacheFrequencySketch sketch;
+    const unsigned hash = StringHash::hash(String("http://test/resource"));
+    EXPECT_EQ(0u, sketch.estimate(hash));
+
+    sketch.increment(hash);
+    sketch.increment(hash);
+    // A count-min sketch never underestimates.
+    EXPECT_GE(sketch.estimate(hash), 2u);
+
+    for (unsigned i = 0; i < 2 * MemoryCacheFrequencySketch::maxCount; ++i)
+        sketch.increment(hash);
+    EXPECT_EQ(MemoryCacheFrequencySketch::maxCount, sketch.estimate(hash));
+
+    sketch.clear();
+    EXPECT_EQ(0u, sketch.estimate(hash));
+}
+
+// Verifies that resources are admitted on probation and promoted once their
+// URL has been requested again, even across evictions.
+TEST_F(MemoryCacheTest, SegmentPromotion)
+{
+    ResourcePtr<FakeResource> resource1 = new FakeResource(ResourceRequest("http://test/script.js"), Resource::Script);
+    memoryCache()->add(resource1.get());
+    EXPECT_EQ(MemoryCacheProbationarySegment, memoryCache()->segment(resource1.get()));
+
+    memoryCache()->updateForAccess(resource1.get());
+    EXPECT_EQ(MemoryCacheProtectedSegment, memoryCache()->segment(resource1.get()));
+
+    memoryCache()->remove(resource1.get());
+    ResourcePtr<FakeResource> resource2 = new FakeResource(ResourceRequest("http://test/script.js"), Resource::Script);
+    memoryCache()->add(resource2.get());
+    EXPECT_EQ(MemoryCacheProtectedSegment, memoryCache()->segment(resource2.get()));
+
+    ResourcePtr<FakeResource> resource3 = new FakeResource(ResourceRequest("http://test/once.png"), Resource::Image);
+    memoryCache()->add(resource3.get());
+    EXPECT_EQ(MemoryCacheProbationarySegment, memoryCache()->segment(resource3.get()));
+}
+
+// Verifies that adding a resource, as revalidation does, is not counted as a
+// request for it.
+TEST_F(MemoryCacheTest, ReplaceDoesNotPromote)
+{
+    ResourcePtr<FakeResource> resource1 = new FakeResource(ResourceRequest("http://test/style.css"), Resource::CSSStyleSheet);
+    memoryCache()->add(resource1.get());
+    ResourcePtr<FakeResource> resource2 = new FakeResource(ResourceRequest("http://test/style.css"), Resource::CSSStyleSheet);
+    memoryCache()->replace(resource2.get(), resource1.get());
+    ResourcePtr<FakeResource> resource3 = new FakeResource(ResourceRequest("http://test/style.css"), Resource::CSSStyleSheet);
+    memoryCache()->replace(resource3.get(), resource2.get());
+    EXPECT_EQ(MemoryCacheProbationarySegment, memoryCache()->segment(resource3.get()));
+}
+
+// Verifies that a large resource used once is evicted before a larger one
+// that is used repeatedly, which plain size-adjusted LRU gets wrong.
+TEST_F(MemoryCacheTest, ProbationaryResourcesEvictedFirst)
+{
+    memoryCache()->setMaxPruneDeferralDelay(0);
+    memoryCache()->setCapacities(0, 600000, 600000);
+
+    FakeResource* script = new FakeResource(ResourceRequest("http://test/app.js"), Resource::Script);
+    script->fakeEncodedSize(400000);
+    memoryCache()->add(script);
+    memoryCache()->updateForAccess(script);
+
+    FakeResource* image1 = new FakeResource(ResourceRequest("http://test/1.jpg"), Resource::Image);
+    image1->fakeEncodedSize(150000);
+    memoryCache()->add(image1);
+    FakeResource* image2 = new FakeResource(ResourceRequest("http://test/2.jpg"), Resource::Image);
+    image2->fakeEncodedSize(150000);
+    memoryCache()->add(image2);
+
+    memoryCache()->prune();
+    EXPECT_TRUE(memoryCache()->resourceForURL(KURL(ParsedURLString, "http://test/app.js")));
+    EXPECT_FALSE(memoryCache()->resourceForURL(KURL(ParsedURLString, "http://test/1.jpg")));
+    EXPECT_TRUE(memoryCache()->resourceForURL(KURL(ParsedURLString, "http://test/2.jpg")));
+}
+
+// Verifies that decoded data of dead resources is bounded separately from
+// their encoded data.
+TEST_F(MemoryCacheTest, DeadDecodedCapacity)
+{
+    memoryCache()->setMaxPruneDeferralDelay(0);
+    memoryCache()->setCapacities(0, 1000000, 1000000);
+
+    Resource* resource = new FakeDecodedResource(ResourceRequest("http://test/decoded"), Resource::Raw);
+    const char data[5] = "abcd";
+    resource->appendData(data, 4);
+    memoryCache()->add(resource);
+    ASSERT_GT(resource->decodedSize(), 0u);
+    ASSERT_EQ(resource->decodedSize(), memoryCache()->deadDecodedSize());
+
+    memoryCache()->setMaxDeadDecodedCapacity(0);
+    memoryCache()->prune();
+    EXPECT_TRUE(memoryCache()->contains(resource));
+    EXPECT_EQ(0u, resource->decodedSize());
+    EXPECT_EQ(0u, memoryCache()->deadDecodedSize());
+    EXPECT_EQ(resource->size(), memoryCache()->deadSize());
+}
+
+TEST_F(MemoryCacheTest, MaxDeadDecodedCapacityOutlivesSetCapacities)
+{
+    memoryCache()->setCapacities(0, 1000000, 1000000);
+    EXPECT_EQ(1000000u, memoryCache()->maxDeadDecodedCapacity());
+
+    memoryCache()->setMaxDeadDecodedCapacity(1000);
+    memoryCache()->setCapacities(0, 2000000, 2000000);
+    EXPECT_EQ(1000u, memoryCache()->maxDeadDecodedCapacity());
+}
+
+// Access log recorded while paging through a photo gallery: every page
+// reuses the same script bundle and style sheet and shows one new photo.
+struct TraceEntry {
+    const char* url;
+    Resource::Type type;
+    size_t encodedSize;
+};
+
+static const TraceEntry galleryTrace[] = {
+    { "http://gallery/app.js", Resource::Script, 400000 },
+    { "http://gallery/style.css", Resource::CSSStyleSheet, 40000 },
+    { "http://gallery/photos/1.jpg", Resource::Image, 120000 },
+    { "http://gallery/app.js", Resource::Script, 400000 },
+    { "http://gallery/style.css", Resource::CSSStyleSheet, 40000 },
+    { "http://gallery/photos/2.jpg", Resource::Image, 120000 },
+    { "http://gallery/app.js", Resource::Script, 400000 },
+    { "http://gallery/style.css", Resource::CSSStyleSheet, 40000 },
+    { "http://gallery/photos/3.jpg", Resource::Image, 120000 },
+    { "http://gallery/app.js", Resource::Script, 400000 },
+    { "http://gallery/style.css", Resource::CSSStyleSheet, 40000 },
+    { "http://gallery/photos/4.jpg", Resource::Image, 120000 },
+    { "http://gallery/app.js", Resource::Script, 400000 },
+    { "http://gallery/style.css", Resource::CSSStyleSheet, 40000 },
+    { "http://gallery/photos/5.jpg", Resource::Image, 120000 },
+    { "http://gallery/app.js", Resource::Script, 400000 },
+    { "http://gallery/style.css", Resource::CSSStyleSheet, 40000 },
+    { "http://gallery/photos/6.jpg", Resource::Image, 120000 },
+};
+
+// Replays a trace against the global cache, pruning after every request
+// like a page load would, and returns the number of cache hits.
+static unsigned replayTrace(const TraceEntry* trace, size_t length)
+{
+    unsigned hits = 0;
+    for (size_t i = 0; i < length; ++i) {
+        KURL url(ParsedURLString, trace[i].url);
+        if (Resource* resource = memoryCache()->resourceForURL(url)) {
+            memoryCache()->updateForAccess(resource);
+            ++hits;
+            continue;
+        }
+        MemoryCacheTest::FakeResource* resource = new MemoryCacheTest::FakeResource(ResourceRequest(url), trace[i].type);
+        resource->fakeEncodedSize(trace[i].encodedSize);
+        memoryCache()->add(resource);
+        memoryCache()->prune();
+    }
+    return hits;
+}
+
+TEST_F(MemoryCacheTest, GalleryTraceHitRate)
+{
+    memoryCache()->setMaxPruneDeferralDelay(0);
+    memoryCache()->setCapacities(0, 600000, 600000);
+
+    const size_t length = WTF_ARRAY_LENGTH(galleryTrace);
+    const unsigned pages = length / 3;
+    // Every script and style sheet request after the first page is a hit;
+    // the photos are never requested twice.
+    EXPECT_EQ(2 * (pages - 1), replayTrace(galleryTrace, length));
+    EXPECT_TRUE(memoryCache()->resourceForURL(KURL(ParsedURLString, "http://gallery/app.js")));
+}
+
 } // namespace
@@ -252,6 +252,8 @@ public:
 
     // Used by the MemoryCache to reduce the memory consumption of the entry.
     void prune();
+    // Like prune(), but leaves the encoded data locked.
+    void pruneDecodedData() { destroyDecodedDataIfPossible(); }
 
     static const char* resourceTypeToString(Type, const FetchInitiatorInfo&);
 
@@ -254,6 +254,7 @@ ResourceFetcher::ResourceFetcher(DocumentLoader* documentLoader)
     , m_requestCount(0)
     , m_garbageCollectDocumentResourcesTimer(this, &ResourceFetcher::garbageCollectDocumentResourcesTimerFired)
     , m_resourceTimingReportTimer(this, &ResourceFetcher::resourceTimingReportTimerFired)
+    , m_loadSchedulerTimer(this, &ResourceFetcher::loadSchedulerTimerFired)
     , m_autoLoadImages(true)
     , m_imagesEnabled(true)
     , m_allowStaleResources(false)
@@ -267,6 +268,9 @@ ResourceFetcher::~ResourceFetcher()
 
     clearPreloads();
 
+    if (m_loadScheduler)
+        m_loadScheduler->cancelPendingLoads();
+
     // Make sure no requests still point to this ResourceFetcher
     ASSERT(!m_requestCount);
 }
@@ -719,6 +723,9 @@ ResourcePtr<Resource> ResourceFetcher::requestResource(Resource::Type type, Fetc
         if (priority != resource->resourceRequest().priority()) {
             resource->mutableResourceRequest().setPriority(priority);
             resource->didChangePriority(priority, 0);
+            // A queued load that was promoted may be able to start now.
+            if (m_loadScheduler)
+                m_loadScheduler->dispatchPendingLoads();
         }
     }
 
@@ -729,8 +736,18 @@ ResourcePtr<Resource> ResourceFetcher::requestResource(Resource::Type type, Fetc
             return 0;
         }
 
-        if (!m_documentLoader || !m_documentLoader->scheduleArchiveLoad(resource.get(), request.resourceRequest()))
-            resource->load(this, request.options());
+        if (!m_documentLoader || !m_documentLoader->scheduleArchiveLoad(resource.get(), request.resourceRequest())) {
+            if (shouldScheduleLoad(type, request)) {
+                loadScheduler().schedule(resource.get(), request.options());
+            } else {
+                // A synchronous request can reuse a resource whose load is
+                // still queued, and so has no ResourceLoader yet. Start it
+                // here instead of letting the scheduler start it again later.
+                if (m_loadScheduler)
+                    m_loadScheduler->removePendingLoad(resource.get());
+                resource->load(this, request.options());
+            }
+        }
 
         // For asynchronous loads that immediately fail, it's sufficient to return a
         // null Resource, as it indicates that something prevented the load from starting.
@@ -1331,6 +1348,8 @@ void ResourceFetcher::didInitializeResourceLoader(ResourceLoader* loader)
 
 void ResourceFetcher::willTerminateResourceLoader(ResourceLoader* loader)
 {
+    if (m_loadScheduler)
+        m_loadScheduler->loadFinished(loader->cachedResource());
     if (m_loaders && m_loaders->contains(loader))
         m_loaders->remove(loader);
     if (m_multipartLoaders && m_multipartLoaders->contains(loader))
@@ -1350,6 +1369,8 @@ void ResourceFetcher::willStartLoadingResource(Resource* resource, ResourceReque
 
 void ResourceFetcher::stopFetching()
 {
+    if (m_loadScheduler)
+        m_loadScheduler->cancelPendingLoads();
     if (m_multipartLoaders)
         m_multipartLoaders->cancelAll();
     if (m_loaders)
@@ -1358,7 +1379,43 @@ void ResourceFetcher::stopFetching()
 
 bool ResourceFetcher::isFetching() const
 {
-    return m_loaders && !m_loaders->isEmpty();
+    return (m_loaders && !m_loaders->isEmpty()) || (m_loadScheduler && m_loadScheduler->hasPendingLoads());
+}
+
+bool ResourceFetcher::shouldScheduleLoad(Resource::Type type, const FetchRequest& request) const
+{
+    if (!RuntimeEnabledFeatures::resourceLoadSchedulerEnabled())
+        return false;
+    // Main resources and synchronous loads must never wait behind subresources.
+    return type != Resource::MainResource && request.options().synchronousPolicy == RequestAsynchronously;
+}
+
+ResourceLoadScheduler& ResourceFetcher::loadScheduler()
+{
+    if (!m_loadScheduler)
+        m_loadScheduler = ResourceLoadScheduler::create(this, context());
+    return *m_loadScheduler;
+}
+
+bool ResourceFetcher::startScheduledLoad(Resource* resource, const ResourceLoaderOptions& options)
+{
+    resource->load(this, options);
+    // Loads that never created a ResourceLoader (failed before starting,
+    // deferred images, ...) will not be terminated later on.
+    return resource->loader();
+}
+
+void ResourceFetcher::scheduleDispatchOfPendingLoads()
+{
+    if (m_loadScheduler && m_loadScheduler->hasPendingLoads() && !m_loadSchedulerTimer.isActive())
+        m_loadSchedulerTimer.startOneShot(0, FROM_HERE);
+}
+
+void ResourceFetcher::loadSchedulerTimerFired(Timer<ResourceFetcher>* timer)
+{
+    ASSERT_UNUSED(timer, timer == &m_loadSchedulerTimer);
+    if (m_loadScheduler)
+        m_loadScheduler->dispatchPendingLoads();
 }
 
 void ResourceFetcher::setDefersLoading(bool defers)
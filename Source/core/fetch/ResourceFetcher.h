@@ -31,6 +31,7 @@
 #include "core/fetch/FetchRequest.h"
 #include "core/fetch/Resource.h"
 #include "core/fetch/ResourceLoaderHost.h"
+#include "core/fetch/ResourceLoadScheduler.h"
 #include "core/fetch/ResourceLoaderOptions.h"
 #include "core/fetch/ResourcePtr.h"
 #include "platform/Timer.h"
@@ -68,7 +69,7 @@ class ResourceLoaderSet;
 // RefPtr<ResourceFetcher> for their lifetime (and will create one if they
 // are initialized without a LocalFrame), so a Document can keep a ResourceFetcher
 // alive past detach if scripts still reference the Document.
-class ResourceFetcher FINAL : public RefCountedWillBeGarbageCollectedFinalized<ResourceFetcher>, public ResourceLoaderHost {
+class ResourceFetcher FINAL : public RefCountedWillBeGarbageCollectedFinalized<ResourceFetcher>, public ResourceLoaderHost, public ResourceLoadScheduler::Client {
     WTF_MAKE_NONCOPYABLE(ResourceFetcher); WTF_MAKE_FAST_ALLOCATED_WILL_BE_REMOVED;
     WILL_BE_USING_GARBAGE_COLLECTED_MIXIN(ResourceFetcher);
 friend class ImageLoader;
@@ -123,7 +124,9 @@ public:
 
     void garbageCollectDocumentResources();
 
-    int requestCount() const { return m_requestCount; }
+    // Loads queued by the ResourceLoadScheduler count as requests, so that
+    // the load event is not dispatched before they have started.
+    int requestCount() const { return m_requestCount + (m_loadScheduler ? m_loadScheduler->pendingCount() : 0); }
 
     bool isPreloaded(const String& urlString) const;
     void clearPreloads();
@@ -155,6 +158,11 @@ public:
     virtual bool canAccessRedirect(Resource*, ResourceRequest&, const ResourceResponse&, ResourceLoaderOptions&) OVERRIDE;
     virtual bool canAccessResource(Resource*, SecurityOrigin*, const KURL&) const OVERRIDE;
 
+    // ResourceLoadScheduler::Client
+    virtual bool startScheduledLoad(Resource*, const ResourceLoaderOptions&) OVERRIDE;
+    // Also called when the priorities of queued loads may have changed.
+    virtual void scheduleDispatchOfPendingLoads() OVERRIDE;
+
 #if !ENABLE(OILPAN)
     virtual void refResourceLoaderHost() OVERRIDE;
     virtual void derefResourceLoaderHost() OVERRIDE;
@@ -198,6 +206,10 @@ private:
 
     void resourceTimingReportTimerFired(Timer<ResourceFetcher>*);
 
+    bool shouldScheduleLoad(Resource::Type, const FetchRequest&) const;
+    ResourceLoadScheduler& loadScheduler();
+    void loadSchedulerTimerFired(Timer<ResourceFetcher>*);
+
     bool clientDefersImage(const KURL&) const;
     void reloadImagesIfNotDeferred();
 
@@ -215,6 +227,9 @@ private:
 
     Timer<ResourceFetcher> m_garbageCollectDocumentResourcesTimer;
     Timer<ResourceFetcher> m_resourceTimingReportTimer;
+    Timer<ResourceFetcher> m_loadSchedulerTimer;
+
+    OwnPtr<ResourceLoadScheduler> m_loadScheduler;
 
     typedef HashMap<Resource*, RefPtr<ResourceTimingInfo> > ResourceTimingInfoMap;
     ResourceTimingInfoMap m_resourceTimingInfoMap;
@@ -37,8 +37,16 @@
 #include "core/fetch/MemoryCache.h"
 #include "core/fetch/ResourcePtr.h"
 #include "core/html/HTMLDocument.h"
+#include "core/fetch/RawResource.h"
 #include "core/loader/DocumentLoader.h"
+#include "core/testing/DummyPageHolder.h"
+#include "core/testing/URLTestHelpers.h"
+#include "core/testing/UnitTestHelpers.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/network/ResourceRequest.h"
+#include "public/platform/Platform.h"
+#include "public/platform/WebURLRequest.h"
+#include "public/platform/WebUnitTestSupport.h"
 
 using namespace blink;
 
@@ -65,4 +73,52 @@ TEST(ResourceFetcherTest, StartLoadAfterFrameDetach)
     EXPECT_EQ(memoryCache()->resourceForURL(testURL), static_cast<Resource*>(0));
 }
 
+TEST(ResourceFetcherTest, SynchronousRequestStartsQueuedLoad)
+{
+    bool schedulerWasEnabled = RuntimeEnabledFeatures::resourceLoadSchedulerEnabled();
+    RuntimeEnabledFeatures::setResourceLoadSchedulerEnabled(true);
+
+    OwnPtr<DummyPageHolder> dummyPageHolder = DummyPageHolder::create();
+    ResourceFetcher* fetcher = dummyPageHolder->document().fetcher();
+    int initialRequestCount = fetcher->requestCount();
+
+    // Saturate the host, so that the next asynchronous load has to wait in
+    // the ResourceLoadScheduler.
+    const size_t maxLoadsPerHost = fetcher->context().maxConcurrentLoadsPerHost();
+    Vector<KURL> urls;
+    Vector<ResourcePtr<RawResource> > resources;
+    for (size_t i = 0; i <= maxLoadsPerHost; ++i) {
+        urls.append(KURL(ParsedURLString, "http://www.test.com/" + String::number(i) + ".html"));
+        URLTestHelpers::registerMockedURLLoad(urls[i], "cancelTest.html", "text/html");
+
+        FetchRequest request = FetchRequest(ResourceRequest(urls[i]), FetchInitiatorInfo());
+        request.mutableResourceRequest().setRequestContext(WebURLRequest::RequestContextInternal);
+        resources.append(fetcher->fetchRawResource(request));
+        ASSERT_TRUE(resources[i].get());
+    }
+    ResourcePtr<RawResource> queued = resources.last();
+    EXPECT_TRUE(queued->isLoading());
+    EXPECT_FALSE(queued->loader());
+
+    // A synchronous request for the queued URL reuses the resource and
+    // loads it right away.
+    FetchRequest syncRequest = FetchRequest(ResourceRequest(urls.last()), FetchInitiatorInfo());
+    ResourcePtr<Resource> syncResource = fetcher->fetchSynchronously(syncRequest);
+    EXPECT_EQ(queued.get(), syncResource.get());
+    EXPECT_FALSE(queued->isLoading());
+    EXPECT_FALSE(queued->errorOccurred());
+    EXPECT_EQ(initialRequestCount + static_cast<int>(maxLoadsPerHost), fetcher->requestCount());
+
+    // The scheduler does not start it a second time when the other loads finish.
+    Platform::current()->unitTestSupport()->serveAsynchronousMockedRequests();
+    blink::testing::runPendingTasks();
+    EXPECT_FALSE(queued->isLoading());
+    EXPECT_FALSE(queued->loader());
+    EXPECT_EQ(initialRequestCount, fetcher->requestCount());
+
+    for (size_t i = 0; i < urls.size(); ++i)
+        Platform::current()->unitTestSupport()->unregisterMockedURL(urls[i]);
+    RuntimeEnabledFeatures::setResourceLoadSchedulerEnabled(schedulerWasEnabled);
+}
+
 } // namespace
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2014 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "core/fetch/ResourceLoadScheduler.h"
+
+#include "core/fetch/FetchContext.h"
+#include "platform/Logging.h"
+#include "platform/TraceEvent.h"
+#include "platform/network/ResourceError.h"
+#include "wtf/text/CString.h"
+
+namespace blink {
+
+ResourceLoadScheduler::ResourceLoadScheduler(Client* client, const FetchContext& context)
+    : m_client(client)
+    , m_maxLoadsPerHost(context.maxConcurrentLoadsPerHost())
+    , m_maxLowPriorityLoadsWhileRenderBlocked(context.maxLowPriorityLoadsWhileRenderBlocked())
+    , m_pendingCount(0)
+    , m_outstandingRenderBlockingLoads(0)
+    , m_inFlightLowPriorityLoads(0)
+{
+    ASSERT(m_client);
+    ASSERT(m_maxLoadsPerHost);
+}
+
+ResourceLoadScheduler::~ResourceLoadScheduler()
+{
+}
+
+bool ResourceLoadScheduler::isRenderBlocking(const Resource* resource)
+{
+    switch (resource->type()) {
+    case Resource::CSSStyleSheet:
+        return true;
+    case Resource::Script:
+        // Async and deferred scripts are fetched at low priority (see
+        // loadPriority() in ResourceFetcher.cpp) and do not block the parser.
+        return !isLowPriority(resource->resourceRequest().priority());
+    default:
+        return false;
+    }
+}
+
+ResourceLoadPriority ResourceLoadScheduler::queueIndex(const Resource* resource)
+{
+    ResourceLoadPriority priority = resource->resourceRequest().priority();
+    if (priority == ResourceLoadPriorityUnresolved)
+        return ResourceLoadPriorityLowest;
+    return priority;
+}
+
+void ResourceLoadScheduler::schedule(Resource* resource, const ResourceLoaderOptions& options)
+{
+    ASSERT(!isPending(resource));
+    ASSERT(!m_inFlightLoads.contains(resource));
+
+    PendingLoad load(resource, options, isRenderBlocking(resource));
+    if (load.isRenderBlocking)
+        ++m_outstandingRenderBlockingLoads;
+
+    if (!isQueuedBehindPendingLoad(load) && canStartLoad(load)) {
+        startLoad(load);
+        return;
+    }
+
+    WTF_LOG(ResourceLoading, "ResourceLoadScheduler::schedule queued '%s', priority=%d", resource->url().elidedString().latin1().data(), queueIndex(resource));
+    TRACE_EVENT_ASYNC_STEP_INTO0("net", "Resource", resource, "Queued");
+
+    // Queued resources count as loading so that clients do not treat them
+    // as finished, and so that the load event is held back.
+    resource->setLoading(true);
+    resource->setStatus(Resource::Pending);
+    m_pendingLoads[queueIndex(resource)].append(load);
+    ++m_pendingCount;
+}
+
+bool ResourceLoadScheduler::isHeldBackByHostLimit(const String& host) const
+{
+    return !host.isEmpty() && m_inFlightLoadsPerHost.count(host) >= m_maxLoadsPerHost;
+}
+
+bool ResourceLoadScheduler::isQueuedBehindPendingLoad(const PendingLoad& load) const
+{
+    // A new load must not overtake a queued load of the same or higher
+    // priority that competes for the same slot: one to the same host, or one
+    // that is only waiting for a slot shared by all hosts. Loads held back by
+    // the limit of another host do not hold this one back.
+    ResourceLoadPriority loadPriority = queueIndex(load.resource.get());
+    const String host = load.resource->url().host();
+    for (int priority = ResourceLoadPriorityLowest; priority <= ResourceLoadPriorityHighest; ++priority) {
+        const Deque<PendingLoad>& queue = m_pendingLoads[priority];
+        for (Deque<PendingLoad>::const_iterator it = queue.begin(); it != queue.end(); ++it) {
+            if (queueIndex(it->resource.get()) < loadPriority)
+                continue;
+            const String pendingHost = it->resource->url().host();
+            if (!host.isEmpty() && pendingHost == host)
+                return true;
+            if (!isHeldBackByHostLimit(pendingHost))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool ResourceLoadScheduler::canStartLoad(const PendingLoad& load) const
+{
+    if (isHeldBackByHostLimit(load.resource->url().host()))
+        return false;
+
+    if (isLowPriority(queueIndex(load.resource.get())) && m_outstandingRenderBlockingLoads
+        && m_inFlightLowPriorityLoads >= m_maxLowPriorityLoadsWhileRenderBlocked)
+        return false;
+
+    return true;
+}
+
+void ResourceLoadScheduler::startLoad(const PendingLoad& load)
+{
+    Resource* resource = load.resource.get();
+    InFlightLoad inFlightLoad(resource->url().host(), load.isRenderBlocking, isLowPriority(queueIndex(resource)));
+
+    // Register the load before handing it to the client: starting a load can
+    // fail synchronously, and that has to be accounted for in loadFinished().
+    m_inFlightLoads.set(resource, inFlightLoad);
+    if (!inFlightLoad.host.isEmpty())
+        m_inFlightLoadsPerHost.add(inFlightLoad.host);
+    if (inFlightLoad.isLowPriority)
+        ++m_inFlightLowPriorityLoads;
+
+    ResourcePtr<Resource> protect(resource);
+    if (!m_client->startScheduledLoad(resource, load.options))
+        loadFinished(resource);
+}
+
+void ResourceLoadScheduler::loadFinished(Resource* resource)
+{
+    HashMap<Resource*, InFlightLoad>::iterator it = m_inFlightLoads.find(resource);
+    if (it == m_inFlightLoads.end())
+        return;
+
+    if (!it->value.host.isEmpty())
+        m_inFlightLoadsPerHost.remove(it->value.host);
+    if (it->value.isLowPriority) {
+        ASSERT(m_inFlightLowPriorityLoads);
+        --m_inFlightLowPriorityLoads;
+    }
+    if (it->value.isRenderBlocking) {
+        ASSERT(m_outstandingRenderBlockingLoads);
+        --m_outstandingRenderBlockingLoads;
+    }
+    m_inFlightLoads.remove(it);
+
+    if (m_pendingCount)
+        m_client->scheduleDispatchOfPendingLoads();
+}
+
+void ResourceLoadScheduler::reprioritizePendingLoads()
+{
+    for (int priority = ResourceLoadPriorityLowest; priority <= ResourceLoadPriorityHighest; ++priority) {
+        Deque<PendingLoad>& queue = m_pendingLoads[priority];
+        if (queue.isEmpty())
+            continue;
+
+        Deque<PendingLoad> unchanged;
+        while (!queue.isEmpty()) {
+            PendingLoad load = queue.takeFirst();
+            ResourceLoadPriority current = queueIndex(load.resource.get());
+            if (current == priority)
+                unchanged.append(load);
+            else
+                m_pendingLoads[current].append(load);
+        }
+        queue.swap(unchanged);
+    }
+}
+
+void ResourceLoadScheduler::dispatchPendingLoads()
+{
+    if (!m_pendingCount)
+        return;
+
+    TRACE_EVENT1("blink", "ResourceLoadScheduler::dispatchPendingLoads", "pending", m_pendingCount);
+
+    reprioritizePendingLoads();
+
+    for (int priority = ResourceLoadPriorityHighest; priority >= ResourceLoadPriorityLowest; --priority) {
+        Deque<PendingLoad>& queue = m_pendingLoads[priority];
+        // Loads blocked by their host limit keep their place in the queue,
+        // but do not hold back loads to other hosts.
+        Deque<PendingLoad> blocked;
+        while (!queue.isEmpty()) {
+            PendingLoad load = queue.takeFirst();
+            if (!canStartLoad(load)) {
+                blocked.append(load);
+                continue;
+            }
+            --m_pendingCount;
+            startLoad(load);
+        }
+        queue.swap(blocked);
+    }
+}
+
+void ResourceLoadScheduler::cancelPendingLoads()
+{
+    Vector<PendingLoad> cancelled;
+    for (int priority = ResourceLoadPriorityLowest; priority <= ResourceLoadPriorityHighest; ++priority) {
+        while (!m_pendingLoads[priority].isEmpty())
+            cancelled.append(m_pendingLoads[priority].takeFirst());
+    }
+    m_pendingCount = 0;
+
+    for (size_t i = 0; i < cancelled.size(); ++i) {
+        Resource* resource = cancelled[i].resource.get();
+        if (cancelled[i].isRenderBlocking) {
+            ASSERT(m_outstandingRenderBlockingLoads);
+            --m_outstandingRenderBlockingLoads;
+        }
+        resource->setResourceError(ResourceError::cancelledError(resource->url()));
+        resource->error(Resource::LoadError);
+    }
+}
+
+bool ResourceLoadScheduler::removePendingLoad(Resource* resource)
+{
+    for (int priority = ResourceLoadPriorityLowest; priority <= ResourceLoadPriorityHighest; ++priority) {
+        Deque<PendingLoad>& queue = m_pendingLoads[priority];
+        for (Deque<PendingLoad>::iterator it = queue.begin(); it != queue.end(); ++it) {
+            if (it->resource.get() != resource)
+                continue;
+            if (it->isRenderBlocking) {
+                ASSERT(m_outstandingRenderBlockingLoads);
+                --m_outstandingRenderBlockingLoads;
+            }
+            queue.remove(it);
+            ASSERT(m_pendingCount);
+            --m_pendingCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ResourceLoadScheduler::isPending(Resource* resource) const
+{
+    for (int priority = ResourceLoadPriorityLowest; priority <= ResourceLoadPriorityHighest; ++priority) {
+        const Deque<PendingLoad>& queue = m_pendingLoads[priority];
+        for (Deque<PendingLoad>::const_iterator it = queue.begin(); it != queue.end(); ++it) {
+            if (it->resource.get() == resource)
+                return true;
+        }
+    }
+    return false;
+}
+
+} // namespace blink
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2014 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ResourceLoadScheduler_h
+#define ResourceLoadScheduler_h
+
+#include "core/fetch/Resource.h"
+#include "core/fetch/ResourceLoaderOptions.h"
+#include "core/fetch/ResourcePtr.h"
+#include "platform/network/ResourceLoadPriority.h"
+#include "wtf/Deque.h"
+#include "wtf/FastAllocBase.h"
+#include "wtf/HashCountedSet.h"
+#include "wtf/HashMap.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/PassOwnPtr.h"
+#include "wtf/text/StringHash.h"
+
+namespace blink {
+
+class FetchContext;
+
+// The ResourceLoadScheduler decides when the subresource loads of a single
+// ResourceFetcher hit the network. Loads are queued by ResourceLoadPriority
+// and started highest priority first, subject to two limits:
+//  - at most maxConcurrentLoadsPerHost() loads are in flight per host, and
+//  - while render-blocking loads (style sheets and parser-blocking scripts)
+//    are outstanding, low priority loads are throttled to
+//    maxLowPriorityLoadsWhileRenderBlocked().
+// The priority of a queued load is re-read from its ResourceRequest every
+// time the queues are pumped, so images promoted by the
+// ResourceLoadPriorityOptimizer when they scroll into view jump ahead
+// without any extra bookkeeping. Loads that are already in flight are
+// re-prioritized through ResourceLoader::didChangePriority() as before.
+class ResourceLoadScheduler {
+    WTF_MAKE_NONCOPYABLE(ResourceLoadScheduler); WTF_MAKE_FAST_ALLOCATED;
+public:
+    class Client {
+    public:
+        virtual ~Client() { }
+        // Returns false if the resource has no load in flight afterwards,
+        // e.g. because it failed before starting.
+        virtual bool startScheduledLoad(Resource*, const ResourceLoaderOptions&) = 0;
+        // Asks the client to call dispatchPendingLoads() soon, outside of
+        // the loader callback that finished a load.
+        virtual void scheduleDispatchOfPendingLoads() = 0;
+    };
+
+    static PassOwnPtr<ResourceLoadScheduler> create(Client* client, const FetchContext& context)
+    {
+        return adoptPtr(new ResourceLoadScheduler(client, context));
+    }
+    ~ResourceLoadScheduler();
+
+    // Starts the load right away if the policy allows it, queues it otherwise.
+    void schedule(Resource*, const ResourceLoaderOptions&);
+
+    // Must be called when a load started by the scheduler terminates, for
+    // whatever reason. If loads are queued, the client is asked to dispatch
+    // them through Client::scheduleDispatchOfPendingLoads().
+    void loadFinished(Resource*);
+
+    // Starts as many queued loads as the policy allows.
+    void dispatchPendingLoads();
+
+    // Fails all loads that have not been started yet.
+    void cancelPendingLoads();
+
+    // Takes a queued load out of the queue without starting it, for a caller
+    // that is about to start the load itself. The resource stays marked as
+    // loading. Returns false if the load was not queued.
+    bool removePendingLoad(Resource*);
+
+    bool isPending(Resource*) const;
+    bool hasPendingLoads() const { return m_pendingCount; }
+    size_t pendingCount() const { return m_pendingCount; }
+    size_t inFlightCount() const { return m_inFlightLoads.size(); }
+
+private:
+    ResourceLoadScheduler(Client*, const FetchContext&);
+
+    struct PendingLoad {
+        PendingLoad() : isRenderBlocking(false) { }
+        PendingLoad(Resource* resource, const ResourceLoaderOptions& options, bool isRenderBlocking)
+            : resource(resource)
+            , options(options)
+            , isRenderBlocking(isRenderBlocking)
+        {
+        }
+        ResourcePtr<Resource> resource;
+        ResourceLoaderOptions options;
+        bool isRenderBlocking;
+    };
+
+    struct InFlightLoad {
+        InFlightLoad() : isRenderBlocking(false), isLowPriority(false) { }
+        InFlightLoad(const String& host, bool isRenderBlocking, bool isLowPriority)
+            : host(host)
+            , isRenderBlocking(isRenderBlocking)
+            , isLowPriority(isLowPriority)
+        {
+        }
+        String host;
+        bool isRenderBlocking;
+        bool isLowPriority;
+    };
+
+    static bool isRenderBlocking(const Resource*);
+    static bool isLowPriority(ResourceLoadPriority priority) { return priority <= ResourceLoadPriorityLow; }
+    static ResourceLoadPriority queueIndex(const Resource*);
+
+    bool canStartLoad(const PendingLoad&) const;
+    bool isHeldBackByHostLimit(const String& host) const;
+    bool isQueuedBehindPendingLoad(const PendingLoad&) const;
+    void startLoad(const PendingLoad&);
+    void reprioritizePendingLoads();
+
+    Client* m_client;
+    size_t m_maxLoadsPerHost;
+    size_t m_maxLowPriorityLoadsWhileRenderBlocked;
+
+    Deque<PendingLoad> m_pendingLoads[ResourceLoadPriorityHighest + 1];
+    size_t m_pendingCount;
+
+    HashMap<Resource*, InFlightLoad> m_inFlightLoads;
+    HashCountedSet<String> m_inFlightLoadsPerHost;
+
+    // Render-blocking loads that are either queued or in flight.
+    unsigned m_outstandingRenderBlockingLoads;
+    unsigned m_inFlightLowPriorityLoads;
+};
+
+} // namespace blink
+
+#endif // ResourceLoadScheduler_h
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2014 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "core/fetch/ResourceLoadScheduler.h"
+
+#include "core/fetch/FetchContext.h"
+#include "core/fetch/ResourceFetcher.h"
+#include "core/fetch/ResourcePtr.h"
+#include "platform/network/ResourceRequest.h"
+#include "platform/weborigin/KURL.h"
+#include "wtf/Vector.h"
+#include "wtf/text/WTFString.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+class MockFetchContext : public FetchContext {
+public:
+    MockFetchContext(size_t maxLoadsPerHost, size_t maxLowPriorityLoads)
+        : m_maxLoadsPerHost(maxLoadsPerHost)
+        , m_maxLowPriorityLoads(maxLowPriorityLoads)
+    {
+    }
+
+    virtual size_t maxConcurrentLoadsPerHost() const OVERRIDE { return m_maxLoadsPerHost; }
+    virtual size_t maxLowPriorityLoadsWhileRenderBlocked() const OVERRIDE { return m_maxLowPriorityLoads; }
+
+private:
+    size_t m_maxLoadsPerHost;
+    size_t m_maxLowPriorityLoads;
+};
+
+// Records the order in which the scheduler hands out loads, without
+// touching the network.
+class DispatchTimeline : public ResourceLoadScheduler::Client {
+public:
+    DispatchTimeline() : m_dispatchRequested(false) { }
+
+    virtual bool startScheduledLoad(Resource* resource, const ResourceLoaderOptions&) OVERRIDE
+    {
+        m_dispatched.append(resource->url().string());
+        return true;
+    }
+
+    // ResourceFetcher starts a timer here.
+    virtual void scheduleDispatchOfPendingLoads() OVERRIDE { m_dispatchRequested = true; }
+
+    bool takeDispatchRequest()
+    {
+        bool requested = m_dispatchRequested;
+        m_dispatchRequested = false;
+        return requested;
+    }
+
+    const Vector<String>& dispatched() const { return m_dispatched; }
+    String at(size_t index) const { return m_dispatched[index]; }
+    size_t size() const { return m_dispatched.size(); }
+
+private:
+    Vector<String> m_dispatched;
+    bool m_dispatchRequested;
+};
+
+class ResourceLoadSchedulerTest : public ::testing::Test {
+protected:
+    ResourcePtr<Resource> createResource(const char* url, Resource::Type type, ResourceLoadPriority priority)
+    {
+        ResourceRequest request(KURL(ParsedURLString, url));
+        request.setPriority(priority);
+        ResourcePtr<Resource> resource = new Resource(request, type);
+        m_resources.append(resource);
+        return resource;
+    }
+
+    void schedule(ResourceLoadScheduler* scheduler, Resource* resource)
+    {
+        scheduler->schedule(resource, ResourceFetcher::defaultResourceOptions());
+    }
+
+    // What happens when the loader of |resource| terminates: the scheduler
+    // is told, and the dispatch it asks for runs as the fetcher's timer would.
+    void finishLoad(ResourceLoadScheduler* scheduler, Resource* resource)
+    {
+        scheduler->loadFinished(resource);
+        if (m_timeline.takeDispatchRequest())
+            scheduler->dispatchPendingLoads();
+    }
+
+    DispatchTimeline m_timeline;
+    Vector<ResourcePtr<Resource> > m_resources;
+};
+
+TEST_F(ResourceLoadSchedulerTest, StartsImmediatelyWhenUnconstrained)
+{
+    MockFetchContext context(6, 1);
+    OwnPtr<ResourceLoadScheduler> scheduler = ResourceLoadScheduler::create(&m_timeline, context);
+
+    schedule(scheduler.get(), createResource("http://a.com/1.png", Resource::Image, ResourceLoadPriorityVeryLow).get());
+    schedule(scheduler.get(), createResource("http://b.com/2.png", Resource::Image, ResourceLoadPriorityVeryLow).get());
+
+    ASSERT_EQ(2u, m_timeline.size());
+    EXPECT_EQ(0u, scheduler->pendingCount());
+    EXPECT_EQ(2u, scheduler->inFlightCount());
+}
+
+TEST_F(ResourceLoadSchedulerTest, ThrottlesLowPriorityWhileRenderBlocked)
+{
+    MockFetchContext context(6, 1);
+    OwnPtr<ResourceLoadScheduler> scheduler = ResourceLoadScheduler::create(&m_timeline, context);
+
+    ResourcePtr<Resource> css = createResource("http://a.com/style.css", Resource::CSSStyleSheet, ResourceLoadPriorityHigh);
+    schedule(scheduler.get(), css.get());
+    ResourcePtr<Resource> image1 = createResource("http://b.com/1.png", Resource::Image, ResourceLoadPriorityVeryLow);
+    schedule(scheduler.get(), image1.get());
+    schedule(scheduler.get(), createResource("http://b.com/2.png", Resource::Image, ResourceLoadPriorityVeryLow).get());
+    schedule(scheduler.get(), createResource("http://b.com/3.png", Resource::Image, ResourceLoadPriorityVeryLow).get());
+
+    // Only one image may load alongside the style sheet.
+    ASSERT_EQ(2u, m_timeline.size());
+    EXPECT_EQ("http://a.com/style.css", m_timeline.at(0));
+    EXPECT_EQ("http://b.com/1.png", m_timeline.at(1));
+    EXPECT_EQ(2u, scheduler->pendingCount());
+
+    // Finishing the image frees its slot for the next one only.
+    finishLoad(scheduler.get(), image1.get());
+    ASSERT_EQ(3u, m_timeline.size());
+    EXPECT_EQ("http://b.com/2.png", m_timeline.at(2));
+
+    // Once the style sheet is done, nothing is throttled any more.
+    finishLoad(scheduler.get(), css.get());
+    ASSERT_EQ(4u, m_timeline.size());
+    EXPECT_EQ("http://b.com/3.png", m_timeline.at(3));
+    EXPECT_FALSE(scheduler->hasPendingLoads());
+}
+
+TEST_F(ResourceLoadSchedulerTest, AsyncScriptsAreNotRenderBlocking)
+{
+    MockFetchContext context(6, 0);
+    OwnPtr<ResourceLoadScheduler> scheduler = ResourceLoadScheduler::create(&m_timeline, context);
+
+    schedule(scheduler.get(), createResource("http://a.com/async.js", Resource::Script, ResourceLoadPriorityLow).get());
+    schedule(scheduler.get(), createResource("http://b.com/1.png", Resource::Image, ResourceLoadPriorityVeryLow).get());
+    EXPECT_EQ(2u, m_timeline.size());
+
+    schedule(scheduler.get(), createResource("http://a.com/blocking.js", Resource::Script, ResourceLoadPriorityMedium).get());
+    schedule(scheduler.get(), createResource("http://b.com/2.png", Resource::Image, ResourceLoadPriorityVeryLow).get());
+    ASSERT_EQ(3u, m_timeline.size());
+    EXPECT_EQ("http://a.com/blocking.js", m_timeline.at(2));
+    EXPECT_EQ(1u, scheduler->pendingCount());
+}
+
+TEST_F(ResourceLoadSchedulerTest, CapsConcurrentLoadsPerHost)
+{
+    MockFetchContext context(2, 1);
+    OwnPtr<ResourceLoadScheduler> scheduler = ResourceLoadScheduler::create(&m_timeline, context);
+
+    ResourcePtr<Resource> first = createResource("http://a.com/1.js", Resource::Script, ResourceLoadPriorityLow);
+    schedule(scheduler.get(), first.get());
+    schedule(scheduler.get(), createResource("http://a.com/2.js", Resource::Script, ResourceLoadPriorityLow).get());
+    schedule(scheduler.get(), createResource("http://a.com/3.js", Resource::Script, ResourceLoadPriorityLow).get());
+    // A different host is not held back by a.com being saturated.
+    schedule(scheduler.get(), createResource("http://b.com/4.js", Resource::Script, ResourceLoadPriorityLow).get());
+
+    ASSERT_EQ(3u, m_timeline.size());
+    EXPECT_EQ("http://b.com/4.js", m_timeline.at(2));
+    EXPECT_FALSE(m_timeline.takeDispatchRequest());
+
+    finishLoad(scheduler.get(), first.get());
+    ASSERT_EQ(4u, m_timeline.size());
+    EXPECT_EQ("http://a.com/3.js", m_timeline.at(3));
+}
+
+TEST_F(ResourceLoadSchedulerTest, DispatchesByPriority)
+{
+    MockFetchContext context(1, 1);
+    OwnPtr<ResourceLoadScheduler> scheduler = ResourceLoadScheduler::create(&m_timeline, context);
+
+    ResourcePtr<Resource> blocker = createResource("http://a.com/blocker", Resource::Raw, ResourceLoadPriorityMedium);
+    ResourcePtr<Resource> low = createResource("http://a.com/low", Resource::Raw, ResourceLoadPriorityLow);
+    ResourcePtr<Resource> high = createResource("http://a.com/high", Resource::Raw, ResourceLoadPriorityHigh);
+    ResourcePtr<Resource> medium = createResource("http://a.com/medium", Resource::Raw, ResourceLoadPriorityMedium);
+    schedule(scheduler.get(), blocker.get());
+    schedule(scheduler.get(), low.get());
+    schedule(scheduler.get(), high.get());
+    schedule(scheduler.get(), medium.get());
+    EXPECT_EQ(3u, scheduler->pendingCount());
+
+    finishLoad(scheduler.get(), blocker.get());
+    finishLoad(scheduler.get(), high.get());
+    finishLoad(scheduler.get(), medium.get());
+    ASSERT_EQ(4u, m_timeline.size());
+    EXPECT_EQ("http://a.com/blocker", m_timeline.at(0));
+    EXPECT_EQ("http://a.com/high", m_timeline.at(1));
+    EXPECT_EQ("http://a.com/medium", m_timeline.at(2));
+    EXPECT_EQ("http://a.com/low", m_timeline.at(3));
+}
+
+TEST_F(ResourceLoadSchedulerTest, ReprioritizesQueuedLoads)
+{
+    MockFetchContext context(1, 1);
+    OwnPtr<ResourceLoadScheduler> scheduler = ResourceLoadScheduler::create(&m_timeline, context);
+
+    ResourcePtr<Resource> blocker = createResource("http://a.com/blocker.png", Resource::Image, ResourceLoadPriorityVeryLow);
+    schedule(scheduler.get(), blocker.get());
+    schedule(scheduler.get(), createResource("http://a.com/offscreen.png", Resource::Image, ResourceLoadPriorityVeryLow).get());
+    ResourcePtr<Resource> visible = createResource("http://a.com/visible.png", Resource::Image, ResourceLoadPriorityVeryLow);
+    schedule(scheduler.get(), visible.get());
+
+    // This is what the ResourceLoadPriorityOptimizer does when an image
+    // scrolls into view.
+    visible->mutableResourceRequest().setPriority(ResourceLoadPriorityLow);
+    visible->didChangePriority(ResourceLoadPriorityLow, 0);
+
+    finishLoad(scheduler.get(), blocker.get());
+    ASSERT_EQ(2u, m_timeline.size());
+    EXPECT_EQ("http://a.com/visible.png", m_timeline.at(1));
+}
+
+TEST_F(ResourceLoadSchedulerTest, HigherPriorityLoadToSaturatedHostDoesNotBlockOtherHosts)
+{
+    MockFetchContext context(1, 1);
+    OwnPtr<ResourceLoadScheduler> scheduler = ResourceLoadScheduler::create(&m_timeline, context);
+
+    schedule(scheduler.get(), createResource("http://a.com/1.js", Resource::Script, ResourceLoadPriorityMedium).get());
+    schedule(scheduler.get(), createResource("http://a.com/2.js", Resource::Script, ResourceLoadPriorityMedium).get());
+    ASSERT_EQ(1u, m_timeline.size());
+
+    // a.com/2.js waits for its own host only; an idle host goes straight out.
+    schedule(scheduler.get(), createResource("http://b.com/1.js", Resource::Script, ResourceLoadPriorityLow).get());
+    ASSERT_EQ(2u, m_timeline.size());
+    EXPECT_EQ("http://b.com/1.js", m_timeline.at(1));
+
+    // A load to the saturated host still queues behind the one waiting there.
+    schedule(scheduler.get(), createResource("http://a.com/3.js", Resource::Script, ResourceLoadPriorityLow).get());
+    EXPECT_EQ(2u, m_timeline.size());
+    EXPECT_EQ(2u, scheduler->pendingCount());
+}
+
+TEST_F(ResourceLoadSchedulerTest, RemovedPendingLoadIsNotStartedAgain)
+{
+    MockFetchContext context(1, 1);
+    OwnPtr<ResourceLoadScheduler> scheduler = ResourceLoadScheduler::create(&m_timeline, context);
+
+    ResourcePtr<Resource> first = createResource("http://a.com/1.css", Resource::CSSStyleSheet, ResourceLoadPriorityHigh);
+    schedule(scheduler.get(), first.get());
+    ResourcePtr<Resource> queued = createResource("http://a.com/2.css", Resource::CSSStyleSheet, ResourceLoadPriorityHigh);
+    schedule(scheduler.get(), queued.get());
+    ASSERT_EQ(1u, scheduler->pendingCount());
+
+    // This is what ResourceFetcher does when a synchronous request reuses
+    // the queued resource and starts it itself.
+    EXPECT_TRUE(scheduler->removePendingLoad(queued.get()));
+    EXPECT_FALSE(scheduler->removePendingLoad(queued.get()));
+    EXPECT_EQ(0u, scheduler->pendingCount());
+    EXPECT_TRUE(queued->isLoading());
+
+    schedule(scheduler.get(), createResource("http://b.com/1.png", Resource::Image, ResourceLoadPriorityVeryLow).get());
+    schedule(scheduler.get(), createResource("http://c.com/2.png", Resource::Image, ResourceLoadPriorityVeryLow).get());
+    EXPECT_EQ(2u, m_timeline.size());
+
+    // The removed load no longer counts as render blocking, so low priority
+    // loads are released once the first style sheet is done.
+    finishLoad(scheduler.get(), first.get());
+    EXPECT_EQ(3u, m_timeline.size());
+    EXPECT_EQ(0u, scheduler->pendingCount());
+    for (size_t i = 0; i < m_timeline.size(); ++i)
+        EXPECT_NE("http://a.com/2.css", m_timeline.at(i));
+}
+
+} // namespace
@@ -55,6 +55,7 @@
 #include "core/page/FrameTree.h"
 #include "core/page/Page.h"
 #include "core/page/scrolling/ScrollingCoordinator.h"
+#include "core/rendering/RenderBlockFlow.h"
 #include "core/rendering/RenderCounter.h"
 #include "core/rendering/RenderEmbeddedObject.h"
 #include "core/rendering/RenderLayer.h"
@@ -79,6 +80,7 @@
 #include "platform/fonts/FontCache.h"
 #include "platform/geometry/FloatRect.h"
 #include "platform/graphics/GraphicsContext.h"
+#include "platform/graphics/GraphicsLayer.h"
 #include "platform/graphics/GraphicsLayerDebugInfo.h"
 #include "platform/scroll/ScrollAnimator.h"
 #include "platform/scroll/ScrollbarTheme.h"
@@ -181,6 +183,7 @@ void FrameView::reset()
 {
     m_hasPendingLayout = false;
     m_layoutSubtreeRoot = 0;
+    m_isolatedLayoutSubtreeRoots.clear();
     m_doFullPaintInvalidation = false;
     m_layoutSchedulingEnabled = true;
     m_inPerformLayout = false;
@@ -207,6 +210,8 @@ void FrameView::reset()
     m_firstVisuallyNonEmptyLayoutCallbackPending = true;
     m_maintainScrollPositionAnchor = nullptr;
     m_viewportConstrainedObjects.clear();
+    m_blocksWithDeferredLayoutChildren.clear();
+    m_pendingScrollAnchorAdjustment = IntSize();
 }
 
 void FrameView::removeFromAXObjectCache()
@@ -655,6 +660,25 @@ RenderObject* FrameView::layoutRoot(bool onlyDuringLayout) const
     return onlyDuringLayout && layoutPending() ? 0 : m_layoutSubtreeRoot;
 }
 
+bool FrameView::isLayoutSubtreeRoot(const RenderObject& object) const
+{
+    return m_layoutSubtreeRoot == &object || m_isolatedLayoutSubtreeRoots.contains(&object);
+}
+
+void FrameView::clearLayoutSubtreeRoot(const RenderObject& object)
+{
+    size_t index = m_isolatedLayoutSubtreeRoots.find(&object);
+    if (index != kNotFound)
+        m_isolatedLayoutSubtreeRoots.remove(index);
+    if (m_layoutSubtreeRoot == &object) {
+        m_layoutSubtreeRoot = 0;
+        if (!m_isolatedLayoutSubtreeRoots.isEmpty()) {
+            m_layoutSubtreeRoot = m_isolatedLayoutSubtreeRoots.last();
+            m_isolatedLayoutSubtreeRoots.removeLast();
+        }
+    }
+}
+
 inline void FrameView::forceLayoutParentViewIfNeeded()
 {
     RenderPart* ownerRenderer = m_frame->ownerRenderer();
@@ -721,6 +745,19 @@ void FrameView::performPreLayoutTasks()
     lifecycle().advanceTo(DocumentLifecycle::StyleClean);
 }
 
+// The ResourceLoadPriorityOptimizer re-prioritizes the images of every frame,
+// so queued loads of any frame in the tree may have been promoted. Frames of
+// other pages are pumped by their own layouts and scrolls.
+static void scheduleDispatchOfPendingLoadsInFrameTree(LocalFrame& localFrame)
+{
+    for (Frame* frame = localFrame.tree().top(); frame; frame = frame->tree().traverseNext()) {
+        if (!frame->isLocalFrame())
+            continue;
+        if (Document* document = toLocalFrame(frame)->document())
+            document->fetcher()->scheduleDispatchOfPendingLoads();
+    }
+}
+
 void FrameView::performLayout(RenderObject* rootForThisLayout, bool inSubtreeLayout)
 {
     TRACE_EVENT0("blink", "FrameView::performLayout");
@@ -744,7 +781,11 @@ void FrameView::performLayout(RenderObject* rootForThisLayout, bool inSubtreeLay
     rootForThisLayout->layout();
     gatherDebugLayoutRects(rootForThisLayout);
 
+    ASSERT(inSubtreeLayout || m_isolatedLayoutSubtreeRoots.isEmpty());
+    layoutIsolatedSubtreeRoots();
+
     ResourceLoadPriorityOptimizer::resourceLoadPriorityOptimizer()->updateAllImageResourcePriorities();
+    scheduleDispatchOfPendingLoadsInFrameTree(*m_frame);
 
     lifecycle().advanceTo(DocumentLifecycle::AfterPerformLayout);
 }
@@ -809,6 +850,7 @@ void FrameView::layout(bool allowSubtree)
     if (!allowSubtree && isSubtreeLayout()) {
         m_layoutSubtreeRoot->markContainingBlocksForLayout(false);
         m_layoutSubtreeRoot = 0;
+        clearIsolatedLayoutSubtreeRoots(true);
     }
 
     performPreLayoutTasks();
@@ -829,6 +871,7 @@ void FrameView::layout(bool allowSubtree)
 
     FontCachePurgePreventer fontCachePurgePreventer;
     RenderLayer* layer;
+    Vector<RenderObject*> isolatedRoots;
     {
         TemporaryChange<bool> changeSchedulingEnabled(m_layoutSchedulingEnabled, false);
 
@@ -901,22 +944,34 @@ void FrameView::layout(bool allowSubtree)
         performLayout(rootForThisLayout, inSubtreeLayout);
 
         m_layoutSubtreeRoot = 0;
+        isolatedRoots.swap(m_isolatedLayoutSubtreeRoots);
         // We need to ensure that we mark up all renderers up to the RenderView
         // for paint invalidation. This simplifies our code as we just always
         // do a full tree walk.
         if (RenderObject* container = rootForThisLayout->container())
             container->setMayNeedPaintInvalidation(true);
+        for (size_t i = 0; i < isolatedRoots.size(); ++i) {
+            if (RenderObject* container = isolatedRoots[i]->container())
+                container->setMayNeedPaintInvalidation(true);
+        }
     } // Reset m_layoutSchedulingEnabled to its previous value.
 
     if (!inSubtreeLayout && !toRenderView(rootForThisLayout)->document().printing())
         adjustViewSize();
 
     layer->updateLayerPositionsAfterLayout();
+    for (size_t i = 0; i < isolatedRoots.size(); ++i)
+        isolatedRoots[i]->enclosingLayer()->updateLayerPositionsAfterLayout();
 
     renderView()->compositor()->didLayout();
 
     m_layoutCount++;
 
+    bool isTracingLayout;
+    TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("blink.debug.layout"), &isTracingLayout);
+    if (isTracingLayout)
+        TRACE_COUNTER_ID1(TRACE_DISABLED_BY_DEFAULT("blink.debug.layout"), "LineBoxBytes", this, renderView()->lineBoxBytes());
+
     if (AXObjectCache* cache = rootForThisLayout->document().axObjectCache()) {
         const KURL& url = rootForThisLayout->document().url();
         if (url.isValid() && !url.isAboutBlankURL())
@@ -1166,6 +1221,33 @@ void FrameView::removeViewportConstrainedObject(RenderObject* object)
     }
 }
 
+void FrameView::addBlockWithDeferredLayoutChildren(RenderBlockFlow* block)
+{
+    if (!m_blocksWithDeferredLayoutChildren)
+        m_blocksWithDeferredLayoutChildren = adoptPtr(new DeferredLayoutBlockSet);
+    m_blocksWithDeferredLayoutChildren->add(block);
+}
+
+void FrameView::removeBlockWithDeferredLayoutChildren(RenderBlockFlow* block)
+{
+    if (m_blocksWithDeferredLayoutChildren)
+        m_blocksWithDeferredLayoutChildren->remove(block);
+}
+
+void FrameView::markDeferredLayoutChildrenNearViewport()
+{
+    // Layout places deferred children against the scroll position it sees, so
+    // scrolling done by layout itself needs nothing here.
+    if (!m_blocksWithDeferredLayoutChildren || m_blocksWithDeferredLayoutChildren->isEmpty() || m_nestedLayoutCount)
+        return;
+
+    IntRect visibleRect = visibleContentRect();
+    Vector<RenderBlockFlow*> blocks;
+    copyToVector(*m_blocksWithDeferredLayoutChildren, blocks);
+    for (size_t i = 0; i < blocks.size(); ++i)
+        blocks[i]->markDeferredChildrenNearViewportForLayout(visibleRect);
+}
+
 LayoutRect FrameView::viewportConstrainedVisibleContentRect() const
 {
     LayoutRect viewportRect = visibleContentRect();
@@ -1416,6 +1498,9 @@ void FrameView::maintainScrollPositionAtAnchor(Node* anchorNode)
     // We need to update the layout before scrolling, otherwise we could
     // really mess things up if an anchor scroll comes at a bad moment.
     m_frame->document()->updateRenderTreeIfNeeded();
+    // The anchor needs its real position, not an estimated one.
+    if (RenderObject* anchorRenderer = anchorNode->renderer())
+        anchorRenderer->markLayoutDeferredAncestorsForLayout();
     // Only do a layout if changes have occurred that make it necessary.
     RenderView* renderView = this->renderView();
     if (renderView && renderView->needsLayout())
@@ -1511,6 +1596,8 @@ void FrameView::scrollPositionChanged()
 
     m_frame->eventHandler().dispatchFakeMouseMoveEventSoon();
 
+    markDeferredLayoutChildrenNearViewport();
+
     if (RenderView* renderView = document->renderView()) {
         if (renderView->usesCompositing())
             renderView->compositor()->frameViewDidScroll();
@@ -1530,6 +1617,7 @@ void FrameView::didScrollTimerFired(Timer<FrameView>*)
 {
     if (m_frame->document() && m_frame->document()->renderView()) {
         ResourceLoadPriorityOptimizer::resourceLoadPriorityOptimizer()->updateAllImageResourcePriorities();
+        scheduleDispatchOfPendingLoadsInFrameTree(*m_frame);
     }
 }
 
@@ -1737,6 +1825,7 @@ void FrameView::scheduleRelayout()
     if (isSubtreeLayout()) {
         m_layoutSubtreeRoot->markContainingBlocksForLayout(false);
         m_layoutSubtreeRoot = 0;
+        clearIsolatedLayoutSubtreeRoots(true);
     }
     if (!m_layoutSchedulingEnabled)
         return;
@@ -1792,11 +1881,12 @@ void FrameView::scheduleRelayoutOfSubtree(RenderObject* relayoutRoot)
                 m_layoutSubtreeRoot->markContainingBlocksForLayout(false, relayoutRoot);
                 m_layoutSubtreeRoot = relayoutRoot;
                 ASSERT(!m_layoutSubtreeRoot->container() || !m_layoutSubtreeRoot->container()->needsLayout());
-            } else {
+            } else if (!addIsolatedLayoutSubtreeRoot(relayoutRoot)) {
                 // Just do a full relayout
                 if (isSubtreeLayout())
                     m_layoutSubtreeRoot->markContainingBlocksForLayout(false);
                 m_layoutSubtreeRoot = 0;
+                clearIsolatedLayoutSubtreeRoots(true);
                 relayoutRoot->markContainingBlocksForLayout(false);
             }
         }
@@ -1814,6 +1904,71 @@ void FrameView::scheduleRelayoutOfSubtree(RenderObject* relayoutRoot)
     InspectorInstrumentation::didInvalidateLayout(m_frame.get());
 }
 
+// With many independent widgets on a page, e.g. a dashboard, several of them
+// are often changed before the next layout. Each widget that is a relayout
+// boundary is then laid out on its own rather than as part of a full layout.
+static const size_t maxIsolatedLayoutSubtreeRoots = 256;
+
+bool FrameView::addIsolatedLayoutSubtreeRoot(RenderObject* relayoutRoot)
+{
+    if (!RuntimeEnabledFeatures::isolatedSubtreeLayoutEnabled() || !isSubtreeLayout() || !m_layoutSchedulingEnabled)
+        return false;
+
+    for (size_t i = 0; i < m_isolatedLayoutSubtreeRoots.size(); ++i) {
+        RenderObject* root = m_isolatedLayoutSubtreeRoots[i];
+        if (root == relayoutRoot)
+            return true;
+        if (isObjectAncestorContainerOf(root, relayoutRoot)) {
+            relayoutRoot->markContainingBlocksForLayout(false, root);
+            return true;
+        }
+        if (isObjectAncestorContainerOf(relayoutRoot, root)) {
+            root->markContainingBlocksForLayout(false, relayoutRoot);
+            m_isolatedLayoutSubtreeRoots[i] = relayoutRoot;
+            return true;
+        }
+    }
+
+    if (m_isolatedLayoutSubtreeRoots.size() >= maxIsolatedLayoutSubtreeRoots)
+        return false;
+    m_isolatedLayoutSubtreeRoots.append(relayoutRoot);
+    return true;
+}
+
+void FrameView::layoutIsolatedSubtreeRoots()
+{
+    // A relayout boundary has a fixed size and clips its overflow, so laying
+    // it out changes nothing outside of it. This only saves the full layout;
+    // the roots are still laid out one after another on the main thread.
+    size_t laidOutRoots = 0;
+    for (size_t i = 0; i < m_isolatedLayoutSubtreeRoots.size(); ++i) {
+        RenderObject* root = m_isolatedLayoutSubtreeRoots[i];
+        // A root inside another root may have been laid out with it.
+        if (!root->needsLayout())
+            continue;
+        ASSERT(!root->container() || !root->container()->needsLayout());
+
+        TRACE_EVENT0("blink", "FrameView::layoutIsolatedSubtreeRoot");
+        LayoutState layoutState(*root);
+#if ENABLE(ASSERT)
+        RenderObject::IsolatedLayoutScope isolatedLayoutScope(*root);
+#endif
+        root->layout();
+        gatherDebugLayoutRects(root);
+        m_isolatedLayoutSubtreeRoots[laidOutRoots++] = root;
+    }
+    m_isolatedLayoutSubtreeRoots.shrink(laidOutRoots);
+}
+
+void FrameView::clearIsolatedLayoutSubtreeRoots(bool markForFullLayout)
+{
+    if (markForFullLayout) {
+        for (size_t i = 0; i < m_isolatedLayoutSubtreeRoots.size(); ++i)
+            m_isolatedLayoutSubtreeRoots[i]->markContainingBlocksForLayout(false);
+    }
+    m_isolatedLayoutSubtreeRoots.clear();
+}
+
 bool FrameView::layoutPending() const
 {
     // FIXME: This should check Document::lifecycle instead.
@@ -1901,6 +2056,11 @@ void FrameView::scrollToAnchor()
     if (!anchorNode->renderer())
         return;
 
+    // Scroll once the anchor has been laid out; the layout that was just scheduled
+    // calls back here when it is done.
+    if (anchorNode->renderer()->markLayoutDeferredAncestorsForLayout())
+        return;
+
     LayoutRect rect;
     if (anchorNode != m_frame->document())
         rect = anchorNode->boundingBox();
@@ -2043,6 +2203,12 @@ void FrameView::performPostLayoutTasks()
             scrollingCoordinator->notifyLayoutUpdated();
     }
 
+    if (!m_pendingScrollAnchorAdjustment.isZero()) {
+        IntSize adjustment = m_pendingScrollAnchorAdjustment;
+        m_pendingScrollAnchorAdjustment = IntSize();
+        scrollBy(adjustment);
+    }
+
     scrollToAnchor();
 
     sendResizeEventIfNeeded();
@@ -2632,6 +2798,9 @@ void FrameView::updateLayoutAndStyleForPainting()
     // Updating layout can run script, which can tear down the FrameView.
     RefPtr<FrameView> protector(this);
 
+    // The viewport may have grown over deferred children without scrolling.
+    markDeferredLayoutChildrenNearViewport();
+
     updateLayoutAndStyleIfNeededRecursive();
 
     updateWidgetPositionsIfNeeded();
@@ -2650,6 +2819,9 @@ void FrameView::updateLayoutAndStyleForPainting()
 
         InspectorInstrumentation::didUpdateLayerTree(m_frame.get());
 
+        // Renderers invalidate one rect each; let every GraphicsLayer merge
+        // them before they reach the compositor.
+        PaintInvalidationCoalescingScope coalescingScope;
         invalidateTreeIfNeededRecursive();
     }
 
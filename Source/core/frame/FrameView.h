@@ -47,6 +47,7 @@ class LocalFrame;
 class KURL;
 class Node;
 class Page;
+class RenderBlockFlow;
 class RenderBox;
 class RenderEmbeddedObject;
 class RenderObject;
@@ -101,7 +102,8 @@ public:
     bool canInvalidatePaintDuringPerformLayout() const { return m_canInvalidatePaintDuringPerformLayout; }
 
     RenderObject* layoutRoot(bool onlyDuringLayout = false) const;
-    void clearLayoutSubtreeRoot() { m_layoutSubtreeRoot = 0; }
+    bool isLayoutSubtreeRoot(const RenderObject&) const;
+    void clearLayoutSubtreeRoot(const RenderObject&);
     int layoutCount() const { return m_layoutCount; }
 
     bool needsLayout() const;
@@ -182,6 +184,15 @@ public:
     const ViewportConstrainedObjectSet* viewportConstrainedObjects() const { return m_viewportConstrainedObjects.get(); }
     bool hasViewportConstrainedObjects() const { return m_viewportConstrainedObjects && m_viewportConstrainedObjects->size() > 0; }
 
+    // Blocks that gave some of their children an estimated height instead of laying
+    // them out. They are told about scrolling so they can lay those children out.
+    typedef HashSet<RenderBlockFlow*> DeferredLayoutBlockSet;
+    void addBlockWithDeferredLayoutChildren(RenderBlockFlow*);
+    void removeBlockWithDeferredLayoutChildren(RenderBlockFlow*);
+    // Applied after layout so that deferred children above the viewport that turn out
+    // taller or shorter than estimated don't move the content being looked at.
+    void addPendingScrollAnchorAdjustment(const IntSize& adjustment) { m_pendingScrollAnchorAdjustment += adjustment; }
+
     void handleLoadCompleted();
 
     void updateAnnotatedRegions();
@@ -373,6 +384,9 @@ private:
     void forceLayoutParentViewIfNeeded();
     void performPreLayoutTasks();
     void performLayout(RenderObject* rootForThisLayout, bool inSubtreeLayout);
+    bool addIsolatedLayoutSubtreeRoot(RenderObject*);
+    void layoutIsolatedSubtreeRoots();
+    void clearIsolatedLayoutSubtreeRoots(bool markForFullLayout);
     void scheduleOrPerformPostLayoutTasks();
     void performPostLayoutTasks();
 
@@ -411,6 +425,7 @@ private:
     void didScrollTimerFired(Timer<FrameView>*);
 
     void updateLayersAndCompositingAfterScrollIfNeeded();
+    void markDeferredLayoutChildrenNearViewport();
 
     static bool computeCompositedSelectionBounds(LocalFrame&, CompositedSelectionBound& start, CompositedSelectionBound& end);
     void updateFixedElementPaintInvalidationRectsAfterScroll();
@@ -459,6 +474,10 @@ private:
 
     bool m_hasPendingLayout;
     RenderObject* m_layoutSubtreeRoot;
+    // Relayout boundaries unrelated to m_layoutSubtreeRoot which are laid out
+    // in the same subtree layout instead of falling back to a full layout.
+    // They are laid out sequentially, right after m_layoutSubtreeRoot.
+    Vector<RenderObject*> m_isolatedLayoutSubtreeRoots;
 
     bool m_layoutSchedulingEnabled;
     bool m_inPerformLayout;
@@ -510,6 +529,8 @@ private:
     OwnPtr<ScrollableAreaSet> m_scrollableAreas;
     OwnPtr<ResizerAreaSet> m_resizerAreas;
     OwnPtr<ViewportConstrainedObjectSet> m_viewportConstrainedObjects;
+    OwnPtr<DeferredLayoutBlockSet> m_blocksWithDeferredLayoutChildren;
+    IntSize m_pendingScrollAnchorAdjustment;
     OwnPtr<FrameViewAutoSizeInfo> m_autoSizeInfo;
 
     float m_visibleContentScaleFactor;
@@ -0,0 +1,81 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/frame/FrameView.h"
+
+#include "core/dom/Text.h"
+#include "core/rendering/RenderObject.h"
+#include "core/rendering/RenderingTestHelper.h"
+#include "platform/RuntimeEnabledFeatures.h"
+
+namespace blink {
+
+namespace {
+
+class FrameViewTest : public RenderingTest {
+protected:
+    virtual void SetUp()
+    {
+        m_wasIsolatedSubtreeLayoutEnabled = RuntimeEnabledFeatures::isolatedSubtreeLayoutEnabled();
+        RuntimeEnabledFeatures::setIsolatedSubtreeLayoutEnabled(true);
+        RenderingTest::SetUp();
+    }
+
+    virtual void TearDown()
+    {
+        RuntimeEnabledFeatures::setIsolatedSubtreeLayoutEnabled(m_wasIsolatedSubtreeLayoutEnabled);
+    }
+
+    Element* element(const char* id) { return document().getElementById(id); }
+
+    void changeText(const char* id) { toText(element(id)->firstChild())->setData("changed"); }
+
+private:
+    bool m_wasIsolatedSubtreeLayoutEnabled;
+};
+
+TEST_F(FrameViewTest, UnrelatedRelayoutBoundariesAreLaidOutOnTheirOwn)
+{
+    setBodyInnerHTML(
+        "<div id='first' style='width: 100px; height: 100px; overflow: hidden'>text</div>"
+        "<div id='second' style='width: 100px; height: 100px; overflow: hidden'>text</div>");
+    FrameView* view = document().view();
+    RenderObject* first = element("first")->renderer();
+    RenderObject* second = element("second")->renderer();
+
+    changeText("first");
+    changeText("second");
+    EXPECT_TRUE(view->isLayoutSubtreeRoot(*first));
+    EXPECT_TRUE(view->isLayoutSubtreeRoot(*second));
+    EXPECT_FALSE(document().body()->renderer()->needsLayout());
+
+    document().updateLayout();
+    EXPECT_FALSE(first->needsLayout());
+    EXPECT_FALSE(second->needsLayout());
+    EXPECT_FALSE(view->isLayoutSubtreeRoot(*first));
+    EXPECT_FALSE(view->isLayoutSubtreeRoot(*second));
+}
+
+TEST_F(FrameViewTest, FullLayoutIncludesRelayoutBoundaries)
+{
+    setBodyInnerHTML(
+        "<div id='first' style='width: 100px; height: 100px; overflow: hidden'>text</div>"
+        "<div id='second' style='width: 100px; height: 100px; overflow: hidden'>text</div>");
+    FrameView* view = document().view();
+    RenderObject* second = element("second")->renderer();
+
+    changeText("first");
+    changeText("second");
+    view->setNeedsLayout();
+    EXPECT_FALSE(view->isLayoutSubtreeRoot(*second));
+    EXPECT_TRUE(document().body()->renderer()->needsLayout());
+
+    document().updateLayout();
+    EXPECT_FALSE(second->needsLayout());
+}
+
+} // namespace
+
+} // namespace blink
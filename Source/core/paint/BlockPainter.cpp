@@ -11,6 +11,7 @@
 #include "core/frame/Settings.h"
 #include "core/page/Page.h"
 #include "core/paint/BoxPainter.h"
+#include "core/paint/DrawingRecorder.h"
 #include "core/paint/InlinePainter.h"
 #include "core/paint/LineBoxListPainter.h"
 #include "core/rendering/GraphicsContextAnnotator.h"
@@ -19,6 +20,7 @@
 #include "core/rendering/RenderFlexibleBox.h"
 #include "core/rendering/RenderInline.h"
 #include "core/rendering/RenderLayer.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/geometry/LayoutPoint.h"
 #include "platform/geometry/LayoutRect.h"
 #include "platform/graphics/GraphicsContextCullSaver.h"
@@ -83,7 +85,7 @@ void BlockPainter::paintChildren(PaintInfo& paintInfo, const LayoutPoint& paintO
 void BlockPainter::paintChild(RenderBox* child, PaintInfo& paintInfo, const LayoutPoint& paintOffset)
 {
     LayoutPoint childPoint = m_renderBlock.flipForWritingModeForChild(child, paintOffset);
-    if (!child->hasSelfPaintingLayer() && !child->isFloating())
+    if (!child->hasSelfPaintingLayer() && !child->isFloating() && !child->isLayoutDeferred())
         child->paint(paintInfo, childPoint);
 }
 
@@ -410,7 +412,12 @@ void BlockPainter::paintContents(PaintInfo& paintInfo, const LayoutPoint& paintO
         return;
 
     if (m_renderBlock.childrenInline()) {
-        LineBoxListPainter(*m_renderBlock.lineBoxes()).paint(&m_renderBlock, paintInfo, paintOffset);
+        bool canCacheLineBoxes = RuntimeEnabledFeatures::slimmingPaintEnabled() && paintInfo.phase == PaintPhaseForeground && inlineContentsAreCacheable();
+        LayoutRect bounds = m_renderBlock.visualOverflowRect();
+        bounds.moveBy(paintOffset);
+        DrawingRecorder recorder(paintInfo, canCacheLineBoxes ? &m_renderBlock : 0, bounds);
+        if (!recorder.usedCachedDrawing())
+            LineBoxListPainter(*m_renderBlock.lineBoxes()).paint(&m_renderBlock, paintInfo, paintOffset);
     } else {
         PaintPhase newPhase = (paintInfo.phase == PaintPhaseChildOutlines) ? PaintPhaseOutline : paintInfo.phase;
         newPhase = (newPhase == PaintPhaseChildBlockBackgrounds) ? PaintPhaseChildBlockBackground : newPhase;
@@ -423,6 +430,27 @@ void BlockPainter::paintContents(PaintInfo& paintInfo, const LayoutPoint& paintO
     }
 }
 
+bool BlockPainter::inlineContentsAreCacheable() const
+{
+    // The recorded line boxes stay valid as long as neither the block nor any of the text and inlines
+    // painted by them are invalidated (see ViewDisplayList::invalidate()). Anything else painted
+    // as part of the lines, like replaced elements and inline blocks, can change on its own.
+    // Floats and positioned objects are painted separately. A block that clips its overflow may
+    // paint lines outside of its visual overflow rect.
+    if (m_renderBlock.hasOverflowClip())
+        return false;
+    for (RenderObject* child = m_renderBlock.firstChild(); child; ) {
+        if (child->isFloatingOrOutOfFlowPositioned()) {
+            child = child->nextInPreOrderAfterChildren(&m_renderBlock);
+            continue;
+        }
+        if (!child->isText() && !child->isRenderInline())
+            return false;
+        child = child->nextInPreOrder(&m_renderBlock);
+    }
+    return true;
+}
+
 void BlockPainter::paintSelection(PaintInfo& paintInfo, const LayoutPoint& paintOffset)
 {
     if (m_renderBlock.shouldPaintSelectionGaps() && paintInfo.phase == PaintPhaseForeground) {
@@ -37,6 +37,7 @@ private:
     bool hasCaret() const;
     void paintCarets(PaintInfo&, const LayoutPoint&);
     void paintContents(PaintInfo&, const LayoutPoint&);
+    bool inlineContentsAreCacheable() const;
     void paintColumnContents(PaintInfo&, const LayoutPoint&, bool paintFloats = false);
     void paintColumnRules(PaintInfo&, const LayoutPoint&);
     void paintChild(RenderBox*, PaintInfo&, const LayoutPoint&);
@@ -10,6 +10,7 @@
 #include "core/html/HTMLFrameOwnerElement.h"
 #include "core/paint/BackgroundImageGeometry.h"
 #include "core/paint/BoxDecorationData.h"
+#include "core/paint/DrawingRecorder.h"
 #include "core/rendering/ImageQualityController.h"
 #include "core/rendering/PaintInfo.h"
 #include "core/rendering/RenderBox.h"
@@ -45,9 +46,33 @@ void BoxPainter::paintBoxDecorationBackground(PaintInfo& paintInfo, const Layout
 
     LayoutRect paintRect = m_renderBox.borderBoxRect();
     paintRect.moveBy(paintOffset);
+
+    LayoutRect bounds = paintRect;
+    if (const ShadowList* boxShadow = m_renderBox.style()->boxShadow())
+        boxShadow->adjustRectForShadow(bounds);
+    bounds.expand(m_renderBox.style()->borderImageOutsets());
+    DrawingRecorder recorder(paintInfo, boxDecorationBackgroundIsCacheable() ? &m_renderBox : 0, bounds);
+    if (recorder.usedCachedDrawing())
+        return;
+
     paintBoxDecorationBackgroundWithRect(paintInfo, paintOffset, paintRect);
 }
 
+bool BoxPainter::boxDecorationBackgroundIsCacheable() const
+{
+    // The drawing has to depend on nothing but the box itself, or else it might change without the
+    // box being invalidated. Native theme painting, the root and body backgrounds, fixed and
+    // scrolling backgrounds don't qualify, and neither does a background that is skipped because
+    // the content happens to obscure it.
+    RenderStyle* style = m_renderBox.style();
+    return !style->hasAppearance()
+        && !style->hasFixedBackgroundImage()
+        && !m_renderBox.isDocumentElement()
+        && !m_renderBox.isBody()
+        && !m_renderBox.hasOverflowClip()
+        && !m_renderBox.boxDecorationBackgroundIsKnownToBeObscured();
+}
+
 void BoxPainter::paintBoxDecorationBackgroundWithRect(PaintInfo& paintInfo, const LayoutPoint& paintOffset, const LayoutRect& paintRect)
 {
     RenderStyle* style = m_renderBox.style();
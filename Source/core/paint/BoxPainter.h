@@ -36,6 +36,7 @@ public:
     static bool shouldAntialiasLines(GraphicsContext*);
 
 private:
+    bool boxDecorationBackgroundIsCacheable() const;
     void paintBackground(const PaintInfo&, const LayoutRect&, const Color& backgroundColor, BackgroundBleedAvoidance = BackgroundBleedNone);
     void paintRootBoxFillLayers(const PaintInfo&);
     void paintFillLayer(const PaintInfo&, const Color&, const FillLayer&, const LayoutRect&, BackgroundBleedAvoidance, CompositeOperator, RenderObject* backgroundObject, bool skipBaseColor = false);
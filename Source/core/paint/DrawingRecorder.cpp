@@ -0,0 +1,68 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/paint/DrawingRecorder.h"
+
+#include "core/dom/Document.h"
+#include "core/paint/ViewDisplayList.h"
+#include "core/rendering/PaintInfo.h"
+#include "core/rendering/RenderObject.h"
+#include "core/rendering/RenderView.h"
+#include "platform/RuntimeEnabledFeatures.h"
+#include "platform/graphics/GraphicsContext.h"
+
+namespace blink {
+
+static bool canCacheDrawing(const PaintInfo& paintInfo, const RenderObject& renderer)
+{
+    // Anything but a plain paint may draw differently, and must not be cached or replayed.
+    return paintInfo.paintBehavior == PaintBehaviorNormal
+        && !paintInfo.paintingRoot
+        && !paintInfo.context->contextDisabled()
+        && !renderer.document().printing();
+}
+
+DrawingRecorder::DrawingRecorder(const PaintInfo& paintInfo, const RenderObject* renderer, const FloatRect& bounds)
+    : m_context(paintInfo.context)
+    , m_renderer(renderer)
+    , m_phase(paintInfo.phase)
+    , m_isRecording(false)
+    , m_usedCachedDrawing(false)
+{
+    if (!m_renderer || !RuntimeEnabledFeatures::slimmingPaintEnabled() || bounds.isEmpty())
+        return;
+
+    // If something is already recording, we are part of that recording. This is also what happens
+    // to the recorders of renderers painted by a renderer that is being recorded.
+    if (m_context->isRecording() || !canCacheDrawing(paintInfo, *m_renderer))
+        return;
+
+    m_transform = m_context->getTotalMatrix();
+    m_cullRect = paintInfo.rect;
+
+    ViewDisplayList& viewDisplayList = m_renderer->view()->viewDisplayList();
+    if (const DisplayItem* item = viewDisplayList.cachedItem(m_renderer, m_phase)) {
+        if (item->canBeReplayedFor(m_transform, bounds, m_cullRect)) {
+            m_context->drawDisplayList(item->displayList());
+            m_usedCachedDrawing = true;
+            return;
+        }
+    }
+
+    m_context->beginRecording(bounds);
+    m_isRecording = true;
+}
+
+DrawingRecorder::~DrawingRecorder()
+{
+    if (!m_isRecording)
+        return;
+
+    RefPtr<DisplayList> displayList = m_context->endRecording();
+    m_context->drawDisplayList(displayList.get());
+    m_renderer->view()->viewDisplayList().add(m_renderer, DisplayItem(m_phase, displayList.release(), m_transform, m_cullRect));
+}
+
+} // namespace blink
@@ -0,0 +1,45 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef DrawingRecorder_h
+#define DrawingRecorder_h
+
+#include "core/rendering/PaintPhase.h"
+#include "platform/geometry/FloatRect.h"
+#include "platform/geometry/IntRect.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "wtf/Noncopyable.h"
+
+namespace blink {
+
+class GraphicsContext;
+struct PaintInfo;
+class RenderObject;
+
+// Records what is painted for the current phase of a renderer during its lifetime into a display
+// item in the view's ViewDisplayList. If a still valid item was recorded by an earlier paint, it is
+// drawn instead, and usedCachedDrawing() tells the painter to skip painting. Does nothing unless
+// SlimmingPaint is enabled, or if the renderer is null.
+class DrawingRecorder {
+    WTF_MAKE_NONCOPYABLE(DrawingRecorder);
+public:
+    // The bounds must contain everything that will be painted.
+    DrawingRecorder(const PaintInfo&, const RenderObject*, const FloatRect& bounds);
+    ~DrawingRecorder();
+
+    bool usedCachedDrawing() const { return m_usedCachedDrawing; }
+
+private:
+    GraphicsContext* m_context;
+    const RenderObject* m_renderer;
+    PaintPhase m_phase;
+    SkMatrix m_transform;
+    IntRect m_cullRect;
+    bool m_isRecording;
+    bool m_usedCachedDrawing;
+};
+
+} // namespace blink
+
+#endif // DrawingRecorder_h
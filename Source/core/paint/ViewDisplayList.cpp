@@ -0,0 +1,54 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/paint/ViewDisplayList.h"
+
+#include "core/rendering/RenderBlock.h"
+#include "core/rendering/RenderObject.h"
+
+namespace blink {
+
+const DisplayItem* ViewDisplayList::cachedItem(const RenderObject* renderer, PaintPhase phase) const
+{
+    HashMap<const RenderObject*, DisplayItems>::const_iterator it = m_items.find(renderer);
+    if (it == m_items.end())
+        return 0;
+    for (size_t i = 0; i < it->value.size(); ++i) {
+        if (it->value[i].phase() == phase)
+            return &it->value[i];
+    }
+    return 0;
+}
+
+void ViewDisplayList::add(const RenderObject* renderer, const DisplayItem& item)
+{
+    DisplayItems& items = m_items.add(renderer, DisplayItems()).storedValue->value;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (items[i].phase() == item.phase()) {
+            items[i] = item;
+            return;
+        }
+    }
+    items.append(item);
+}
+
+void ViewDisplayList::invalidate(const RenderObject* renderer)
+{
+    m_items.remove(renderer);
+    if (renderer->isText() || renderer->isRenderInline()) {
+        if (RenderBlock* containingBlock = renderer->containingBlock())
+            m_items.remove(containingBlock);
+    }
+}
+
+unsigned ViewDisplayList::itemCount() const
+{
+    unsigned count = 0;
+    for (HashMap<const RenderObject*, DisplayItems>::const_iterator it = m_items.begin(); it != m_items.end(); ++it)
+        count += it->value.size();
+    return count;
+}
+
+} // namespace blink
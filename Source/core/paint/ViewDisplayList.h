@@ -0,0 +1,79 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ViewDisplayList_h
+#define ViewDisplayList_h
+
+#include "core/rendering/PaintPhase.h"
+#include "platform/geometry/IntRect.h"
+#include "platform/graphics/DisplayList.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "wtf/HashMap.h"
+#include "wtf/PassOwnPtr.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+class RenderObject;
+
+// The recorded drawing of one paint phase of a renderer, along with the state it was recorded in.
+class DisplayItem {
+public:
+    DisplayItem(PaintPhase phase, PassRefPtr<DisplayList> displayList, const SkMatrix& transform, const IntRect& cullRect)
+        : m_phase(phase)
+        , m_displayList(displayList)
+        , m_transform(transform)
+        , m_cullRect(cullRect)
+    {
+    }
+
+    PaintPhase phase() const { return m_phase; }
+    DisplayList* displayList() const { return m_displayList.get(); }
+
+    // The drawing can stand in for painting the renderer again if it would be drawn in the same
+    // place, and if nothing that would be painted now was culled when it was recorded.
+    bool canBeReplayedFor(const SkMatrix& transform, const FloatRect& bounds, const IntRect& cullRect) const
+    {
+        return m_transform == transform && m_displayList->bounds() == bounds && m_cullRect.contains(cullRect);
+    }
+
+private:
+    PaintPhase m_phase;
+    RefPtr<DisplayList> m_displayList;
+    SkMatrix m_transform;
+    IntRect m_cullRect;
+};
+
+// Display items recorded for the renderers of a view, kept across paints. Items are dropped when
+// their renderer is invalidated, so that only invalidated renderers have to be painted again; the
+// drawing of all other renderers is replayed from their items. See DrawingRecorder.
+class ViewDisplayList {
+    WTF_MAKE_NONCOPYABLE(ViewDisplayList); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<ViewDisplayList> create() { return adoptPtr(new ViewDisplayList); }
+
+    const DisplayItem* cachedItem(const RenderObject*, PaintPhase) const;
+
+    // Add an item, replacing any existing item for the same renderer and phase.
+    void add(const RenderObject*, const DisplayItem&);
+
+    // Drop the items of a renderer whose paint has been invalidated. Text and inlines are painted
+    // as part of their containing block's line boxes, so the block's items are dropped as well.
+    void invalidate(const RenderObject*);
+
+    // Drop the items of a renderer that is going away.
+    void remove(const RenderObject* renderer) { m_items.remove(renderer); }
+
+    unsigned itemCount() const;
+
+private:
+    ViewDisplayList() { }
+
+    typedef Vector<DisplayItem, 1> DisplayItems;
+    HashMap<const RenderObject*, DisplayItems> m_items;
+};
+
+} // namespace blink
+
+#endif // ViewDisplayList_h
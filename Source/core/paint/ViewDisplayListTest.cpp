@@ -0,0 +1,98 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/paint/ViewDisplayList.h"
+
+#include "core/rendering/RenderingTestHelper.h"
+#include "core/rendering/RenderView.h"
+#include "platform/RuntimeEnabledFeatures.h"
+#include "platform/graphics/GraphicsContext.h"
+#include "platform/testing/SkiaForCoreTesting.h"
+
+namespace blink {
+
+namespace {
+
+class ViewDisplayListTest : public RenderingTest {
+protected:
+    virtual void SetUp()
+    {
+        m_slimmingPaintEnabled = RuntimeEnabledFeatures::slimmingPaintEnabled();
+        RuntimeEnabledFeatures::setSlimmingPaintEnabled(true);
+        RenderingTest::SetUp();
+    }
+
+    virtual void TearDown()
+    {
+        RuntimeEnabledFeatures::setSlimmingPaintEnabled(m_slimmingPaintEnabled);
+    }
+
+    void paint()
+    {
+        document().view()->updateLayoutAndStyleForPainting();
+        SkCanvas canvas(800, 600);
+        GraphicsContext context(&canvas);
+        document().view()->paint(&context, IntRect(0, 0, 800, 600));
+    }
+
+    const DisplayItem* cachedItem(const char* id, PaintPhase phase)
+    {
+        return document().renderView()->viewDisplayList().cachedItem(document().getElementById(id)->renderer(), phase);
+    }
+
+private:
+    bool m_slimmingPaintEnabled;
+};
+
+TEST_F(ViewDisplayListTest, PaintingRecordsDisplayItems)
+{
+    setBodyInnerHTML("<div id='box' style='width: 100px; height: 100px; background-color: blue'></div><div id='text'>Some text</div>");
+    paint();
+
+    EXPECT_TRUE(cachedItem("box", PaintPhaseChildBlockBackground));
+    EXPECT_TRUE(cachedItem("text", PaintPhaseForeground));
+}
+
+TEST_F(ViewDisplayListTest, UnchangedContentIsReplayed)
+{
+    setBodyInnerHTML("<div id='box' style='width: 100px; height: 100px; background-color: blue'></div><div id='text'>Some text</div>");
+    paint();
+    DisplayList* boxDisplayList = cachedItem("box", PaintPhaseChildBlockBackground)->displayList();
+    DisplayList* textDisplayList = cachedItem("text", PaintPhaseForeground)->displayList();
+
+    paint();
+    EXPECT_EQ(boxDisplayList, cachedItem("box", PaintPhaseChildBlockBackground)->displayList());
+    EXPECT_EQ(textDisplayList, cachedItem("text", PaintPhaseForeground)->displayList());
+}
+
+TEST_F(ViewDisplayListTest, InvalidatedContentIsRecordedAgain)
+{
+    setBodyInnerHTML("<div id='box' style='width: 100px; height: 100px; background-color: blue'></div><div id='text'>Some text</div>");
+    paint();
+    DisplayList* boxDisplayList = cachedItem("box", PaintPhaseChildBlockBackground)->displayList();
+    RefPtr<DisplayList> textDisplayList = cachedItem("text", PaintPhaseForeground)->displayList();
+
+    document().getElementById("text")->firstChild()->setTextContent("Some other text");
+    document().view()->updateLayoutAndStyleForPainting();
+    EXPECT_FALSE(cachedItem("text", PaintPhaseForeground));
+    EXPECT_TRUE(cachedItem("box", PaintPhaseChildBlockBackground));
+
+    paint();
+    EXPECT_EQ(boxDisplayList, cachedItem("box", PaintPhaseChildBlockBackground)->displayList());
+    ASSERT_TRUE(cachedItem("text", PaintPhaseForeground));
+    EXPECT_NE(textDisplayList.get(), cachedItem("text", PaintPhaseForeground)->displayList());
+}
+
+TEST_F(ViewDisplayListTest, LinesWithReplacedContentAreNotCached)
+{
+    setBodyInnerHTML("<div id='text'>Some text <img style='width: 10px; height: 10px'></div>");
+    paint();
+
+    EXPECT_FALSE(cachedItem("text", PaintPhaseForeground));
+}
+
+} // namespace
+
+} // namespace blink
@@ -34,6 +34,7 @@ AutoTableLayout::AutoTableLayout(RenderTable* table)
     : TableLayout(table)
     , m_hasPercent(false)
     , m_effectiveLogicalWidthDirty(true)
+    , m_needsFullRecalc(true)
 {
 }
 
@@ -41,20 +42,43 @@ AutoTableLayout::~AutoTableLayout()
 {
 }
 
+void AutoTableLayout::cellPreferredLogicalWidthsChanged(const RenderTableCell& cell)
+{
+    if (m_needsFullRecalc)
+        return;
+
+    // Spanning cells and cells of a grid that is about to be rebuilt don't map to a single known column.
+    if (m_table->needsSectionRecalc() || cell.colSpan() != 1) {
+        m_needsFullRecalc = true;
+        return;
+    }
+
+    unsigned effCol = m_table->colToEffCol(cell.col());
+    if (effCol >= m_layoutStruct.size()) {
+        m_needsFullRecalc = true;
+        return;
+    }
+    m_dirtyColumns.ensureSize(m_layoutStruct.size());
+    m_dirtyColumns.quickSet(effCol);
+}
+
 void AutoTableLayout::recalcColumn(unsigned effCol)
 {
     Layout& columnLayout = m_layoutStruct[effCol];
+    columnLayout = Layout();
+
+    const Length& columnElementLogicalWidth = m_columnElementLogicalWidths[effCol];
+    if (!columnElementLogicalWidth.isAuto()) {
+        columnLayout.logicalWidth = columnElementLogicalWidth;
+        if (columnElementLogicalWidth.isFixed() && columnLayout.maxLogicalWidth < columnElementLogicalWidth.value())
+            columnLayout.maxLogicalWidth = columnElementLogicalWidth.value();
+    }
 
     RenderTableCell* fixedContributor = 0;
     RenderTableCell* maxContributor = 0;
 
     for (RenderObject* child = m_table->children()->firstChild(); child; child = child->nextSibling()) {
-        if (child->isRenderTableCol()){
-            // RenderTableCols don't have the concept of preferred logical width, but we need to clear their dirty bits
-            // so that if we call setPreferredWidthsDirty(true) on a col or one of its descendants, we'll mark it's
-            // ancestors as dirty.
-            toRenderTableCol(child)->clearPreferredLogicalWidthsDirtyBits();
-        } else if (child->isTableSection()) {
+        if (child->isTableSection()) {
             RenderTableSection* section = toRenderTableSection(child);
             unsigned numRows = section->numRows();
             for (unsigned i = 0; i < numRows; i++) {
@@ -111,7 +135,7 @@ void AutoTableLayout::recalcColumn(unsigned effCol)
                         }
                         break;
                     case Percent:
-                        m_hasPercent = true;
+                        columnLayout.hasPercentCell = true;
                         if (cellLogicalWidth.isPositive() && (!columnLayout.logicalWidth.isPercent() || cellLogicalWidth.value() > columnLayout.logicalWidth.value()))
                             columnLayout.logicalWidth = cellLogicalWidth;
                         break;
@@ -139,12 +163,13 @@ void AutoTableLayout::recalcColumn(unsigned effCol)
 
 void AutoTableLayout::fullRecalc()
 {
-    m_hasPercent = false;
-    m_effectiveLogicalWidthDirty = true;
+    m_needsFullRecalc = false;
+    m_dirtyColumns.clearAll();
 
     unsigned nEffCols = m_table->numEffCols();
     m_layoutStruct.resize(nEffCols);
-    m_layoutStruct.fill(Layout());
+    m_columnElementLogicalWidths.resize(nEffCols);
+    m_columnElementLogicalWidths.fill(Length());
     m_spanCells.fill(0);
 
     Length groupLogicalWidth;
@@ -160,11 +185,8 @@ void AutoTableLayout::fullRecalc()
                 colLogicalWidth = Length();
             unsigned effCol = m_table->colToEffCol(currentColumn);
             unsigned span = column->span();
-            if (!colLogicalWidth.isAuto() && span == 1 && effCol < nEffCols && m_table->spanOfEffCol(effCol) == 1) {
-                m_layoutStruct[effCol].logicalWidth = colLogicalWidth;
-                if (colLogicalWidth.isFixed() && m_layoutStruct[effCol].maxLogicalWidth < colLogicalWidth.value())
-                    m_layoutStruct[effCol].maxLogicalWidth = colLogicalWidth.value();
-            }
+            if (!colLogicalWidth.isAuto() && span == 1 && effCol < nEffCols && m_table->spanOfEffCol(effCol) == 1)
+                m_columnElementLogicalWidths[effCol] = colLogicalWidth;
             currentColumn += span;
         }
 
@@ -177,6 +199,38 @@ void AutoTableLayout::fullRecalc()
         recalcColumn(i);
 }
 
+void AutoTableLayout::recalcDirtyColumns()
+{
+    // calcEffectiveLogicalWidth() folds spanning cells back into the per-column values, so
+    // columns can only be recomputed in isolation when there are none.
+    bool hasSpanCells = !m_spanCells.isEmpty() && m_spanCells[0];
+    if (m_needsFullRecalc || hasSpanCells || m_layoutStruct.size() != m_table->numEffCols()) {
+        fullRecalc();
+    } else {
+        // Only single-column cells were touched since the last recalc, so the column element
+        // widths are still valid.
+        unsigned nEffCols = m_layoutStruct.size();
+        for (unsigned i = 0; i < nEffCols && i < m_dirtyColumns.size(); i++) {
+            if (m_dirtyColumns.quickGet(i))
+                recalcColumn(i);
+        }
+        m_dirtyColumns.clearAll();
+    }
+
+    for (RenderObject* child = m_table->children()->firstChild(); child; child = child->nextSibling()) {
+        // RenderTableCols don't have the concept of preferred logical width, but we need to clear their dirty bits
+        // so that if we call setPreferredWidthsDirty(true) on a col or one of its descendants, we'll mark it's
+        // ancestors as dirty.
+        if (child->isRenderTableCol())
+            toRenderTableCol(child)->clearPreferredLogicalWidthsDirtyBits();
+    }
+
+    m_hasPercent = false;
+    for (size_t i = 0; i < m_layoutStruct.size(); ++i)
+        m_hasPercent |= m_layoutStruct[i].hasPercentCell;
+    m_effectiveLogicalWidthDirty = true;
+}
+
 // FIXME: This needs to be adapted for vertical writing modes.
 static bool shouldScaleColumns(RenderTable* table)
 {
@@ -211,7 +265,7 @@ void AutoTableLayout::computeIntrinsicLogicalWidths(LayoutUnit& minWidth, Layout
 {
     TextAutosizer::TableLayoutScope textAutosizerTableLayoutScope(m_table);
 
-    fullRecalc();
+    recalcDirtyColumns();
 
     int spanMaxLogicalWidth = calcEffectiveLogicalWidth();
     minWidth = 0;
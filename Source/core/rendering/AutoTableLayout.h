@@ -24,6 +24,7 @@
 #include "core/rendering/TableLayout.h"
 #include "platform/LayoutUnit.h"
 #include "platform/Length.h"
+#include "wtf/BitVector.h"
 #include "wtf/Vector.h"
 
 namespace blink {
@@ -40,9 +41,12 @@ public:
     virtual void applyPreferredLogicalWidthQuirks(LayoutUnit& minWidth, LayoutUnit& maxWidth) const OVERRIDE;
     virtual void layout() OVERRIDE;
     virtual void willChangeTableLayout() OVERRIDE { }
+    virtual void cellPreferredLogicalWidthsChanged(const RenderTableCell&) OVERRIDE;
+    virtual void invalidateIntrinsicLogicalWidths() OVERRIDE { m_needsFullRecalc = true; }
 
 private:
     void fullRecalc();
+    void recalcDirtyColumns();
     void recalcColumn(unsigned effCol);
 
     int calcEffectiveLogicalWidth();
@@ -57,6 +61,7 @@ private:
             , effectiveMaxLogicalWidth(0)
             , computedLogicalWidth(0)
             , emptyCellsOnly(true)
+            , hasPercentCell(false)
         {
         }
 
@@ -68,12 +73,18 @@ private:
         int effectiveMaxLogicalWidth;
         int computedLogicalWidth;
         bool emptyCellsOnly;
+        bool hasPercentCell;
     };
 
     Vector<Layout, 4> m_layoutStruct;
+    // Widths coming from <col> and <colgroup>, applied before the cells of each column.
+    Vector<Length, 4> m_columnElementLogicalWidths;
     Vector<RenderTableCell*, 4> m_spanCells;
+    // Columns holding a single-column cell whose preferred widths changed since the last recalc.
+    BitVector m_dirtyColumns;
     bool m_hasPercent : 1;
     mutable bool m_effectiveLogicalWidthDirty : 1;
+    bool m_needsFullRecalc : 1;
 };
 
 } // namespace blink
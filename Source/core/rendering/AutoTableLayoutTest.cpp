@@ -0,0 +1,75 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+
+#include "core/HTMLNames.h"
+#include "core/rendering/RenderingTestHelper.h"
+#include "core/rendering/RenderTable.h"
+
+namespace blink {
+
+namespace {
+
+class AutoTableLayoutTest : public RenderingTest {
+protected:
+    RenderTable* tableById(const char* id)
+    {
+        return toRenderTable(document().getElementById(id)->renderer());
+    }
+
+    void setTextAndUpdateLayout(const char* id, const char* text)
+    {
+        document().getElementById(id)->setTextContent(text);
+        document().view()->updateLayoutAndStyleIfNeededRecursive();
+    }
+};
+
+TEST_F(AutoTableLayoutTest, ChangedCellUpdatesIntrinsicWidths)
+{
+    setBodyInnerHTML(
+        "<table id='changed'><tr><td id='cell'>a</td><td>b</td></tr><tr><td>c</td><td>d</td></tr></table>"
+        "<table id='expected'><tr><td>a much longer cell</td><td>b</td></tr><tr><td>c</td><td>d</td></tr></table>");
+    RenderTable* changed = tableById("changed");
+    RenderTable* expected = tableById("expected");
+    EXPECT_LT(changed->maxPreferredLogicalWidth(), expected->maxPreferredLogicalWidth());
+
+    setTextAndUpdateLayout("cell", "a much longer cell");
+    EXPECT_EQ(expected->minPreferredLogicalWidth(), changed->minPreferredLogicalWidth());
+    EXPECT_EQ(expected->maxPreferredLogicalWidth(), changed->maxPreferredLogicalWidth());
+    EXPECT_EQ(expected->logicalWidth(), changed->logicalWidth());
+
+    setTextAndUpdateLayout("cell", "a");
+    EXPECT_LT(changed->maxPreferredLogicalWidth(), expected->maxPreferredLogicalWidth());
+}
+
+TEST_F(AutoTableLayoutTest, ChangedCellWithSpanningCellsUpdatesIntrinsicWidths)
+{
+    setBodyInnerHTML(
+        "<table id='changed'><tr><td id='cell'>a</td><td>b</td></tr><tr><td colspan=2>spanning cell</td></tr></table>"
+        "<table id='expected'><tr><td>a much longer cell</td><td>b</td></tr><tr><td colspan=2>spanning cell</td></tr></table>");
+    RenderTable* changed = tableById("changed");
+    RenderTable* expected = tableById("expected");
+
+    setTextAndUpdateLayout("cell", "a much longer cell");
+    EXPECT_EQ(expected->minPreferredLogicalWidth(), changed->minPreferredLogicalWidth());
+    EXPECT_EQ(expected->maxPreferredLogicalWidth(), changed->maxPreferredLogicalWidth());
+}
+
+TEST_F(AutoTableLayoutTest, ColumnElementWidthChangeUpdatesIntrinsicWidths)
+{
+    setBodyInnerHTML(
+        "<table id='changed'><col id='col' style='width: 10px'><tr><td>a</td><td>b</td></tr></table>"
+        "<table id='expected'><col style='width: 200px'><tr><td>a</td><td>b</td></tr></table>");
+    RenderTable* changed = tableById("changed");
+    RenderTable* expected = tableById("expected");
+
+    document().getElementById("col")->setAttribute(HTMLNames::styleAttr, "width: 200px");
+    document().view()->updateLayoutAndStyleIfNeededRecursive();
+    EXPECT_EQ(expected->maxPreferredLogicalWidth(), changed->maxPreferredLogicalWidth());
+}
+
+} // namespace
+
+} // namespace blink
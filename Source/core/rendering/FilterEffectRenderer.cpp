@@ -39,6 +39,7 @@
 #include "core/svg/SVGFilterPrimitiveStandardAttributes.h"
 #include "platform/FloatConversion.h"
 #include "platform/LengthFunctions.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/graphics/ColorSpace.h"
 #include "platform/graphics/UnacceleratedImageBufferSurface.h"
 #include "platform/graphics/filters/FEColorMatrix.h"
@@ -46,11 +47,26 @@
 #include "platform/graphics/filters/FEDropShadow.h"
 #include "platform/graphics/filters/FEGaussianBlur.h"
 #include "platform/graphics/filters/SkiaImageFilterBuilder.h"
+#include "wtf/HashSet.h"
+#include "wtf/ListHashSet.h"
 #include "wtf/MathExtras.h"
 #include <algorithm>
 
 namespace blink {
 
+const size_t FilterEffectRenderer::maxCachedResultBytesPerRenderer;
+const size_t FilterEffectRenderer::maxTotalCachedResultBytes;
+
+// Renderers that keep results, least recently applied first.
+typedef ListHashSet<FilterEffectRenderer*> FilterEffectRendererList;
+static FilterEffectRendererList& renderersWithCachedResults()
+{
+    DEFINE_STATIC_LOCAL(FilterEffectRendererList, renderers, ());
+    return renderers;
+}
+
+static size_t s_totalCachedResultBytes = 0;
+
 static inline void endMatrixRow(Vector<float>& parameters)
 {
     parameters.append(0);
@@ -68,6 +84,7 @@ static inline void lastMatrixRow(Vector<float>& parameters)
 
 FilterEffectRenderer::FilterEffectRenderer()
     : Filter(AffineTransform())
+    , m_cachedResultBytes(0)
     , m_graphicsBufferAttached(false)
     , m_hasFilterThatMovesPixels(false)
 {
@@ -76,6 +93,7 @@ FilterEffectRenderer::FilterEffectRenderer()
 
 FilterEffectRenderer::~FilterEffectRenderer()
 {
+    setCachedResultBytes(0);
 }
 
 GraphicsContext* FilterEffectRenderer::inputContext()
@@ -248,6 +266,9 @@ bool FilterEffectRenderer::build(RenderObject* renderer, const FilterOperations&
     if (!m_lastEffect.get())
         return false;
 
+    // The source graphic outlives rebuilds; don't let it keep a result from the old chain.
+    clearIntermediateResults();
+
     return true;
 }
 
@@ -283,6 +304,23 @@ void FilterEffectRenderer::clearIntermediateResults()
 {
     if (m_lastEffect.get())
         m_lastEffect->clearResultsRecursive();
+    setCachedResultBytes(0);
+}
+
+void FilterEffectRenderer::invalidateResultsForSourceRect(const FloatRect& dirtyRect)
+{
+    if (!m_lastEffect.get())
+        return;
+
+    if (!RuntimeEnabledFeatures::filterResultCachingEnabled()
+        || absoluteTransform() != m_resultAbsoluteTransform
+        || filterRegion() != m_resultFilterRegion
+        || sourceImageRect() != m_resultSourceImageRect) {
+        clearIntermediateResults();
+        return;
+    }
+
+    m_lastEffect->invalidateResultsRecursive(dirtyRect);
 }
 
 void FilterEffectRenderer::apply()
@@ -290,6 +328,61 @@ void FilterEffectRenderer::apply()
     RefPtr<FilterEffect> effect = lastEffect();
     effect->apply();
     effect->transformResultColorSpace(ColorSpaceDeviceRGB);
+
+    m_resultAbsoluteTransform = absoluteTransform();
+    m_resultFilterRegion = filterRegion();
+    m_resultSourceImageRect = sourceImageRect();
+}
+
+static size_t resultMemoryUsageRecursive(FilterEffect* effect, HashSet<FilterEffect*>& visitedEffects)
+{
+    if (!visitedEffects.add(effect).isNewEntry)
+        return 0;
+
+    size_t bytes = effect->resultMemoryUsage();
+    for (unsigned i = 0; i < effect->numberOfEffectInputs(); ++i)
+        bytes += resultMemoryUsageRecursive(effect->inputEffect(i), visitedEffects);
+    return bytes;
+}
+
+void FilterEffectRenderer::releaseResultsOverBudget()
+{
+    if (!m_lastEffect.get())
+        return;
+
+    if (!RuntimeEnabledFeatures::filterResultCachingEnabled()) {
+        clearIntermediateResults();
+        return;
+    }
+
+    HashSet<FilterEffect*> visitedEffects;
+    size_t bytes = resultMemoryUsageRecursive(m_lastEffect.get(), visitedEffects);
+    if (bytes > maxCachedResultBytesPerRenderer) {
+        clearIntermediateResults();
+        return;
+    }
+
+    setCachedResultBytes(bytes);
+
+    // This renderer is now the most recently used, and fits the budget on its own.
+    FilterEffectRendererList& renderers = renderersWithCachedResults();
+    while (s_totalCachedResultBytes > maxTotalCachedResultBytes) {
+        ASSERT(renderers.first() != this);
+        renderers.first()->clearIntermediateResults();
+    }
+}
+
+void FilterEffectRenderer::setCachedResultBytes(size_t bytes)
+{
+    ASSERT(s_totalCachedResultBytes >= m_cachedResultBytes);
+    s_totalCachedResultBytes = s_totalCachedResultBytes - m_cachedResultBytes + bytes;
+    m_cachedResultBytes = bytes;
+
+    // Re-adding moves the renderer to the most recently used end.
+    FilterEffectRendererList& renderers = renderersWithCachedResults();
+    renderers.remove(this);
+    if (bytes)
+        renderers.add(this);
 }
 
 LayoutRect FilterEffectRenderer::computeSourceImageRectForDirtyRect(const LayoutRect& filterBoxRect, const LayoutRect& dirtyRect)
@@ -404,12 +497,13 @@ GraphicsContext* FilterEffectRendererHelper::applyFilterEffect()
 
     filter->inputContext()->restore();
 
+    filter->invalidateResultsForSourceRect(m_paintInvalidationRect);
     filter->apply();
 
     // Get the filtered output and draw it in place.
     m_savedGraphicsContext->drawImageBuffer(filter->output(), filter->outputRect());
 
-    filter->clearIntermediateResults();
+    filter->releaseResultsOverBudget();
 
     return m_savedGraphicsContext;
 }
@@ -94,7 +94,20 @@ public:
     bool updateBackingStoreRect(const FloatRect& filterRect);
     void allocateBackingStoreIfNeeded();
     void clearIntermediateResults();
+
+    // Results of the effects are kept between paints. Before applying, drop
+    // the ones made stale by repainting |dirtyRect| of the source image, or
+    // all of them if the filter geometry has changed since the last apply().
+    void invalidateResultsForSourceRect(const FloatRect& dirtyRect);
     void apply();
+    // Drops the kept results if they take more than maxCachedResultBytesPerRenderer.
+    // Otherwise marks them most recently used, and drops the least recently used
+    // results of other renderers until all renderers together fit in
+    // maxTotalCachedResultBytes.
+    void releaseResultsOverBudget();
+
+    static const size_t maxCachedResultBytesPerRenderer = 8 * 1024 * 1024;
+    static const size_t maxTotalCachedResultBytes = 32 * 1024 * 1024;
 
     IntRect outputRect() const { return lastEffect()->hasResult() ? lastEffect()->absolutePaintRect() : IntRect(); }
 
@@ -110,11 +123,20 @@ private:
     FilterEffectRenderer();
     virtual ~FilterEffectRenderer();
 
+    void setCachedResultBytes(size_t);
+
     IntRect m_sourceDrawingRegion;
 
     RefPtr<SourceGraphic> m_sourceGraphic;
     RefPtr<FilterEffect> m_lastEffect;
 
+    // The geometry the kept results were computed for.
+    AffineTransform m_resultAbsoluteTransform;
+    FloatRect m_resultFilterRegion;
+    IntRect m_resultSourceImageRect;
+    // What the kept results count for against maxTotalCachedResultBytes.
+    size_t m_cachedResultBytes;
+
     bool m_graphicsBufferAttached;
     bool m_hasFilterThatMovesPixels;
 };
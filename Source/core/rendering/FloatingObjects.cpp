@@ -28,6 +28,8 @@
 #include "core/rendering/RenderBox.h"
 #include "core/rendering/RenderView.h"
 
+#include <algorithm>
+
 using namespace WTF;
 
 namespace blink {
@@ -175,6 +177,7 @@ void FloatingObjects::clearLineBoxTreePointers()
 
 FloatingObjects::FloatingObjects(const RenderBlockFlow* renderer, bool horizontalWritingMode)
     : m_placedFloatsTree(UninitializedTree)
+    , m_bandMapState(BandMapInvalid)
     , m_leftObjectsCount(0)
     , m_rightObjectsCount(0)
     , m_horizontalWritingMode(horizontalWritingMode)
@@ -187,6 +190,7 @@ void FloatingObjects::clear()
 {
     m_set.clear();
     m_placedFloatsTree.clear();
+    invalidateBandMap();
     m_leftObjectsCount = 0;
     m_rightObjectsCount = 0;
     markLowestFloatLogicalBottomCacheAsDirty();
@@ -309,6 +313,8 @@ void FloatingObjects::addPlacedObject(FloatingObject* floatingObject)
     floatingObject->setIsPlaced(true);
     if (m_placedFloatsTree.isInitialized())
         m_placedFloatsTree.add(intervalForFloatingObject(floatingObject));
+    if (m_bandMapState == BandMapValid)
+        addToBandMap(floatingObject);
 
 #if ENABLE(ASSERT)
     floatingObject->setIsInPlacedTree(true);
@@ -324,6 +330,7 @@ void FloatingObjects::removePlacedObject(FloatingObject* floatingObject)
         bool removed = m_placedFloatsTree.remove(intervalForFloatingObject(floatingObject));
         ASSERT_UNUSED(removed, removed);
     }
+    invalidateBandMap();
 
     floatingObject->setIsPlaced(false);
 #if ENABLE(ASSERT)
@@ -369,6 +376,107 @@ void FloatingObjects::computePlacedFloatsTree()
     }
 }
 
+void FloatingObjects::invalidateBandMap()
+{
+    m_bands.clear();
+    m_bandMapState = BandMapInvalid;
+}
+
+bool FloatingObjects::updateBandMapIfNeeded()
+{
+    if (m_bandMapState != BandMapInvalid)
+        return m_bandMapState == BandMapValid;
+
+    m_bandMapState = BandMapValid;
+    FloatingObjectSetIterator end = m_set.end();
+    for (FloatingObjectSetIterator it = m_set.begin(); it != end && m_bandMapState == BandMapValid; ++it) {
+        FloatingObject* floatingObject = it->get();
+        if (floatingObject->isPlaced())
+            addToBandMap(floatingObject);
+    }
+    return m_bandMapState == BandMapValid;
+}
+
+static inline bool bandIsAbove(const FloatingObjectBand& band, int logicalTop)
+{
+    return band.logicalTop < logicalTop;
+}
+
+static inline bool bandIsBelow(int logicalTop, const FloatingObjectBand& band)
+{
+    return logicalTop < band.logicalTop;
+}
+
+size_t FloatingObjects::splitBandAt(int logicalTop)
+{
+    size_t index = std::lower_bound(m_bands.begin(), m_bands.end(), logicalTop, bandIsAbove) - m_bands.begin();
+    if (index < m_bands.size() && m_bands[index].logicalTop == logicalTop)
+        return index;
+
+    // The new band starts out covered by the same floats as the one it splits.
+    FloatingObjectBand band = index ? m_bands[index - 1] : FloatingObjectBand();
+    band.logicalTop = logicalTop;
+    m_bands.insert(index, band);
+    return index;
+}
+
+void FloatingObjects::addToBandMap(FloatingObject* floatingObject)
+{
+    ASSERT(m_bandMapState == BandMapValid);
+    FloatingObjectInterval interval = intervalForFloatingObject(floatingObject);
+    if (interval.low() >= interval.high() || floatingObject->renderer()->shapeOutsideInfo()) {
+        m_bands.clear();
+        m_bandMapState = BandMapUnusable;
+        return;
+    }
+
+    size_t first = splitBandAt(interval.low());
+    size_t last = splitBandAt(interval.high());
+    if (floatingObject->type() == FloatingObject::FloatLeft) {
+        LayoutUnit logicalRight = m_renderer->logicalRightForFloat(floatingObject);
+        for (size_t i = first; i < last; ++i) {
+            FloatingObjectBand& band = m_bands[i];
+            if (!band.hasLeftFloats || logicalRight > band.leftFloatsLogicalRight) {
+                band.leftFloatsLogicalRight = logicalRight;
+                band.hasLeftFloats = true;
+            }
+        }
+    } else {
+        LayoutUnit logicalLeft = m_renderer->logicalLeftForFloat(floatingObject);
+        for (size_t i = first; i < last; ++i) {
+            FloatingObjectBand& band = m_bands[i];
+            if (!band.hasRightFloats || logicalLeft < band.rightFloatsLogicalLeft) {
+                band.rightFloatsLogicalLeft = logicalLeft;
+                band.hasRightFloats = true;
+            }
+        }
+    }
+}
+
+bool FloatingObjects::offsetFromBandMap(FloatingObject::Type floatType, int lineTop, int lineBottom, LayoutUnit& offset)
+{
+    if (lineBottom < lineTop || !updateBandMapIfNeeded())
+        return false;
+
+    // An empty line still runs into the floats that start at its top.
+    if (lineBottom == lineTop)
+        ++lineBottom;
+
+    size_t index = std::upper_bound(m_bands.begin(), m_bands.end(), lineTop, bandIsBelow) - m_bands.begin();
+    if (index)
+        --index;
+    for (; index < m_bands.size() && m_bands[index].logicalTop < lineBottom; ++index) {
+        const FloatingObjectBand& band = m_bands[index];
+        if (floatType == FloatingObject::FloatLeft) {
+            if (band.hasLeftFloats && band.leftFloatsLogicalRight > offset)
+                offset = band.leftFloatsLogicalRight;
+        } else if (band.hasRightFloats && band.rightFloatsLogicalLeft < offset) {
+            offset = band.rightFloatsLogicalLeft;
+        }
+    }
+    return true;
+}
+
 LayoutUnit FloatingObjects::logicalLeftOffsetForPositioningFloat(LayoutUnit fixedOffset, LayoutUnit logicalTop, LayoutUnit *heightRemaining)
 {
     int logicalTopAsInt = roundToInt(logicalTop);
@@ -395,7 +503,13 @@ LayoutUnit FloatingObjects::logicalRightOffsetForPositioningFloat(LayoutUnit fix
 
 LayoutUnit FloatingObjects::logicalLeftOffset(LayoutUnit fixedOffset, LayoutUnit logicalTop, LayoutUnit logicalHeight)
 {
-    ComputeFloatOffsetForLineLayoutAdapter<FloatingObject::FloatLeft> adapter(m_renderer, roundToInt(logicalTop), roundToInt(logicalTop + logicalHeight), fixedOffset);
+    int lineTop = roundToInt(logicalTop);
+    int lineBottom = roundToInt(logicalTop + logicalHeight);
+    LayoutUnit offset = fixedOffset;
+    if (offsetFromBandMap(FloatingObject::FloatLeft, lineTop, lineBottom, offset))
+        return offset;
+
+    ComputeFloatOffsetForLineLayoutAdapter<FloatingObject::FloatLeft> adapter(m_renderer, lineTop, lineBottom, fixedOffset);
     placedFloatsTree().allOverlapsWithAdapter(adapter);
 
     return adapter.offset();
@@ -403,7 +517,13 @@ LayoutUnit FloatingObjects::logicalLeftOffset(LayoutUnit fixedOffset, LayoutUnit
 
 LayoutUnit FloatingObjects::logicalRightOffset(LayoutUnit fixedOffset, LayoutUnit logicalTop, LayoutUnit logicalHeight)
 {
-    ComputeFloatOffsetForLineLayoutAdapter<FloatingObject::FloatRight> adapter(m_renderer, roundToInt(logicalTop), roundToInt(logicalTop + logicalHeight), fixedOffset);
+    int lineTop = roundToInt(logicalTop);
+    int lineBottom = roundToInt(logicalTop + logicalHeight);
+    LayoutUnit offset = fixedOffset;
+    if (offsetFromBandMap(FloatingObject::FloatRight, lineTop, lineBottom, offset))
+        return offset;
+
+    ComputeFloatOffsetForLineLayoutAdapter<FloatingObject::FloatRight> adapter(m_renderer, lineTop, lineBottom, fixedOffset);
     placedFloatsTree().allOverlapsWithAdapter(adapter);
 
     return std::min(fixedOffset, adapter.offset());
@@ -29,6 +29,7 @@
 #include "platform/PODIntervalTree.h"
 #include "wtf/ListHashSet.h"
 #include "wtf/OwnPtr.h"
+#include "wtf/Vector.h"
 
 namespace blink {
 
@@ -133,6 +134,23 @@ typedef PODIntervalTree<int, FloatingObject*> FloatingObjectTree;
 typedef PODFreeListArena<PODRedBlackTree<FloatingObjectInterval>::Node> IntervalArena;
 typedef HashMap<RenderBox*, OwnPtr<FloatingObject> > RendererToFloatInfoMap;
 
+// A vertical slice of the block running from |logicalTop| to the top of the
+// next band, recording how far the placed floats overlapping it intrude.
+struct FloatingObjectBand {
+    FloatingObjectBand()
+        : logicalTop(0)
+        , hasLeftFloats(false)
+        , hasRightFloats(false)
+    {
+    }
+
+    int logicalTop;
+    LayoutUnit leftFloatsLogicalRight;
+    LayoutUnit rightFloatsLogicalLeft;
+    bool hasLeftFloats;
+    bool hasRightFloats;
+};
+
 class FloatingObjects {
     WTF_MAKE_NONCOPYABLE(FloatingObjects); WTF_MAKE_FAST_ALLOCATED;
 public:
@@ -145,13 +163,21 @@ public:
     void remove(FloatingObject*);
     void addPlacedObject(FloatingObject*);
     void removePlacedObject(FloatingObject*);
-    void setHorizontalWritingMode(bool b = true) { m_horizontalWritingMode = b; }
+    void setHorizontalWritingMode(bool b = true)
+    {
+        m_horizontalWritingMode = b;
+        invalidateBandMap();
+    }
 
     bool hasLeftObjects() const { return m_leftObjectsCount > 0; }
     bool hasRightObjects() const { return m_rightObjectsCount > 0; }
     const FloatingObjectSet& set() const { return m_set; }
     void clearLineBoxTreePointers();
 
+    // Drops the band map; it is rebuilt from the placed floats on the next
+    // line query.
+    void invalidateBandMap();
+
     LayoutUnit logicalLeftOffset(LayoutUnit fixedOffset, LayoutUnit logicalTop, LayoutUnit logicalHeight);
     LayoutUnit logicalRightOffset(LayoutUnit fixedOffset, LayoutUnit logicalTop, LayoutUnit logicalHeight);
 
@@ -173,12 +199,27 @@ private:
             computePlacedFloatsTree();
         return m_placedFloatsTree;
     }
+    bool updateBandMapIfNeeded();
+    void addToBandMap(FloatingObject*);
+    size_t splitBandAt(int logicalTop);
+    bool offsetFromBandMap(FloatingObject::Type, int lineTop, int lineBottom, LayoutUnit& offset);
+
     void increaseObjectsCount(FloatingObject::Type);
     void decreaseObjectsCount(FloatingObject::Type);
     FloatingObjectInterval intervalForFloatingObject(FloatingObject*);
 
     FloatingObjectSet m_set;
     FloatingObjectTree m_placedFloatsTree;
+
+    // The placed floats flattened into bands between their edges, so that
+    // line layout finds the available width with a binary search instead of
+    // an interval tree walk. Floats with shape-outside depend on the line
+    // and zero height floats only intersect lines that enclose them, so
+    // either makes the map unusable until it is next rebuilt.
+    enum BandMapState { BandMapInvalid, BandMapValid, BandMapUnusable };
+    Vector<FloatingObjectBand> m_bands;
+    BandMapState m_bandMapState;
+
     unsigned m_leftObjectsCount;
     unsigned m_rightObjectsCount;
     bool m_horizontalWritingMode;
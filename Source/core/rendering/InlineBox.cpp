@@ -74,6 +74,15 @@ void InlineBox::operator delete(void* ptr)
     partitionFree(ptr);
 }
 
+size_t InlineBox::allocatedBytes() const
+{
+    // When a memory tool replaces the partition allocator only the static
+    // size is known.
+    if (!partitionAllocSupportsGetSize())
+        return sizeof(*this);
+    return partitionAllocGetSize(const_cast<InlineBox*>(this));
+}
+
 #ifndef NDEBUG
 const char* InlineBox::boxName() const
 {
@@ -105,6 +105,10 @@ public:
     void* operator new(size_t);
     void operator delete(void*);
 
+    // The memory taken by this box, any boxes below it and their out of line
+    // data, for reporting how much line boxes cost.
+    virtual size_t allocatedBytes() const;
+
 #ifndef NDEBUG
     void showTreeForThis() const;
     void showLineTreeForThis() const;
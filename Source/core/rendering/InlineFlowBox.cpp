@@ -71,6 +71,16 @@ LayoutUnit InlineFlowBox::getFlowSpacingLogicalWidth()
     return totWidth;
 }
 
+size_t InlineFlowBox::allocatedBytes() const
+{
+    size_t bytes = InlineBox::allocatedBytes();
+    if (m_overflow)
+        bytes += sizeof(RenderOverflow);
+    for (InlineBox* child = firstChild(); child; child = child->nextOnLine())
+        bytes += child->allocatedBytes();
+    return bytes;
+}
+
 IntRect InlineFlowBox::roundedFrameRect() const
 {
     // Begin by snapping the x and y coordinates to the nearest pixel.
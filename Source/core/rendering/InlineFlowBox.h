@@ -113,6 +113,8 @@ public:
 
     virtual void clearTruncation() OVERRIDE;
 
+    virtual size_t allocatedBytes() const OVERRIDE;
+
     IntRect roundedFrameRect() const;
 
     virtual void paint(PaintInfo&, const LayoutPoint&, LayoutUnit lineTop, LayoutUnit lineBottom) OVERRIDE;
@@ -155,6 +155,9 @@ RenderBlock::RenderBlock(ContainerNode* node)
     , m_hasBorderOrPaddingLogicalWidthChanged(false)
     , m_hasOnlySelfCollapsingChildren(false)
     , m_descendantsWithFloatsMarkedForLayout(false)
+    , m_layoutDeferred(false)
+    , m_layoutDeferralForbidden(false)
+    , m_hasDeferredLayoutChildren(false)
 {
     // RenderBlockFlow calls setChildrenInline(true).
     // By default, subclasses do not have inline children.
@@ -242,6 +245,15 @@ void RenderBlock::destroy()
 #endif
 }
 
+void RenderBlock::willBeRemovedFromTree()
+{
+    RenderBox::willBeRemovedFromTree();
+
+    // Whoever lays us out next decides again whether to defer it.
+    m_layoutDeferred = false;
+    m_layoutDeferralForbidden = false;
+}
+
 void RenderBlock::willBeDestroyed()
 {
     // Mark as being destroyed to avoid trouble with merges in removeChild().
@@ -2569,6 +2581,15 @@ bool RenderBlock::hitTestContents(const HitTestRequest& request, HitTestResult&
             childHitTest = HitTestChildBlockBackground;
         for (RenderBox* child = lastChildBox(); child; child = child->previousSiblingBox()) {
             LayoutPoint childPoint = flipForWritingModeForChild(child, accumulatedOffset);
+            if (child->isLayoutDeferred()) {
+                // Layout can't run in the middle of a hit test. Have the child laid out
+                // so that RenderView::hitTest can test it again with real geometry.
+                LayoutRect estimatedRect = child->frameRect();
+                estimatedRect.moveBy(childPoint);
+                if (locationInContainer.intersects(estimatedRect))
+                    child->markLayoutDeferredAncestorsForLayout();
+                continue;
+            }
             if (!child->hasSelfPaintingLayer() && !child->isFloating() && child->nodeAtPoint(request, result, locationInContainer, childPoint, childHitTest))
                 return true;
         }
@@ -4091,6 +4112,12 @@ void RenderBlock::updateMinimumPageHeight(LayoutUnit offset, LayoutUnit minHeigh
         colInfo->updateMinimumColumnHeight(minHeight);
 }
 
+void RenderBlock::addUnbreakableContent(LayoutUnit offset, LayoutUnit logicalHeight)
+{
+    if (RenderFlowThread* flowThread = flowThreadContainingBlock())
+        flowThread->addUnbreakableContent(offsetFromLogicalTopOfFirstPage() + offset, logicalHeight);
+}
+
 LayoutUnit RenderBlock::offsetFromLogicalTopOfFirstPage() const
 {
     LayoutState* layoutState = view()->layoutState();
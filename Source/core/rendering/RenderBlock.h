@@ -257,8 +257,16 @@ public:
     bool recalcChildOverflowAfterStyleChange();
     bool recalcOverflowAfterStyleChange();
 
+    virtual bool isLayoutDeferred() const OVERRIDE FINAL { return m_layoutDeferred; }
+    void setLayoutDeferred(bool deferred) { m_layoutDeferred = deferred; }
+    // Set on a deferred block whose geometry was asked for, so that the next layout
+    // of its parent lays it out no matter how far it is from the viewport.
+    bool isLayoutDeferralForbidden() const { return m_layoutDeferralForbidden; }
+    void setLayoutDeferralForbidden(bool forbidden) { m_layoutDeferralForbidden = forbidden; }
+
 protected:
     virtual void willBeDestroyed() OVERRIDE;
+    virtual void willBeRemovedFromTree() OVERRIDE;
 
     void dirtyForLayoutFromPercentageHeightDescendants(SubtreeLayoutScope&);
 
@@ -459,6 +467,10 @@ protected:
     // column balancer to help set a good minimum column height.
     void updateMinimumPageHeight(LayoutUnit offset, LayoutUnit minHeight);
 
+    // Report content that may not be split across fragmentainers. The column balancer uses this to
+    // predict where breaks will occur, before column heights are known.
+    void addUnbreakableContent(LayoutUnit offset, LayoutUnit logicalHeight);
+
     // Adjust from painting offsets to the local coords of this renderer
     void offsetForContents(LayoutPoint&) const;
 
@@ -484,6 +496,9 @@ protected:
     unsigned m_hasBorderOrPaddingLogicalWidthChanged : 1;
     mutable unsigned m_hasOnlySelfCollapsingChildren : 1;
     mutable unsigned m_descendantsWithFloatsMarkedForLayout : 1;
+    unsigned m_layoutDeferred : 1;
+    unsigned m_layoutDeferralForbidden : 1;
+    unsigned m_hasDeferredLayoutChildren : 1; // Only used by RenderBlockFlow.
 
     // RenderRubyBase objects need to be able to split and merge, moving their children around
     // (calling moveChildTo, moveAllChildrenTo, and makeChildrenNonInline).
@@ -47,12 +47,16 @@
 #include "core/rendering/TextAutosizer.h"
 #include "core/rendering/line/LineWidth.h"
 #include "core/rendering/svg/SVGTextRunRenderingContext.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/text/BidiTextRun.h"
 
 namespace blink {
 
 bool RenderBlockFlow::s_canPropagateFloatIntoSibling = false;
 
+// Blocks with fewer children than this always lay out all of them.
+static const unsigned minimumChildCountForDeferredLayout = 1000;
+
 struct SameSizeAsMarginInfo {
     uint16_t bitfields;
     LayoutUnit margins[2];
@@ -827,6 +831,7 @@ void RenderBlockFlow::adjustLinePositionForPagination(RootInlineBox* lineBox, La
     LayoutUnit lineHeight = logicalBottom - logicalOffset;
     updateMinimumPageHeight(logicalOffset, calculateMinimumPageHeight(style(), lineBox, logicalOffset, logicalBottom));
     logicalOffset += delta;
+    addUnbreakableContent(logicalOffset, lineHeight);
     lineBox->setPaginationStrut(0);
     lineBox->setIsFirstAfterPageBreak(false);
     LayoutUnit pageLogicalHeight = pageLogicalHeightForOffset(logicalOffset);
@@ -881,6 +886,7 @@ LayoutUnit RenderBlockFlow::adjustForUnsplittableChild(RenderBox* child, LayoutU
     LayoutUnit childLogicalHeight = logicalHeightForChild(child) + (includeMargins ? marginBeforeForChild(child) + marginAfterForChild(child) : LayoutUnit());
     LayoutUnit pageLogicalHeight = pageLogicalHeightForOffset(logicalOffset);
     updateMinimumPageHeight(logicalOffset, childLogicalHeight);
+    addUnbreakableContent(logicalOffset, childLogicalHeight);
     if (!pageLogicalHeight || childLogicalHeight > pageLogicalHeight)
         return logicalOffset;
     LayoutUnit remainingLogicalHeight = pageRemainingLogicalHeightForOffset(logicalOffset, ExcludePageBoundary);
@@ -1041,6 +1047,17 @@ void RenderBlockFlow::layoutBlockChildren(bool relayoutChildren, SubtreeLayoutSc
     RenderBox* next = firstChildBox();
     RenderBox* lastNormalFlowChild = 0;
 
+    // Children far away from the viewport may be given an estimated height instead of
+    // being laid out. See deferBlockChildLayout().
+    LayoutUnit deferredLayoutWindowTop;
+    LayoutUnit deferredLayoutWindowBottom;
+    LayoutUnit viewportLogicalTop;
+    bool canDeferLayout = canDeferChildLayout() && deferredLayoutWindow(deferredLayoutWindowTop, deferredLayoutWindowBottom, viewportLogicalTop);
+    bool hasDeferredLayoutChildren = false;
+    LayoutUnit laidOutChildrenLogicalHeight;
+    unsigned laidOutChildCount = 0;
+    LayoutUnit scrollAnchorAdjustment;
+
     while (next) {
         RenderBox* child = next;
         next = child->nextSiblingBox();
@@ -1064,16 +1081,167 @@ void RenderBlockFlow::layoutBlockChildren(bool relayoutChildren, SubtreeLayoutSc
             continue;
         }
 
+        if (canDeferLayout && child->needsLayout() && child->isRenderBlockFlow() && !toRenderBlock(child)->isLayoutDeferralForbidden() && !child->hasLayer()
+            && child->style()->clear() == CNONE && !marginInfo.atBeforeSideOfBlock() && !containsFloats()) {
+            LayoutUnit estimatedLogicalHeight;
+            if (child->everHadLayout() || child->isLayoutDeferred())
+                estimatedLogicalHeight = logicalHeightForChild(child);
+            else if (laidOutChildCount)
+                estimatedLogicalHeight = laidOutChildrenLogicalHeight / laidOutChildCount;
+            else
+                estimatedLogicalHeight = child->style()->computedLineHeight();
+
+            if (logicalHeight() >= deferredLayoutWindowBottom || logicalHeight() + estimatedLogicalHeight <= deferredLayoutWindowTop) {
+                deferBlockChildLayout(child, marginInfo, estimatedLogicalHeight);
+                hasDeferredLayoutChildren = true;
+                lastNormalFlowChild = child;
+                continue;
+            }
+        }
+
+        bool wasLayoutDeferred = child->isLayoutDeferred();
+        LayoutUnit estimatedLogicalBottom = logicalTopForChild(child) + logicalHeightForChild(child);
+        LayoutUnit estimatedLogicalHeight = logicalHeightForChild(child);
+
         // Lay out the child.
         layoutBlockChild(child, marginInfo, previousFloatLogicalBottom);
         lastNormalFlowChild = child;
+
+        if (wasLayoutDeferred) {
+            toRenderBlock(child)->setLayoutDeferred(false);
+            toRenderBlock(child)->setLayoutDeferralForbidden(false);
+            // Keep the content in the viewport in place when a child above it turns
+            // out to be taller or shorter than estimated.
+            if (estimatedLogicalBottom <= viewportLogicalTop)
+                scrollAnchorAdjustment += logicalHeightForChild(child) - estimatedLogicalHeight;
+        }
+        laidOutChildrenLogicalHeight += logicalHeightForChild(child);
+        ++laidOutChildCount;
     }
 
+    setHasDeferredLayoutChildren(hasDeferredLayoutChildren);
+    if (scrollAnchorAdjustment)
+        frameView()->addPendingScrollAnchorAdjustment(IntSize(0, scrollAnchorAdjustment.round()));
+
     // Now do the handling of the bottom of the block, adding in our bottom border/padding and
     // determining the correct collapsed bottom margin information.
     handleAfterSideOfBlock(lastNormalFlowChild, beforeEdge, afterEdge, marginInfo);
 }
 
+bool RenderBlockFlow::canDeferChildLayout() const
+{
+    if (!RuntimeEnabledFeatures::virtualizedBlockLayoutEnabled())
+        return false;
+
+    // The estimated positions are only kept in sync with the frame's scroll position, in
+    // the horizontal-tb block direction and without pagination.
+    if (!isHorizontalWritingMode() || style()->isFlippedBlocksWritingMode() || view()->layoutState()->isPaginated())
+        return false;
+
+    // Descendant layers are painted by the enclosing layer rather than by our child walk.
+    if (enclosingLayer()->firstChild())
+        return false;
+
+    for (const RenderObject* ancestor = this; ancestor && !ancestor->isRenderView(); ancestor = ancestor->container()) {
+        if (ancestor->hasOverflowClip() || ancestor->hasTransform())
+            return false;
+    }
+
+    unsigned childCount = 0;
+    for (RenderObject* child = firstChild(); child; child = child->nextSibling()) {
+        if (++childCount >= minimumChildCountForDeferredLayout)
+            return true;
+    }
+    return false;
+}
+
+static void deferredLayoutWindowForViewport(const IntRect& visibleContentRect, LayoutUnit blockLogicalTop, LayoutUnit& windowLogicalTop, LayoutUnit& windowLogicalBottom)
+{
+    // Keep a viewport's worth of laid out content on each side so that scrolling
+    // by a page never reveals estimated content before the next layout.
+    LayoutUnit viewportLogicalTop = visibleContentRect.y() - blockLogicalTop;
+    LayoutUnit viewportLogicalHeight = visibleContentRect.height();
+    windowLogicalTop = viewportLogicalTop - viewportLogicalHeight;
+    windowLogicalBottom = viewportLogicalTop + 2 * viewportLogicalHeight;
+}
+
+bool RenderBlockFlow::deferredLayoutWindow(LayoutUnit& windowLogicalTop, LayoutUnit& windowLogicalBottom, LayoutUnit& viewportLogicalTop) const
+{
+    FrameView* frameView = this->frameView();
+    if (!frameView)
+        return false;
+
+    IntRect visibleContentRect = frameView->visibleContentRect();
+    LayoutUnit blockLogicalTop = view()->layoutState()->layoutOffset().height();
+    deferredLayoutWindowForViewport(visibleContentRect, blockLogicalTop, windowLogicalTop, windowLogicalBottom);
+    viewportLogicalTop = visibleContentRect.y() - blockLogicalTop;
+    return true;
+}
+
+void RenderBlockFlow::deferBlockChildLayout(RenderBox* child, MarginInfo& marginInfo, LayoutUnit estimatedLogicalHeight)
+{
+    ASSERT(child->isRenderBlockFlow() && child->needsLayout());
+
+    // Place the child as a box of the estimated height. Its dirty bits stay set, so
+    // it gets laid out for real once it comes close to the viewport.
+    child->computeAndSetBlockDirectionMargins(this);
+    child->updateLogicalWidth();
+    child->setLogicalHeight(estimatedLogicalHeight);
+    child->clearAllOverflows();
+
+    setLogicalTopForChild(child, collapseMargins(child, marginInfo, false));
+    determineLogicalLeftPositionForChild(child);
+    setLogicalHeight(logicalHeight() + logicalHeightForChild(child));
+
+    toRenderBlock(child)->setLayoutDeferred(true);
+}
+
+void RenderBlockFlow::setHasDeferredLayoutChildren(bool hasDeferredLayoutChildren)
+{
+    if (m_hasDeferredLayoutChildren == hasDeferredLayoutChildren)
+        return;
+    m_hasDeferredLayoutChildren = hasDeferredLayoutChildren;
+
+    FrameView* frameView = this->frameView();
+    if (!frameView)
+        return;
+    if (hasDeferredLayoutChildren)
+        frameView->addBlockWithDeferredLayoutChildren(this);
+    else
+        frameView->removeBlockWithDeferredLayoutChildren(this);
+}
+
+void RenderBlockFlow::markDeferredChildrenNearViewportForLayout(const IntRect& visibleContentRect)
+{
+    ASSERT(m_hasDeferredLayoutChildren);
+
+    LayoutUnit windowLogicalTop;
+    LayoutUnit windowLogicalBottom;
+    deferredLayoutWindowForViewport(visibleContentRect, localToAbsolute().y(), windowLogicalTop, windowLogicalBottom);
+
+    for (RenderBox* child = firstChildBox(); child; child = child->nextSiblingBox()) {
+        if (!child->isLayoutDeferred())
+            continue;
+        LayoutUnit childLogicalTop = logicalTopForChild(child);
+        if (childLogicalTop >= windowLogicalBottom)
+            break;
+        if (childLogicalTop + logicalHeightForChild(child) > windowLogicalTop)
+            child->markContainingBlocksForLayout();
+    }
+}
+
+void RenderBlockFlow::willBeRemovedFromTree()
+{
+    setHasDeferredLayoutChildren(false);
+    RenderBlock::willBeRemovedFromTree();
+}
+
+void RenderBlockFlow::willBeDestroyed()
+{
+    setHasDeferredLayoutChildren(false);
+    RenderBlock::willBeDestroyed();
+}
+
 // Our MarginInfo state used when laying out block children.
 MarginInfo::MarginInfo(RenderBlockFlow* blockFlow, LayoutUnit beforeBorderPadding, LayoutUnit afterBorderPadding)
     : m_canCollapseMarginAfterWithLastChild(true)
@@ -64,6 +64,10 @@ public:
 
     virtual void deleteLineBoxTree() OVERRIDE FINAL;
 
+    // Marks the children whose layout was deferred by layoutBlockChildren and that are
+    // now close to the given visible content rect for layout. Called when the frame scrolls.
+    void markDeferredChildrenNearViewportForLayout(const IntRect& visibleContentRect);
+
     LayoutUnit availableLogicalWidthForLine(LayoutUnit position, bool shouldIndentText, LayoutUnit logicalHeight = 0) const
     {
         return max<LayoutUnit>(0, logicalRightOffsetForLine(position, shouldIndentText, logicalHeight) - logicalLeftOffsetForLine(position, shouldIndentText, logicalHeight));
@@ -213,6 +217,9 @@ protected:
     virtual void styleWillChange(StyleDifference, const RenderStyle& newStyle) OVERRIDE;
     virtual void styleDidChange(StyleDifference, const RenderStyle* oldStyle) OVERRIDE;
 
+    virtual void willBeDestroyed() OVERRIDE;
+    virtual void willBeRemovedFromTree() OVERRIDE;
+
     void addOverflowFromFloats();
 
     LayoutUnit logicalRightOffsetForLine(LayoutUnit logicalTop, LayoutUnit fixedOffset, bool applyTextIndent, LayoutUnit logicalHeight = 0) const
@@ -236,6 +243,11 @@ private:
     void layoutBlockChildren(bool relayoutChildren, SubtreeLayoutScope&, LayoutUnit beforeEdge, LayoutUnit afterEdge);
 
     void layoutBlockChild(RenderBox* child, MarginInfo&, LayoutUnit& previousFloatLogicalBottom);
+
+    bool canDeferChildLayout() const;
+    bool deferredLayoutWindow(LayoutUnit& windowLogicalTop, LayoutUnit& windowLogicalBottom, LayoutUnit& viewportLogicalTop) const;
+    void deferBlockChildLayout(RenderBox* child, MarginInfo&, LayoutUnit estimatedLogicalHeight);
+    void setHasDeferredLayoutChildren(bool);
     void adjustPositionedBlock(RenderBox* child, const MarginInfo&);
     void adjustFloatingBlock(const MarginInfo&);
 
@@ -0,0 +1,120 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+
+#include "core/rendering/RenderingTestHelper.h"
+#include "core/rendering/HitTestRequest.h"
+#include "core/rendering/HitTestResult.h"
+#include "core/rendering/RenderBlockFlow.h"
+#include "core/rendering/RenderView.h"
+#include "platform/RuntimeEnabledFeatures.h"
+#include "wtf/text/StringBuilder.h"
+
+namespace blink {
+
+namespace {
+
+class RenderBlockFlowTest : public RenderingTest {
+protected:
+    virtual void SetUp()
+    {
+        RenderingTest::SetUp();
+        m_virtualizedBlockLayoutEnabled = RuntimeEnabledFeatures::virtualizedBlockLayoutEnabled();
+        RuntimeEnabledFeatures::setVirtualizedBlockLayoutEnabled(true);
+    }
+
+    virtual void TearDown()
+    {
+        RuntimeEnabledFeatures::setVirtualizedBlockLayoutEnabled(m_virtualizedBlockLayoutEnabled);
+    }
+
+    // A list of 20px tall rows, 40000px in total.
+    RenderBlockFlow* setUpLongList()
+    {
+        StringBuilder html;
+        html.appendLiteral("<div id='list'>");
+        for (unsigned i = 0; i < 2000; ++i)
+            html.appendLiteral("<div style='height: 20px'>Row</div>");
+        html.appendLiteral("</div>");
+        document().body()->setInnerHTML(html.toString(), ASSERT_NO_EXCEPTION);
+        document().view()->updateLayoutAndStyleIfNeededRecursive();
+        return toRenderBlockFlow(document().getElementById("list")->renderer());
+    }
+
+private:
+    bool m_virtualizedBlockLayoutEnabled;
+};
+
+TEST_F(RenderBlockFlowTest, ChildrenFarFromViewportAreDeferred)
+{
+    RenderBlockFlow* list = setUpLongList();
+
+    EXPECT_FALSE(list->firstChildBox()->isLayoutDeferred());
+    EXPECT_TRUE(list->lastChildBox()->isLayoutDeferred());
+    EXPECT_TRUE(list->lastChildBox()->needsLayout());
+    EXPECT_EQ(LayoutUnit(40000), list->logicalHeight());
+}
+
+TEST_F(RenderBlockFlowTest, ScrollingLaysOutDeferredChildren)
+{
+    RenderBlockFlow* list = setUpLongList();
+    ASSERT_TRUE(list->lastChildBox()->isLayoutDeferred());
+
+    document().view()->setScrollPosition(IntPoint(0, 40000));
+    document().view()->updateLayoutAndStyleIfNeededRecursive();
+
+    EXPECT_FALSE(list->lastChildBox()->isLayoutDeferred());
+    EXPECT_FALSE(list->lastChildBox()->needsLayout());
+    EXPECT_EQ(LayoutUnit(40000), list->logicalHeight());
+}
+
+TEST_F(RenderBlockFlowTest, GeometryQueryLaysOutDeferredChild)
+{
+    RenderBlockFlow* list = setUpLongList();
+    RenderBox* lastRow = list->lastChildBox();
+    ASSERT_TRUE(lastRow->isLayoutDeferred());
+
+    EXPECT_EQ(20, toElement(lastRow->node())->offsetHeight());
+    EXPECT_FALSE(lastRow->isLayoutDeferred());
+    EXPECT_FALSE(lastRow->needsLayout());
+}
+
+TEST_F(RenderBlockFlowTest, HitTestLaysOutDeferredChild)
+{
+    RenderBlockFlow* list = setUpLongList();
+    RenderBox* lastRow = list->lastChildBox();
+    ASSERT_TRUE(lastRow->isLayoutDeferred());
+
+    // Right of the row's text, inside its last 20px.
+    LayoutPoint location(500, list->absoluteBoundingBoxRect().maxY() - 10);
+    HitTestRequest request(HitTestRequest::ReadOnly | HitTestRequest::Active | HitTestRequest::IgnoreClipping);
+    HitTestResult result(location);
+    document().renderView()->hitTest(request, result);
+
+    EXPECT_FALSE(lastRow->isLayoutDeferred());
+    EXPECT_EQ(lastRow->node(), result.innerNode());
+}
+
+TEST_F(RenderBlockFlowTest, ShortListsAreNotDeferred)
+{
+    setBodyInnerHTML("<div id='list'><div style='height: 2000px'></div><div>Far away</div></div>");
+    RenderBlockFlow* list = toRenderBlockFlow(document().getElementById("list")->renderer());
+
+    EXPECT_FALSE(list->lastChildBox()->isLayoutDeferred());
+}
+
+TEST_F(RenderBlockFlowTest, LineBoxBytesGrowWithLines)
+{
+    setBodyInnerHTML("<div style='width: 100px'>one</div>");
+    size_t oneLineBytes = document().renderView()->lineBoxBytes();
+    EXPECT_GT(oneLineBytes, 0u);
+
+    setBodyInnerHTML("<div style='width: 100px'>one two three four five six seven eight nine ten</div>");
+    EXPECT_GT(document().renderView()->lineBoxBytes(), oneLineBytes);
+}
+
+} // namespace
+
+} // namespace blink
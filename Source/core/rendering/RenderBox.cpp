@@ -1013,6 +1013,51 @@ void RenderBox::clearOverrideContainingBlockContentLogicalHeight()
         gOverrideContainingBlockLogicalHeightMap->remove(this);
 }
 
+bool RenderBox::computeMeasurementConstraints(RenderBoxMeasurementConstraints& constraints) const
+{
+    // A percentage height resolves against the height of the containing block,
+    // which only counts as a constraint when a container overrides it.
+    if (hasRelativeLogicalHeight() && !hasOverrideContainingBlockLogicalHeight())
+        return false;
+
+    constraints.m_availableLogicalWidth = containingBlockLogicalWidthForContent();
+    RenderBlock* cb = containingBlock();
+    constraints.m_perpendicularContainingBlockLogicalHeight = cb && cb->isHorizontalWritingMode() != isHorizontalWritingMode() ? perpendicularContainingBlockLogicalHeight() : LayoutUnit(-1);
+    constraints.m_percentageResolutionLogicalHeight = hasOverrideContainingBlockLogicalHeight() ? overrideContainingBlockContentLogicalHeight() : LayoutUnit(-1);
+    constraints.m_overrideLogicalContentWidth = hasOverrideWidth() ? overrideLogicalContentWidth() : LayoutUnit(-1);
+    constraints.m_overrideLogicalContentHeight = hasOverrideHeight() ? overrideLogicalContentHeight() : LayoutUnit(-1);
+    return true;
+}
+
+bool RenderBox::measuredLogicalHeight(LayoutUnit& logicalHeight) const
+{
+    if (!m_rareData || m_rareData->m_measuredLogicalHeight == -1)
+        return false;
+
+    RenderBoxMeasurementConstraints constraints;
+    if (!computeMeasurementConstraints(constraints) || !(constraints == m_rareData->m_measurementConstraints))
+        return false;
+
+    logicalHeight = m_rareData->m_measuredLogicalHeight;
+    return true;
+}
+
+void RenderBox::setMeasuredLogicalHeight(LayoutUnit logicalHeight)
+{
+    ASSERT(!needsLayout());
+    ASSERT(logicalHeight >= 0);
+
+    RenderBoxMeasurementConstraints constraints;
+    if (!computeMeasurementConstraints(constraints)) {
+        clearMeasuredLogicalHeight();
+        return;
+    }
+
+    RenderBoxRareData& rareData = ensureRareData();
+    rareData.m_measuredLogicalHeight = logicalHeight;
+    rareData.m_measurementConstraints = constraints;
+}
+
 LayoutUnit RenderBox::adjustBorderBoxLogicalWidthForBoxSizing(LayoutUnit width) const
 {
     LayoutUnit bordersPlusPadding = borderAndPaddingLogicalWidth();
@@ -46,6 +46,36 @@ enum ScrollOffsetClamping {
     ScrollOffsetClamped
 };
 
+// The sizes a box is laid out against which come from outside the box. Two
+// layouts of an unchanged box under the same constraints give the same size.
+struct RenderBoxMeasurementConstraints {
+    RenderBoxMeasurementConstraints()
+        : m_availableLogicalWidth(-1)
+        , m_perpendicularContainingBlockLogicalHeight(-1)
+        , m_percentageResolutionLogicalHeight(-1)
+        , m_overrideLogicalContentWidth(-1)
+        , m_overrideLogicalContentHeight(-1)
+    {
+    }
+
+    bool operator==(const RenderBoxMeasurementConstraints& o) const
+    {
+        return m_availableLogicalWidth == o.m_availableLogicalWidth
+            && m_perpendicularContainingBlockLogicalHeight == o.m_perpendicularContainingBlockLogicalHeight
+            && m_percentageResolutionLogicalHeight == o.m_percentageResolutionLogicalHeight
+            && m_overrideLogicalContentWidth == o.m_overrideLogicalContentWidth
+            && m_overrideLogicalContentHeight == o.m_overrideLogicalContentHeight;
+    }
+
+    LayoutUnit m_availableLogicalWidth;
+    // What the logical width of a box in an orthogonal writing mode is
+    // resolved against, -1 for boxes in the writing mode of their container.
+    LayoutUnit m_perpendicularContainingBlockLogicalHeight;
+    LayoutUnit m_percentageResolutionLogicalHeight;
+    LayoutUnit m_overrideLogicalContentWidth;
+    LayoutUnit m_overrideLogicalContentHeight;
+};
+
 struct RenderBoxRareData {
     WTF_MAKE_NONCOPYABLE(RenderBoxRareData); WTF_MAKE_FAST_ALLOCATED;
 public:
@@ -54,6 +84,7 @@ public:
         , m_overrideLogicalContentHeight(-1)
         , m_overrideLogicalContentWidth(-1)
         , m_previousBorderBoxSize(-1, -1)
+        , m_measuredLogicalHeight(-1)
     {
     }
 
@@ -65,6 +96,10 @@ public:
 
     // Set by RenderBox::updatePreviousBorderBoxSizeIfNeeded().
     LayoutSize m_previousBorderBoxSize;
+
+    // Set by RenderBox::setMeasuredLogicalHeight(), -1 when there is none.
+    LayoutUnit m_measuredLogicalHeight;
+    RenderBoxMeasurementConstraints m_measurementConstraints;
 };
 
 class RenderBox : public RenderBoxModelObject {
@@ -364,6 +399,18 @@ public:
     void clearContainingBlockOverrideSize();
     void clearOverrideContainingBlockContentLogicalHeight();
 
+    // Flexbox and grid lay their children out just to measure their logical
+    // height, often again and again under the same constraints. The height
+    // measured last is kept, together with the constraints it was measured
+    // under, until the box or anything inside it needs layout again.
+    bool measuredLogicalHeight(LayoutUnit&) const;
+    void setMeasuredLogicalHeight(LayoutUnit);
+    void clearMeasuredLogicalHeight()
+    {
+        if (m_rareData)
+            m_rareData->m_measuredLogicalHeight = -1;
+    }
+
     virtual LayoutSize offsetFromContainer(const RenderObject*, const LayoutPoint&, bool* offsetDependsOnPoint = 0) const OVERRIDE;
 
     LayoutUnit adjustBorderBoxLogicalWidthForBoxSizing(LayoutUnit width) const;
@@ -712,6 +759,8 @@ private:
 
     bool logicalHeightComputesAsNone(SizeType) const;
 
+    bool computeMeasurementConstraints(RenderBoxMeasurementConstraints&) const;
+
     virtual InvalidationReason invalidatePaintIfNeeded(const PaintInvalidationState&, const RenderLayerModelObject& newPaintInvalidationContainer) OVERRIDE FINAL;
 
     bool isBox() const WTF_DELETED_FUNCTION; // This will catch anyone doing an unnecessary check.
@@ -0,0 +1,89 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+
+#include "core/rendering/RenderingTestHelper.h"
+#include "core/rendering/RenderBox.h"
+
+namespace blink {
+
+namespace {
+
+class RenderBoxTest : public RenderingTest {
+protected:
+    RenderBox* target()
+    {
+        return toRenderBox(document().getElementById("target")->renderer());
+    }
+};
+
+TEST_F(RenderBoxTest, MeasuredLogicalHeightDependsOnConstraints)
+{
+    setBodyInnerHTML("<div id='target' style='width: 100px'>Some text</div>");
+    RenderBox* box = target();
+
+    LayoutUnit height;
+    EXPECT_FALSE(box->measuredLogicalHeight(height));
+    box->setMeasuredLogicalHeight(box->logicalHeight());
+    EXPECT_TRUE(box->measuredLogicalHeight(height));
+    EXPECT_EQ(box->logicalHeight(), height);
+
+    box->setOverrideLogicalContentWidth(50);
+    EXPECT_FALSE(box->measuredLogicalHeight(height));
+    box->clearOverrideSize();
+    EXPECT_TRUE(box->measuredLogicalHeight(height));
+
+    box->setOverrideContainingBlockContentLogicalWidth(200);
+    EXPECT_FALSE(box->measuredLogicalHeight(height));
+    box->clearContainingBlockOverrideSize();
+    EXPECT_TRUE(box->measuredLogicalHeight(height));
+}
+
+TEST_F(RenderBoxTest, MeasuredLogicalHeightOfOrthogonalBox)
+{
+    setBodyInnerHTML("<div id='container' style='height: 100px'><div id='target' style='-webkit-writing-mode: vertical-lr'>Some text</div></div>");
+    RenderBox* box = target();
+    RenderBox* container = toRenderBox(document().getElementById("container")->renderer());
+
+    // The logical width of the box comes from the height of its container.
+    LayoutUnit height;
+    box->setMeasuredLogicalHeight(box->logicalHeight());
+    EXPECT_TRUE(box->measuredLogicalHeight(height));
+
+    container->setOverrideLogicalContentHeight(50);
+    EXPECT_FALSE(box->measuredLogicalHeight(height));
+    container->clearOverrideSize();
+    EXPECT_TRUE(box->measuredLogicalHeight(height));
+}
+
+TEST_F(RenderBoxTest, MeasuredLogicalHeightClearedByChildNeedingLayout)
+{
+    setBodyInnerHTML("<div id='target'><div>Some text</div></div>");
+    RenderBox* box = target();
+
+    box->setMeasuredLogicalHeight(box->logicalHeight());
+    box->slowFirstChild()->setNeedsLayout();
+    LayoutUnit height;
+    EXPECT_FALSE(box->measuredLogicalHeight(height));
+}
+
+TEST_F(RenderBoxTest, PercentageHeightIsNotMeasuredWithoutResolutionHeight)
+{
+    setBodyInnerHTML("<div id='target' style='height: 50%'></div>");
+    RenderBox* box = target();
+
+    LayoutUnit height;
+    box->setMeasuredLogicalHeight(box->logicalHeight());
+    EXPECT_FALSE(box->measuredLogicalHeight(height));
+
+    box->setOverrideContainingBlockContentLogicalHeight(-1);
+    box->setMeasuredLogicalHeight(box->logicalHeight());
+    EXPECT_TRUE(box->measuredLogicalHeight(height));
+    box->clearContainingBlockOverrideSize();
+}
+
+} // namespace
+
+} // namespace blink
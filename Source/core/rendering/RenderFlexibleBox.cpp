@@ -620,8 +620,15 @@ LayoutUnit RenderFlexibleBox::preferredMainAxisContentExtentForChild(RenderBox&
         if (hasOrthogonalFlow(child)) {
             if (child.needsLayout() || relayoutChildren) {
                 m_intrinsicSizeAlongMainAxis.remove(&child);
-                child.forceChildLayout();
-                m_intrinsicSizeAlongMainAxis.set(&child, child.logicalHeight());
+                // Nested column flexboxes would otherwise lay out each level
+                // twice for every layout of the level above it.
+                LayoutUnit measuredLogicalHeight;
+                if (!child.measuredLogicalHeight(measuredLogicalHeight)) {
+                    child.forceChildLayout();
+                    measuredLogicalHeight = child.logicalHeight();
+                    child.setMeasuredLogicalHeight(measuredLogicalHeight);
+                }
+                m_intrinsicSizeAlongMainAxis.set(&child, measuredLogicalHeight);
             }
             ASSERT(m_intrinsicSizeAlongMainAxis.contains(&child));
             mainAxisExtent = m_intrinsicSizeAlongMainAxis.get(&child);
@@ -1098,7 +1105,8 @@ void RenderFlexibleBox::layoutAndPlaceChildren(LayoutUnit& crossAxisOffset, cons
             // To avoid double applying margin changes in updateAutoMarginsInCrossAxis, we reset the margins here.
             resetAutoMarginsAndLogicalTopInCrossAxis(*child);
         }
-        // We may have already forced relayout for orthogonal flowing children in preferredMainAxisContentExtentForChild.
+        // We may have already forced relayout for orthogonal flowing children in preferredMainAxisContentExtentForChild,
+        // or found they didn't need it because they were measured under the same constraints before.
         bool forceChildRelayout = relayoutChildren && !childPreferredMainAxisContentExtentRequiresLayout(*child, hasInfiniteLineLength);
         updateBlockChildDirtyBitsBeforeLayout(forceChildRelayout, child);
         child->layoutIfNeeded();
@@ -87,6 +87,7 @@ public:
 
     virtual void setPageBreak(LayoutUnit /*offset*/, LayoutUnit /*spaceShortage*/) { }
     virtual void updateMinimumPageHeight(LayoutUnit /*offset*/, LayoutUnit /*minHeight*/) { }
+    virtual void addUnbreakableContent(LayoutUnit /*offset*/, LayoutUnit /*logicalHeight*/) { }
 
     bool regionsHaveUniformLogicalHeight() const { return m_regionsHaveUniformLogicalHeight; }
 
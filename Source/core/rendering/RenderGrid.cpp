@@ -617,15 +617,25 @@ LayoutUnit RenderGrid::logicalHeightForChild(RenderBox& child, Vector<GridTrack>
     SubtreeLayoutScope layoutScope(child);
     LayoutUnit oldOverrideContainingBlockContentLogicalWidth = child.hasOverrideContainingBlockLogicalWidth() ? child.overrideContainingBlockContentLogicalWidth() : LayoutUnit();
     LayoutUnit overrideContainingBlockContentLogicalWidth = gridAreaBreadthForChild(child, ForColumns, columnTracks);
-    if (child.style()->logicalHeight().isPercent() || oldOverrideContainingBlockContentLogicalWidth != overrideContainingBlockContentLogicalWidth)
-        layoutScope.setNeedsLayout(&child);
+    bool needsLayout = child.style()->logicalHeight().isPercent() || oldOverrideContainingBlockContentLogicalWidth != overrideContainingBlockContentLogicalWidth;
 
     child.setOverrideContainingBlockContentLogicalWidth(overrideContainingBlockContentLogicalWidth);
     // If |child| has a percentage logical height, we shouldn't let it override its intrinsic height, which is
     // what we are interested in here. Thus we need to set the override logical height to -1 (no possible resolution).
     child.setOverrideContainingBlockContentLogicalHeight(-1);
-    child.layoutIfNeeded();
-    return child.logicalHeight() + child.marginLogicalHeight();
+
+    // Both the min-content and the max-content contributions of a row are
+    // the height of the child laid out in its column, and neither changes
+    // between layouts of the grid unless the child or its column does.
+    LayoutUnit measuredLogicalHeight;
+    if (!child.measuredLogicalHeight(measuredLogicalHeight)) {
+        if (needsLayout)
+            layoutScope.setNeedsLayout(&child);
+        child.layoutIfNeeded();
+        measuredLogicalHeight = child.logicalHeight();
+        child.setMeasuredLogicalHeight(measuredLogicalHeight);
+    }
+    return measuredLogicalHeight + child.marginLogicalHeight();
 }
 
 LayoutUnit RenderGrid::minContentForChild(RenderBox& child, GridTrackSizingDirection direction, Vector<GridTrack>& columnTracks)
@@ -71,6 +71,7 @@
 #include "core/rendering/RenderTreeAsText.h"
 #include "core/rendering/RenderView.h"
 #include "core/rendering/compositing/CompositedLayerMapping.h"
+#include "core/rendering/compositing/CompositingRequirementsUpdater.h"
 #include "core/rendering/compositing/RenderLayerCompositor.h"
 #include "core/rendering/svg/ReferenceFilterBuilder.h"
 #include "core/rendering/svg/RenderSVGResourceClipper.h"
@@ -121,6 +122,7 @@ RenderLayer::RenderLayer(RenderLayerModelObject* renderer, LayerType type)
     , m_needsAncestorDependentCompositingInputsUpdate(true)
     , m_needsDescendantDependentCompositingInputsUpdate(true)
     , m_childNeedsCompositingInputsUpdate(true)
+    , m_needsCompositingRequirementsUpdate(true)
     , m_hasCompositingDescendant(false)
     , m_hasNonCompositedChild(false)
     , m_shouldIsolateCompositedDescendants(false)
@@ -1020,6 +1022,26 @@ void RenderLayer::didUpdateCompositingInputs()
         m_scrollableArea->updateNeedsCompositedScrolling();
 }
 
+void RenderLayer::setNeedsCompositingRequirementsUpdate()
+{
+    for (RenderLayer* current = this; current && !current->m_needsCompositingRequirementsUpdate; current = current->parent())
+        current->m_needsCompositingRequirementsUpdate = true;
+}
+
+void RenderLayer::clearNeedsCompositingRequirementsUpdate()
+{
+    if (!m_needsCompositingRequirementsUpdate)
+        return;
+    m_needsCompositingRequirementsUpdate = false;
+    for (RenderLayer* child = firstChild(); child; child = child->nextSibling())
+        child->clearNeedsCompositingRequirementsUpdate();
+}
+
+void RenderLayer::setCompositedSubtreeRequirements(PassOwnPtr<CompositedSubtreeRequirements> requirements)
+{
+    m_compositedSubtreeRequirements = requirements;
+}
+
 void RenderLayer::setCompositingReasons(CompositingReasons reasons, CompositingReasons mask)
 {
     if ((compositingReasons() & mask) == (reasons & mask))
@@ -1273,6 +1295,8 @@ RenderLayer* RenderLayer::removeChild(RenderLayer* oldChild)
     oldChild->setNextSibling(0);
     oldChild->m_parent = 0;
 
+    setNeedsCompositingRequirementsUpdate();
+
     dirtyAncestorChainHasSelfPaintingLayerDescendantStatus();
 
     oldChild->updateDescendantDependentFlags();
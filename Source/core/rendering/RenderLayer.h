@@ -66,6 +66,7 @@ class HitTestRequest;
 class HitTestResult;
 class HitTestingTransformState;
 class CompositedLayerMapping;
+class CompositedSubtreeRequirements;
 class RenderLayerCompositor;
 class RenderStyle;
 class TransformationMatrix;
@@ -478,6 +479,15 @@ public:
     void updateDescendantDependentCompositingInputs(const DescendantDependentCompositingInputs&);
     void didUpdateCompositingInputs();
 
+    // Set when this layer or one of its descendants changed in a way that can
+    // alter the compositing requirements of the subtree.
+    void setNeedsCompositingRequirementsUpdate();
+    bool needsCompositingRequirementsUpdate() const { return m_needsCompositingRequirementsUpdate; }
+    void clearNeedsCompositingRequirementsUpdate();
+
+    CompositedSubtreeRequirements* compositedSubtreeRequirements() const { return m_compositedSubtreeRequirements.get(); }
+    void setCompositedSubtreeRequirements(PassOwnPtr<CompositedSubtreeRequirements>);
+
     const AncestorDependentCompositingInputs& ancestorDependentCompositingInputs() const { ASSERT(!m_needsAncestorDependentCompositingInputsUpdate); return m_ancestorDependentCompositingInputs; }
     const DescendantDependentCompositingInputs& descendantDependentCompositingInputs() const { ASSERT(!m_needsDescendantDependentCompositingInputsUpdate); return m_descendantDependentCompositingInputs; }
 
@@ -682,6 +692,7 @@ private:
     unsigned m_needsAncestorDependentCompositingInputsUpdate : 1;
     unsigned m_needsDescendantDependentCompositingInputsUpdate : 1;
     unsigned m_childNeedsCompositingInputsUpdate : 1;
+    unsigned m_needsCompositingRequirementsUpdate : 1;
 
     // Used only while determining what layers should be composited. Applies to the tree of z-order lists.
     unsigned m_hasCompositingDescendant : 1;
@@ -728,6 +739,7 @@ private:
 
     OwnPtr<CompositedLayerMapping> m_compositedLayerMapping;
     OwnPtr<RenderLayerScrollableArea> m_scrollableArea;
+    OwnPtr<CompositedSubtreeRequirements> m_compositedSubtreeRequirements;
 
     CompositedLayerMapping* m_groupedMapping;
 
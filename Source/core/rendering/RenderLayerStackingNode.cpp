@@ -109,8 +109,10 @@ void RenderLayerStackingNode::dirtyZOrderLists()
         m_negZOrderList->clear();
     m_zOrderListsDirty = true;
 
-    if (!renderer()->documentBeingDestroyed())
+    if (!renderer()->documentBeingDestroyed()) {
+        layer()->setNeedsCompositingRequirementsUpdate();
         compositor()->setNeedsCompositingUpdate(CompositingUpdateRebuildTree);
+    }
 }
 
 void RenderLayerStackingNode::dirtyStackingContextZOrderLists()
@@ -131,8 +133,10 @@ void RenderLayerStackingNode::dirtyNormalFlowList()
         m_normalFlowList->clear();
     m_normalFlowListDirty = true;
 
-    if (!renderer()->documentBeingDestroyed())
+    if (!renderer()->documentBeingDestroyed()) {
+        layer()->setNeedsCompositingRequirementsUpdate();
         compositor()->setNeedsCompositingUpdate(CompositingUpdateRebuildTree);
+    }
 }
 
 void RenderLayerStackingNode::rebuildZOrderLists()
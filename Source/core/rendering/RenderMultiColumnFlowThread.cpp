@@ -33,6 +33,7 @@ namespace blink {
 RenderMultiColumnFlowThread::RenderMultiColumnFlowThread()
     : m_columnCount(1)
     , m_columnHeightAvailable(0)
+    , m_layoutPassCount(0)
     , m_inBalancingPass(false)
     , m_needsColumnHeightsRecalculation(false)
     , m_progressionIsInline(true)
@@ -169,6 +170,10 @@ void RenderMultiColumnFlowThread::layoutColumns(bool relayoutChildren, SubtreeLa
         }
     }
 
+    if (!m_inBalancingPass)
+        m_layoutPassCount = 0;
+    m_layoutPassCount++;
+
     invalidateRegions();
     m_needsColumnHeightsRecalculation = heightIsAuto();
     layout();
@@ -296,6 +301,12 @@ void RenderMultiColumnFlowThread::updateMinimumPageHeight(LayoutUnit offset, Lay
         multicolSet->updateMinimumColumnHeight(minHeight);
 }
 
+void RenderMultiColumnFlowThread::addUnbreakableContent(LayoutUnit offset, LayoutUnit logicalHeight)
+{
+    if (RenderMultiColumnSet* multicolSet = columnSetAtBlockOffset(offset))
+        multicolSet->addUnbreakableContent(offset, logicalHeight);
+}
+
 RenderMultiColumnSet* RenderMultiColumnFlowThread::columnSetAtBlockOffset(LayoutUnit /*offset*/) const
 {
     // For now there's only one column set, so this is easy:
@@ -68,9 +68,12 @@ class RenderMultiColumnSet;
 // struts) when laying out the contents of the flow thread. We'll just lay out everything in tall
 // single strip. After the initial flow thread layout pass we can determine a tentative / minimal /
 // initial column height. This is calculated by simply dividing the flow thread's height by the
-// number of specified columns. In the layout pass that follows, we can insert breaks (and
-// pagination struts) at column boundaries, since we now have a column height. It may very easily
-// turn out that the calculated height wasn't enough, though. We'll notice this at end of layout. If
+// number of specified columns. Lines and unsplittable blocks are recorded during the initial pass
+// as well (see RenderMultiColumnSet::addUnbreakableContent()), so that the initial column height
+// can be stretched to make room for the breaks that can be predicted without laying out again. In
+// the layout pass that follows, we can insert breaks (and pagination struts) at column boundaries,
+// since we now have a column height. It may still turn out that the calculated height wasn't
+// enough, though. We'll notice this at end of layout. If
 // we end up with too many columns (i.e. columns overflowing the multicol container), it wasn't
 // enough. In this case we need to increase the column heights. We'll increase them by the lowest
 // amount of space that could possibly affect where the breaks occur (see
@@ -123,6 +126,10 @@ public:
 
     bool recalculateColumnHeights();
 
+    // The number of times the flow thread was laid out the last time the column heights were
+    // calculated, including the initial pass. Balancing adds passes until the heights settle.
+    unsigned layoutPassCount() const { return m_layoutPassCount; }
+
 protected:
     RenderMultiColumnFlowThread();
     void setProgressionIsInline(bool isInline) { m_progressionIsInline = isInline; }
@@ -139,12 +146,14 @@ private:
     virtual void updateLogicalWidth() OVERRIDE;
     virtual void setPageBreak(LayoutUnit offset, LayoutUnit spaceShortage) OVERRIDE;
     virtual void updateMinimumPageHeight(LayoutUnit offset, LayoutUnit minHeight) OVERRIDE;
+    virtual void addUnbreakableContent(LayoutUnit offset, LayoutUnit logicalHeight) OVERRIDE;
     virtual RenderMultiColumnSet* columnSetAtBlockOffset(LayoutUnit) const OVERRIDE;
     virtual bool addForcedRegionBreak(LayoutUnit, RenderObject* breakChild, bool isBefore, LayoutUnit* offsetBreakAdjustment = 0) OVERRIDE;
     virtual bool isPageLogicalHeightKnown() const OVERRIDE;
 
     unsigned m_columnCount; // The used value of column-count
     LayoutUnit m_columnHeightAvailable; // Total height available to columns, or 0 if auto.
+    unsigned m_layoutPassCount;
     bool m_inBalancingPass; // Set when relayouting for column balancing.
     bool m_needsColumnHeightsRecalculation; // Set when we need to recalculate the column set heights after layout.
     bool m_progressionIsInline; // Always true for regular multicol. False for paged-y overflow.
@@ -32,6 +32,7 @@
 #include "core/rendering/PaintInfo.h"
 #include "core/rendering/RenderLayer.h"
 #include "core/rendering/RenderMultiColumnFlowThread.h"
+#include <algorithm>
 
 namespace blink {
 
@@ -204,16 +205,105 @@ void RenderMultiColumnSet::addContentRun(LayoutUnit endOffsetFromFirstPage)
         m_contentRuns.append(ContentRun(endOffsetFromFirstPage));
 }
 
+void RenderMultiColumnSet::addUnbreakableContent(LayoutUnit offsetInFlowThread, LayoutUnit logicalHeight)
+{
+    // Once we have a column height, layout inserts the breaks on its own.
+    if (m_columnHeight || logicalHeight <= 0 || !multiColumnFlowThread()->heightIsAuto())
+        return;
+    m_unbreakableContent.append(UnbreakableContent(offsetInFlowThread, offsetInFlowThread + logicalHeight));
+}
+
+unsigned RenderMultiColumnSet::columnCountForUnbreakableContent(LayoutUnit columnHeight, LayoutUnit& minSpaceShortage) const
+{
+    ASSERT(columnHeight > 0);
+    minSpaceShortage = RenderFlowThread::maxLogicalHeight();
+
+    LayoutUnit setLogicalTop = logicalTopInFlowThread();
+    LayoutUnit strutsSoFar; // How far content has been pushed down by the breaks inserted so far.
+    LayoutUnit previousLogicalBottom = setLogicalTop;
+    // Every content run but the last one ends at a forced break.
+    ASSERT(!m_contentRuns.isEmpty());
+    size_t forcedBreakCount = m_contentRuns.size() - 1;
+    size_t forcedBreakIndex = 0;
+    for (size_t i = 0; i < m_unbreakableContent.size(); ++i) {
+        const UnbreakableContent& content = m_unbreakableContent[i];
+        for (; forcedBreakIndex < forcedBreakCount && m_contentRuns[forcedBreakIndex].breakOffset() <= content.logicalTop; ++forcedBreakIndex) {
+            LayoutUnit offsetInColumn = intMod(m_contentRuns[forcedBreakIndex].breakOffset() + strutsSoFar - setLogicalTop, columnHeight);
+            if (offsetInColumn)
+                strutsSoFar += columnHeight - offsetInColumn;
+        }
+
+        // Content that starts inside the previous piece of content (e.g. lines inside an
+        // unsplittable block) moves along with it.
+        if (content.logicalTop < previousLogicalBottom)
+            continue;
+
+        // Content taller than a column will be split anyway, but the content inside it may not.
+        LayoutUnit contentHeight = content.logicalBottom - content.logicalTop;
+        if (contentHeight > columnHeight)
+            continue;
+        previousLogicalBottom = content.logicalBottom;
+
+        LayoutUnit offsetInSet = content.logicalTop + strutsSoFar - setLogicalTop;
+        LayoutUnit remainingHeight = columnHeight - intMod(offsetInSet, columnHeight);
+        if (remainingHeight < contentHeight) {
+            minSpaceShortage = std::min(minSpaceShortage, contentHeight - remainingHeight);
+            strutsSoFar += remainingHeight;
+        } else if (remainingHeight == columnHeight && offsetInSet) {
+            // At the top of a column that isn't the first one. Layout reports this as a break
+            // too, since the content may be the smallest piece that didn't fit in the previous one.
+            minSpaceShortage = std::min(minSpaceShortage, contentHeight);
+        }
+    }
+
+    LayoutUnit heightInSet = logicalBottomInFlowThread() + strutsSoFar - setLogicalTop;
+    return std::max(1u, static_cast<unsigned>(ceilf(heightInSet.toFloat() / columnHeight.toFloat())));
+}
+
+LayoutUnit RenderMultiColumnSet::stretchColumnHeightForUnbreakableContent(LayoutUnit initialHeight)
+{
+    if (m_unbreakableContent.isEmpty() || initialHeight <= 0)
+        return initialHeight;
+
+    // Content is recorded in layout order, in which children of an unsplittable block come before
+    // the block itself.
+    std::sort(m_unbreakableContent.begin(), m_unbreakableContent.end(), UnbreakableContent::lessThan);
+
+    // This is the same algorithm as the one used when stretching between layout passes, except that
+    // the breaks are found by looking at the recorded content rather than by laying it out again.
+    LayoutUnit columnHeight = initialHeight;
+    while (columnHeight < m_maxColumnHeight) {
+        LayoutUnit minSpaceShortage;
+        if (columnCountForUnbreakableContent(columnHeight, minSpaceShortage) <= usedColumnCount())
+            break;
+        if (minSpaceShortage == RenderFlowThread::maxLogicalHeight())
+            break; // No breaks to stretch past. Let layout sort it out.
+        ASSERT(minSpaceShortage > 0);
+        columnHeight += minSpaceShortage;
+    }
+    return columnHeight;
+}
+
 bool RenderMultiColumnSet::recalculateColumnHeight(BalancedHeightCalculation calculationMode)
 {
     ASSERT(multiColumnFlowThread()->heightIsAuto());
 
     LayoutUnit oldColumnHeight = m_columnHeight;
+    LayoutUnit newColumnHeight;
     if (calculationMode == GuessFromFlowThreadPortion) {
+        bool hasRoomForAllForcedBreaks = m_contentRuns.size() < usedColumnCount();
         // Post-process the content runs and find out where the implicit breaks will occur.
         distributeImplicitBreaks();
+        newColumnHeight = calculateColumnHeight(calculationMode);
+        // The guess assumes that content can be broken anywhere. Account for content that cannot,
+        // so that the next layout pass is likely to be the last one. If there are more forced breaks
+        // than columns, stretching won't help, and the guess is all we're going to get.
+        if (hasRoomForAllForcedBreaks)
+            newColumnHeight = stretchColumnHeightForUnbreakableContent(newColumnHeight);
+        m_unbreakableContent.clear();
+    } else {
+        newColumnHeight = calculateColumnHeight(calculationMode);
     }
-    LayoutUnit newColumnHeight = calculateColumnHeight(calculationMode);
     setAndConstrainColumnHeight(newColumnHeight);
 
     // After having calculated an initial column height, the multicol container typically needs at
@@ -267,6 +357,7 @@ void RenderMultiColumnSet::resetColumnHeight()
     // height, and should have been deleted afterwards. We're about to rebuild the content runs, so
     // the list needs to be empty.
     ASSERT(m_contentRuns.isEmpty());
+    m_unbreakableContent.clear();
 }
 
 void RenderMultiColumnSet::expandToEncompassFlowThreadContentsIfNeeded()
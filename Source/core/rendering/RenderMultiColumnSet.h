@@ -94,6 +94,13 @@ public:
     // height.
     void addContentRun(LayoutUnit endOffsetFromFirstPage);
 
+    // Record a piece of content that may not be split across columns (a line, or an unsplittable
+    // block), specified by its offset and logical height in the flow thread. This is only done in
+    // the initial layout pass, when the column height is still unknown. The recorded content is
+    // used to calculate a column height that makes everything fit, without performing additional
+    // layout passes to find out where the breaks will end up.
+    void addUnbreakableContent(LayoutUnit offsetInFlowThread, LayoutUnit logicalHeight);
+
     // (Re-)calculate the column height if it's auto.
     bool recalculateColumnHeight(BalancedHeightCalculation);
 
@@ -172,6 +179,16 @@ private:
 
     LayoutUnit calculateColumnHeight(BalancedHeightCalculation) const;
 
+    // Figure out how many columns the recorded unbreakable content would need with the given column
+    // height, by pushing every piece of content that would otherwise straddle a column boundary to
+    // the next column, just like layout would do. Also return the smallest space shortage found at
+    // any of the column breaks.
+    unsigned columnCountForUnbreakableContent(LayoutUnit columnHeight, LayoutUnit& minSpaceShortage) const;
+
+    // Stretch the initial column height until the recorded unbreakable content fits within the used
+    // column count, if possible.
+    LayoutUnit stretchColumnHeightForUnbreakableContent(LayoutUnit initialHeight);
+
     LayoutUnit m_columnHeight;
 
     // The following variables are used when balancing the column set.
@@ -205,6 +222,26 @@ private:
         unsigned m_assumedImplicitBreaks; // Number of implicit breaks in this run assumed so far.
     };
     Vector<ContentRun, 1> m_contentRuns;
+
+    // Content that may not be split across columns, recorded during the initial layout pass. Like
+    // the content runs, this is only needed to calculate the initial column height.
+    struct UnbreakableContent {
+        UnbreakableContent(LayoutUnit logicalTop, LayoutUnit logicalBottom)
+            : logicalTop(logicalTop)
+            , logicalBottom(logicalBottom) { }
+
+        // Enclosing content goes before the content that it contains.
+        static bool lessThan(const UnbreakableContent& a, const UnbreakableContent& b)
+        {
+            if (a.logicalTop != b.logicalTop)
+                return a.logicalTop < b.logicalTop;
+            return a.logicalBottom > b.logicalBottom;
+        }
+
+        LayoutUnit logicalTop;
+        LayoutUnit logicalBottom;
+    };
+    Vector<UnbreakableContent> m_unbreakableContent;
 };
 
 DEFINE_RENDER_OBJECT_TYPE_CASTS(RenderMultiColumnSet, isRenderMultiColumnSet());
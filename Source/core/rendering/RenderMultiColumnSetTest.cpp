@@ -0,0 +1,101 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+
+#include "core/frame/Settings.h"
+#include "core/rendering/RenderingTestHelper.h"
+#include "core/rendering/RenderBlockFlow.h"
+#include "core/rendering/RenderMultiColumnFlowThread.h"
+#include "wtf/text/StringBuilder.h"
+
+namespace blink {
+
+namespace {
+
+class RenderMultiColumnSetTest : public RenderingTest {
+protected:
+    virtual void SetUp()
+    {
+        RenderingTest::SetUp();
+        document().settings()->setRegionBasedColumnsEnabled(true);
+        m_flowThread = 0;
+    }
+
+    // Lay out the given content in two balanced 100px wide columns, and return the resulting
+    // height of the multicol container.
+    LayoutUnit balancedHeightForContent(const char* content)
+    {
+        StringBuilder html;
+        html.appendLiteral("<div id='multicol' style='-webkit-column-count: 2; -webkit-column-gap: 0; width: 200px; line-height: 20px'>");
+        html.append(content);
+        html.appendLiteral("</div>");
+        document().body()->setInnerHTML(html.toString(), ASSERT_NO_EXCEPTION);
+        document().view()->updateLayoutAndStyleIfNeededRecursive();
+        RenderBlockFlow* multicol = toRenderBlockFlow(document().getElementById("multicol")->renderer());
+        m_flowThread = multicol->multiColumnFlowThread();
+        EXPECT_TRUE(m_flowThread);
+        return multicol->logicalHeight();
+    }
+
+    // The initial pass guesses the column height, and one balancing pass lays out the content
+    // with it. Only if the guess was wrong are there further passes, stretching the height by
+    // the space shortage found in the previous one.
+    unsigned layoutPassCount() const { return m_flowThread ? m_flowThread->layoutPassCount() : 0; }
+
+private:
+    RenderMultiColumnFlowThread* m_flowThread;
+};
+
+TEST_F(RenderMultiColumnSetTest, BreakableContentIsSplitEvenly)
+{
+    EXPECT_EQ(LayoutUnit(50), balancedHeightForContent("<div style='height: 100px'></div>"));
+    EXPECT_EQ(2u, layoutPassCount());
+}
+
+TEST_F(RenderMultiColumnSetTest, LinesAreNotSplit)
+{
+    // Five 20px lines don't fit in 50px tall columns. The column height has to be stretched to
+    // make room for three lines in the first column. Stretching between passes would only find
+    // that out after laying out with 50px, and need a third pass.
+    EXPECT_EQ(LayoutUnit(60), balancedHeightForContent("line<br>line<br>line<br>line<br>line"));
+    EXPECT_EQ(2u, layoutPassCount());
+}
+
+TEST_F(RenderMultiColumnSetTest, UnsplittableBlocksAreNotSplit)
+{
+    EXPECT_EQ(LayoutUnit(120), balancedHeightForContent(
+        "<div style='height: 60px; overflow: hidden'></div>"
+        "<div style='height: 60px; overflow: hidden'></div>"
+        "<div style='height: 60px; overflow: hidden'></div>"));
+    EXPECT_EQ(2u, layoutPassCount());
+}
+
+TEST_F(RenderMultiColumnSetTest, LinesInsideUnsplittableBlocksMoveWithTheBlock)
+{
+    EXPECT_EQ(LayoutUnit(60), balancedHeightForContent(
+        "<div style='height: 40px'></div>"
+        "<div style='-webkit-column-break-inside: avoid'>line<br>line<br>line</div>"));
+    EXPECT_EQ(2u, layoutPassCount());
+}
+
+TEST_F(RenderMultiColumnSetTest, ForcedBreaksDetermineColumnHeight)
+{
+    EXPECT_EQ(LayoutUnit(90), balancedHeightForContent(
+        "<div style='height: 30px'></div>"
+        "<div style='height: 90px; -webkit-column-break-before: always'></div>"));
+}
+
+TEST_F(RenderMultiColumnSetTest, UnsplittableContentAfterForcedBreak)
+{
+    // The forced break leaves one column for the three lines after it.
+    EXPECT_EQ(LayoutUnit(60), balancedHeightForContent(
+        "<div style='height: 10px'></div>"
+        "<div style='-webkit-column-break-before: always'>line<br>line<br>line</div>"));
+    EXPECT_EQ(2u, layoutPassCount());
+}
+
+} // namespace
+
+} // namespace blink
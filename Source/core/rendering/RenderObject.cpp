@@ -52,6 +52,7 @@
 #include "core/page/EventHandler.h"
 #include "core/page/Page.h"
 #include "core/paint/ObjectPainter.h"
+#include "core/paint/ViewDisplayList.h"
 #include "core/rendering/FlowThreadController.h"
 #include "core/rendering/HitTestResult.h"
 #include "core/rendering/RenderCounter.h"
@@ -125,6 +126,30 @@ RenderObject::SetLayoutNeededForbiddenScope::~SetLayoutNeededForbiddenScope()
 {
     m_renderObject.setNeedsLayoutIsForbidden(m_preexistingForbidden);
 }
+
+static const RenderObject* s_isolatedLayoutRoot = 0;
+
+RenderObject::IsolatedLayoutScope::IsolatedLayoutScope(const RenderObject& root)
+    : m_previousRoot(s_isolatedLayoutRoot)
+{
+    s_isolatedLayoutRoot = &root;
+}
+
+RenderObject::IsolatedLayoutScope::~IsolatedLayoutScope()
+{
+    s_isolatedLayoutRoot = m_previousRoot;
+}
+
+bool RenderObject::isOutsideIsolatedLayoutRoot() const
+{
+    if (!s_isolatedLayoutRoot)
+        return false;
+    for (const RenderObject* object = this; object; object = object->container()) {
+        if (object == s_isolatedLayoutRoot)
+            return false;
+    }
+    return true;
+}
 #endif
 
 struct SameSizeAsRenderObject {
@@ -700,9 +725,17 @@ void RenderObject::markContainingBlocksForLayout(bool scheduleRelayout, RenderOb
     RenderObject* object = container();
     RenderObject* last = this;
 
+    // What a flexbox or grid measured of this box and of its containers no
+    // longer holds once something inside them changed.
+    if (isBox())
+        toRenderBox(this)->clearMeasuredLogicalHeight();
+
     bool simplifiedNormalFlowLayout = needsSimplifiedNormalFlowLayout() && !selfNeedsLayout() && !normalChildNeedsLayout();
 
     while (object) {
+        if (object->isBox())
+            toRenderBox(object)->clearMeasuredLogicalHeight();
+
         if (object->selfNeedsLayout())
             return;
 
@@ -734,6 +767,7 @@ void RenderObject::markContainingBlocksForLayout(bool scheduleRelayout, RenderOb
             object->setNormalChildNeedsLayout(true);
             ASSERT(!object->isSetNeedsLayoutForbidden());
         }
+        ASSERT(!object->isOutsideIsolatedLayoutRoot());
 
         if (layouter) {
             layouter->addRendererToLayout(object);
@@ -767,6 +801,8 @@ void RenderObject::checkBlockPositionedObjectsNeedLayout()
 void RenderObject::setPreferredLogicalWidthsDirty(MarkingBehavior markParents)
 {
     m_bitfields.setPreferredLogicalWidthsDirty(true);
+    if (isTableCell())
+        toRenderTableCell(this)->preferredLogicalWidthsDidChange();
     if (markParents == MarkContainingBlockChain && (isText() || !style()->hasOutOfFlowPosition()))
         invalidateContainerPreferredLogicalWidths();
 }
@@ -789,6 +825,8 @@ void RenderObject::invalidateContainerPreferredLogicalWidths()
             break;
 
         o->m_bitfields.setPreferredLogicalWidthsDirty(true);
+        if (o->isTableCell())
+            toRenderTableCell(o)->preferredLogicalWidthsDidChange();
         if (o->style()->hasOutOfFlowPosition())
             // A positioned object has no effect on the min/max width of its containing block ever.
             // We can optimize this case and not go up any further.
@@ -1191,6 +1229,9 @@ void RenderObject::invalidatePaintUsingContainer(const RenderLayerModelObject* p
         "object", this->debugName().ascii(),
         "info", jsonObjectForPaintInvalidationInfo(r, invalidationReasonToString(invalidationReason)));
 
+    if (RuntimeEnabledFeatures::slimmingPaintEnabled())
+        view()->viewDisplayList().invalidate(this);
+
     if (paintInvalidationContainer->isRenderFlowThread()) {
         toRenderFlowThread(paintInvalidationContainer)->paintInvalidationRectangleInRegions(r);
         return;
@@ -1283,10 +1324,23 @@ void RenderObject::invalidateTreeIfNeeded(const PaintInvalidationState& paintInv
     invalidatePaintOfSubtreesIfNeeded(paintInvalidationState);
 }
 
+bool RenderObject::markLayoutDeferredAncestorsForLayout()
+{
+    bool marked = false;
+    for (RenderObject* renderer = this; renderer; renderer = renderer->parent()) {
+        if (!renderer->isLayoutDeferred())
+            continue;
+        toRenderBlock(renderer)->setLayoutDeferralForbidden(true);
+        renderer->markContainingBlocksForLayout();
+        marked = true;
+    }
+    return marked;
+}
+
 void RenderObject::invalidatePaintOfSubtreesIfNeeded(const PaintInvalidationState& childPaintInvalidationState)
 {
     for (RenderObject* child = slowFirstChild(); child; child = child->nextSibling()) {
-        if (!child->isOutOfFlowPositioned())
+        if (!child->isOutOfFlowPositioned() && !child->isLayoutDeferred())
             child->invalidateTreeIfNeeded(childPaintInvalidationState);
     }
 }
@@ -2334,13 +2388,13 @@ inline void RenderObject::clearLayoutRootIfNeeded() const
 {
     if (frame()) {
         if (FrameView* view = frame()->view()) {
-            if (view->layoutRoot() == this) {
+            if (view->isLayoutSubtreeRoot(*this)) {
                 if (!documentBeingDestroyed())
                     ASSERT_NOT_REACHED();
                 // This indicates a failure to layout the child, which is why
                 // the layout root is still set to |this|. Make sure to clear it
                 // since we are getting destroyed.
-                view->clearLayoutSubtreeRoot();
+                view->clearLayoutSubtreeRoot(*this);
             }
         }
     }
@@ -2366,6 +2420,11 @@ void RenderObject::willBeDestroyed()
 
     remove();
 
+    if (RuntimeEnabledFeatures::slimmingPaintEnabled()) {
+        if (RenderView* renderView = view())
+            renderView->viewDisplayList().remove(this);
+    }
+
     // The remove() call above may invoke axObjectCache()->childrenChanged() on the parent, which may require the AX render
     // object for this renderer. So we remove the AX render object now, after the renderer is removed.
     if (AXObjectCache* cache = document().existingAXObjectCache())
@@ -231,6 +231,16 @@ public:
         bool m_preexistingForbidden;
     };
 
+    // Helper class asserting that the layout of a relayout boundary laid out
+    // on its own doesn't mark anything outside of it as needing layout.
+    class IsolatedLayoutScope {
+    public:
+        explicit IsolatedLayoutScope(const RenderObject& root);
+        ~IsolatedLayoutScope();
+    private:
+        const RenderObject* m_previousRoot;
+    };
+
     void assertRendererLaidOut() const
     {
 #ifndef NDEBUG
@@ -242,8 +252,14 @@ public:
 
     void assertSubtreeIsLaidOut() const
     {
-        for (const RenderObject* renderer = this; renderer; renderer = renderer->nextInPreOrder())
+        for (const RenderObject* renderer = this; renderer; ) {
+            if (renderer->isLayoutDeferred()) {
+                renderer = renderer->nextInPreOrderAfterChildren();
+                continue;
+            }
             renderer->assertRendererLaidOut();
+            renderer = renderer->nextInPreOrder();
+        }
     }
 
     void assertRendererClearedPaintInvalidationState() const
@@ -258,8 +274,14 @@ public:
 
     void assertSubtreeClearedPaintInvalidationState() const
     {
-        for (const RenderObject* renderer = this; renderer; renderer = renderer->nextInPreOrder())
+        for (const RenderObject* renderer = this; renderer; ) {
+            if (renderer->isLayoutDeferred()) {
+                renderer = renderer->nextInPreOrderAfterChildren();
+                continue;
+            }
             renderer->assertRendererClearedPaintInvalidationState();
+            renderer = renderer->nextInPreOrder();
+        }
     }
 
 #endif
@@ -314,6 +336,7 @@ private:
 #if ENABLE(ASSERT)
     bool isSetNeedsLayoutForbidden() const { return m_setNeedsLayoutForbidden; }
     void setNeedsLayoutIsForbidden(bool flag) { m_setNeedsLayoutForbidden = flag; }
+    bool isOutsideIsolatedLayoutRoot() const;
 #endif
 
     void addAbsoluteRectForLayer(LayoutRect& result);
@@ -575,6 +598,14 @@ public:
     }
 
     bool selfNeedsLayout() const { return m_bitfields.selfNeedsLayout(); }
+
+    // A renderer whose layout was skipped by its parent because it is far
+    // outside the viewport. It keeps its dirty bits and is neither painted,
+    // hit tested nor walked for paint invalidation until it is laid out.
+    virtual bool isLayoutDeferred() const { return false; }
+    // Marks this renderer and its ancestors whose layout was deferred for layout, and
+    // keeps their parents from deferring them again. Returns false if there were none.
+    bool markLayoutDeferredAncestorsForLayout();
     bool needsPositionedMovementLayout() const { return m_bitfields.needsPositionedMovementLayout(); }
     bool needsPositionedMovementLayoutOnly() const
     {
@@ -1397,6 +1428,7 @@ inline void RenderObject::setNeedsLayout(MarkingBehavior markParents, SubtreeLay
         "data",
         InspectorLayoutInvalidationTrackingEvent::data(this));
     ASSERT(!isSetNeedsLayoutForbidden());
+    ASSERT(!isOutsideIsolatedLayoutRoot());
     bool alreadyNeededLayout = m_bitfields.selfNeedsLayout();
     setSelfNeedsLayout(true);
     if (!alreadyNeededLayout) {
@@ -1431,6 +1463,7 @@ inline void RenderObject::clearNeedsLayout()
 inline void RenderObject::setChildNeedsLayout(MarkingBehavior markParents, SubtreeLayoutScope* layouter)
 {
     ASSERT(!isSetNeedsLayoutForbidden());
+    ASSERT(!isOutsideIsolatedLayoutRoot());
     bool alreadyNeededLayout = normalChildNeedsLayout();
     setNormalChildNeedsLayout(true);
     // FIXME: Replace MarkOnlyThis with the SubtreeLayoutScope code path and remove the MarkingBehavior argument entirely.
@@ -1443,6 +1476,7 @@ inline void RenderObject::setNeedsPositionedMovementLayout()
     bool alreadyNeededLayout = needsPositionedMovementLayout();
     setNeedsPositionedMovementLayout(true);
     ASSERT(!isSetNeedsLayoutForbidden());
+    ASSERT(!isOutsideIsolatedLayoutRoot());
     if (!alreadyNeededLayout)
         markContainingBlocksForLayout();
 }
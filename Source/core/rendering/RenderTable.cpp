@@ -98,6 +98,8 @@ void RenderTable::styleDidChange(StyleDifference diff, const RenderStyle* oldSty
             m_tableLayout = adoptPtr(new FixedTableLayout(this));
         else
             m_tableLayout = adoptPtr(new AutoTableLayout(this));
+    } else {
+        m_tableLayout->invalidateIntrinsicLogicalWidths();
     }
 
     // If border was changed, invalidate collapsed borders cache.
@@ -228,6 +230,19 @@ void RenderTable::invalidateCachedColumns()
 {
     m_columnRenderersValid = false;
     m_columnRenderers.resize(0);
+    invalidateIntrinsicColumnLogicalWidths();
+}
+
+void RenderTable::cellPreferredLogicalWidthsChanged(const RenderTableCell& cell)
+{
+    if (m_tableLayout)
+        m_tableLayout->cellPreferredLogicalWidthsChanged(cell);
+}
+
+void RenderTable::invalidateIntrinsicColumnLogicalWidths()
+{
+    if (m_tableLayout)
+        m_tableLayout->invalidateIntrinsicLogicalWidths();
 }
 
 void RenderTable::addColumn(const RenderTableCol*)
@@ -807,6 +822,9 @@ void RenderTable::recalcSections() const
 {
     ASSERT(m_needsSectionRecalc);
 
+    if (m_tableLayout)
+        m_tableLayout->invalidateIntrinsicLogicalWidths();
+
     m_head = 0;
     m_foot = 0;
     m_firstBody = 0;
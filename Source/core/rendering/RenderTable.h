@@ -135,6 +135,11 @@ public:
         unsigned span;
     };
 
+    // Let the table layout recompute only what the change can affect when the
+    // intrinsic widths are next needed.
+    void cellPreferredLogicalWidthsChanged(const RenderTableCell&);
+    void invalidateIntrinsicColumnLogicalWidths();
+
     void forceSectionsRecalc()
     {
         setNeedsSectionRecalc();
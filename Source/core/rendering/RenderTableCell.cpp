@@ -383,6 +383,18 @@ LayoutUnit RenderTableCell::cellBaselinePosition() const
     return paddingBefore() + borderBefore() + contentLogicalHeight();
 }
 
+void RenderTableCell::preferredLogicalWidthsDidChange()
+{
+    // Cells that are not in a table grid yet are picked up by the section recalc
+    // that follows their insertion.
+    RenderObject* row = parent();
+    RenderObject* section = row ? row->parent() : 0;
+    RenderObject* table = section ? section->parent() : 0;
+    if (!table || !table->isTable() || documentBeingDestroyed())
+        return;
+    toRenderTable(table)->cellPreferredLogicalWidthsChanged(*this);
+}
+
 void RenderTableCell::styleDidChange(StyleDifference diff, const RenderStyle* oldStyle)
 {
     ASSERT(style()->display() == TABLE_CELL);
@@ -393,6 +405,11 @@ void RenderTableCell::styleDidChange(StyleDifference diff, const RenderStyle* ol
     if (parent() && section() && oldStyle && style()->height() != oldStyle->height())
         section()->rowLogicalHeightChanged(row());
 
+    // Borders, padding and backgrounds decide whether the column counts as empty,
+    // which is not covered by the preferred widths being dirtied.
+    if (oldStyle)
+        preferredLogicalWidthsDidChange();
+
     // Our intrinsic padding pushes us down to align with the baseline of other cells on the row. If our vertical-align
     // has changed then so will the padding needed to align with other cells - clear it so we can recalculate it from scratch.
     if (oldStyle && style()->verticalAlign() != oldStyle->verticalAlign())
@@ -77,6 +77,9 @@ public:
     RenderTableSection* section() const { return toRenderTableSection(parent()->parent()); }
     RenderTable* table() const { return toRenderTable(parent()->parent()->parent()); }
 
+    // Called by RenderObject whenever our preferred logical widths are marked dirty.
+    void preferredLogicalWidthsDidChange();
+
     RenderTableCell* previousCell() const;
     RenderTableCell* nextCell() const;
 
@@ -38,6 +38,7 @@
 #include "core/rendering/RenderCombineText.h"
 #include "core/rendering/RenderLayer.h"
 #include "core/rendering/RenderView.h"
+#include "core/rendering/TextMeasurementCache.h"
 #include "core/rendering/TextRunConstructor.h"
 #include "core/rendering/break_lines.h"
 #include "platform/fonts/Character.h"
@@ -68,6 +69,13 @@ class SecureTextTimer;
 typedef HashMap<RenderText*, SecureTextTimer*> SecureTextTimerMap;
 static SecureTextTimerMap* gSecureTextTimers = 0;
 
+typedef HashMap<RenderText*, OwnPtr<TextMeasurementCache> > TextMeasurementCacheMap;
+static TextMeasurementCacheMap* gTextMeasurementCaches = 0;
+
+// When the caches of all RenderTexts together hold more widths than this,
+// they are all thrown away and rebuilt by the following layouts.
+static const size_t maxTextMeasurementCacheEntries = 256 * 1024;
+
 class SecureTextTimer FINAL : public TimerBase {
 public:
     SecureTextTimer(RenderText* renderText)
@@ -142,6 +150,7 @@ RenderText::RenderText(Node* node, PassRefPtr<StringImpl> str)
     , m_linesDirty(false)
     , m_containsReversedText(false)
     , m_knownToHaveNoOverflowAndNoFallbackFonts(false)
+    , m_hasMeasurementCache(false)
     , m_minWidth(-1)
     , m_maxWidth(-1)
     , m_firstLineMinWidth(0)
@@ -200,6 +209,9 @@ void RenderText::styleDidChange(StyleDifference diff, const RenderStyle* oldStyl
     }
 
     RenderStyle* newStyle = style();
+    if (!oldStyle || oldStyle->font() != newStyle->font() || oldStyle->direction() != newStyle->direction() || oldStyle->unicodeBidi() != newStyle->unicodeBidi())
+        clearMeasurementCache();
+
     ETextTransform oldTransform = oldStyle ? oldStyle->textTransform() : TTNONE;
     ETextSecurity oldSecurity = oldStyle ? oldStyle->textSecurity() : TSNONE;
     if (oldTransform != newStyle->textTransform() || oldSecurity != newStyle->textSecurity())
@@ -234,6 +246,7 @@ void RenderText::willBeDestroyed()
     if (SecureTextTimer* secureTextTimer = gSecureTextTimers ? gSecureTextTimers->take(this) : 0)
         delete secureTextTimer;
 
+    clearMeasurementCache();
     removeAndDestroyTextBoxes();
     RenderObject::willBeDestroyed();
 }
@@ -751,6 +764,10 @@ ALWAYS_INLINE float RenderText::widthFromCache(const Font& f, int start, int len
         return w;
     }
 
+    float width;
+    if ((!glyphOverflow || !glyphOverflow->computeBounds) && widthForLatin1Text(f, start, len, textDirection, !style()->collapseWhiteSpace(), width))
+        return width;
+
     TextRun run = constructTextRun(const_cast<RenderText*>(this), f, this, start, len, style(), textDirection);
     run.setCharactersLength(textLength() - start);
     ASSERT(run.charactersLength() >= run.length());
@@ -762,6 +779,14 @@ ALWAYS_INLINE float RenderText::widthFromCache(const Font& f, int start, int len
     return f.width(run, fallbackFonts, glyphOverflow);
 }
 
+bool RenderText::widthForLatin1Text(const Font& font, unsigned from, unsigned len, TextDirection direction, bool allowTabs, float& width) const
+{
+    if (!m_text.is8Bit() || direction != LTR || !m_canUseSimpleFontCodePath)
+        return false;
+    ASSERT(from + len <= textLength());
+    return font.widthForLatin1Text(m_text.characters8() + from, len, allowTabs, width);
+}
+
 void RenderText::trimmedPrefWidths(float leadWidth,
     float& firstLineMinWidth, bool& hasBreakableStart,
     float& lastLineMinWidth, bool& hasBreakableEnd,
@@ -1296,7 +1321,17 @@ void RenderText::setTextWithOffset(PassRefPtr<StringImpl> text, unsigned offset,
     }
 
     m_linesDirty = dirtiedLines;
-    setText(text, force || dirtiedLines);
+
+    // setText() throws the measured word widths away, but only the words
+    // touching the edited range have changed. Keep the others unless the
+    // text was transformed or secured, which may have changed every word.
+    OwnPtr<TextMeasurementCache> measurementCache = takeMeasurementCache();
+    RefPtr<StringImpl> newText = text;
+    setText(newText, force || dirtiedLines);
+    if (measurementCache && m_text.impl() == newText.get()) {
+        measurementCache->didReplaceText(m_text, offset, len, len + delta);
+        setMeasurementCache(measurementCache.release());
+    }
 }
 
 void RenderText::transformText()
@@ -1382,6 +1417,53 @@ void RenderText::setTextInternal(PassRefPtr<StringImpl> text)
 
     m_isAllASCII = m_text.containsOnlyASCII();
     m_canUseSimpleFontCodePath = computeCanUseSimpleFontCodePath();
+    clearMeasurementCache();
+}
+
+TextMeasurementCache* RenderText::measurementCache()
+{
+    if (m_hasMeasurementCache)
+        return gTextMeasurementCaches->get(this);
+    if (textLength() < TextMeasurementCache::minimumTextLength)
+        return 0;
+
+    if (!gTextMeasurementCaches) {
+        gTextMeasurementCaches = new TextMeasurementCacheMap;
+    } else if (TextMeasurementCache::totalEntries() > maxTextMeasurementCacheEntries) {
+        for (TextMeasurementCacheMap::iterator it = gTextMeasurementCaches->begin(); it != gTextMeasurementCaches->end(); ++it)
+            it->key->m_hasMeasurementCache = false;
+        gTextMeasurementCaches->clear();
+    }
+
+    OwnPtr<TextMeasurementCache> cache = TextMeasurementCache::create(m_text);
+    TextMeasurementCache* result = cache.get();
+    gTextMeasurementCaches->add(this, cache.release());
+    m_hasMeasurementCache = true;
+    return result;
+}
+
+void RenderText::clearMeasurementCache()
+{
+    if (!m_hasMeasurementCache)
+        return;
+    gTextMeasurementCaches->remove(this);
+    m_hasMeasurementCache = false;
+}
+
+PassOwnPtr<TextMeasurementCache> RenderText::takeMeasurementCache()
+{
+    if (!m_hasMeasurementCache)
+        return nullptr;
+    m_hasMeasurementCache = false;
+    return gTextMeasurementCaches->take(this);
+}
+
+void RenderText::setMeasurementCache(PassOwnPtr<TextMeasurementCache> cache)
+{
+    ASSERT(gTextMeasurementCaches);
+    clearMeasurementCache();
+    gTextMeasurementCaches->set(this, cache);
+    m_hasMeasurementCache = true;
 }
 
 void RenderText::secureText(UChar mask)
@@ -34,6 +34,7 @@ namespace blink {
 
 class AbstractInlineTextBox;
 class InlineTextBox;
+class TextMeasurementCache;
 
 class RenderText : public RenderObject {
 public:
@@ -88,6 +89,15 @@ public:
     virtual float width(unsigned from, unsigned len, const Font&, float xPos, TextDirection, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0) const;
     virtual float width(unsigned from, unsigned len, float xPos, TextDirection, bool firstLine = false, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0) const;
 
+    // Measures [from, from + len) by summing the font's Latin-1 advances, when
+    // the text is 8-bit and left-to-right and the font needs no shaping.
+    // Returns false when the caller has to build a TextRun instead.
+    bool widthForLatin1Text(const Font&, unsigned from, unsigned len, TextDirection, bool allowTabs, float& width) const;
+
+    // Word widths measured with style()->font() by the line breaker. Returns
+    // 0 for texts too short to be worth caching.
+    TextMeasurementCache* measurementCache();
+
     float minLogicalWidth() const;
     float maxLogicalWidth() const;
 
@@ -174,6 +184,9 @@ private:
     virtual bool nodeAtPoint(const HitTestRequest&, HitTestResult&, const HitTestLocation&, const LayoutPoint&, HitTestAction) OVERRIDE FINAL { ASSERT_NOT_REACHED(); return false; }
 
     void deleteTextBoxes();
+    void clearMeasurementCache();
+    PassOwnPtr<TextMeasurementCache> takeMeasurementCache();
+    void setMeasurementCache(PassOwnPtr<TextMeasurementCache>);
     bool containsOnlyWhitespace(unsigned from, unsigned len) const;
     float widthFromCache(const Font&, int start, int len, float xPos, TextDirection, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow*) const;
     bool isAllASCII() const { return m_isAllASCII; }
@@ -201,6 +214,7 @@ private:
     bool m_isAllASCII : 1;
     bool m_canUseSimpleFontCodePath : 1;
     mutable bool m_knownToHaveNoOverflowAndNoFallbackFonts : 1;
+    bool m_hasMeasurementCache : 1;
 
     float m_minWidth;
     float m_maxWidth;
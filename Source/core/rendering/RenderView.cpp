@@ -27,6 +27,7 @@
 #include "core/html/HTMLFrameOwnerElement.h"
 #include "core/html/HTMLIFrameElement.h"
 #include "core/page/Page.h"
+#include "core/paint/ViewDisplayList.h"
 #include "core/paint/ViewPainter.h"
 #include "core/rendering/ColumnInfo.h"
 #include "core/rendering/FlowThreadController.h"
@@ -38,6 +39,7 @@
 #include "core/rendering/RenderPart.h"
 #include "core/rendering/RenderQuote.h"
 #include "core/rendering/RenderSelectionInfo.h"
+#include "core/rendering/RootInlineBox.h"
 #include "core/rendering/compositing/CompositedLayerMapping.h"
 #include "core/rendering/compositing/RenderLayerCompositor.h"
 #include "core/svg/SVGDocumentExtensions.h"
@@ -102,8 +104,17 @@ bool RenderView::hitTest(const HitTestRequest& request, const HitTestLocation& l
     // FIXME: It should be the caller's responsibility to ensure an up-to-date layout.
     frameView()->updateLayoutAndStyleIfNeededRecursive();
 
+    HitTestResult resultBeforeHitTest = result;
     bool hitLayer = layer()->hitTest(request, location, result);
 
+    // The hit test reached children whose layout was deferred and marked them for
+    // layout. Lay them out and test again against their real geometry.
+    if (needsLayout()) {
+        frameView()->updateLayoutAndStyleIfNeededRecursive();
+        result = resultBeforeHitTest;
+        hitLayer = layer()->hitTest(request, location, result);
+    }
+
     // ScrollView scrollbars are not the same as RenderLayer scrollbars tested by RenderLayer::hitTestOverflowControls,
     // so we need to test ScrollView scrollbars separately here. Note that it's important we do this after
     // the hit test above, because that may overwrite the entire HitTestResult when it finds a hit.
@@ -842,6 +853,14 @@ void RenderView::setIsInWindow(bool isInWindow)
         m_compositor->setIsInWindow(isInWindow);
 }
 
+ViewDisplayList& RenderView::viewDisplayList()
+{
+    if (!m_viewDisplayList)
+        m_viewDisplayList = ViewDisplayList::create();
+
+    return *m_viewDisplayList;
+}
+
 FlowThreadController* RenderView::flowThreadController()
 {
     if (!m_flowThreadController)
@@ -881,6 +900,18 @@ IntervalArena* RenderView::intervalArena()
     return m_intervalArena.get();
 }
 
+size_t RenderView::lineBoxBytes() const
+{
+    size_t bytes = 0;
+    for (RenderObject* renderer = firstChild(); renderer; renderer = renderer->nextInPreOrder(this)) {
+        if (!renderer->isRenderBlockFlow() || !renderer->childrenInline())
+            continue;
+        for (RootInlineBox* line = toRenderBlockFlow(renderer)->firstRootBox(); line; line = line->nextRootBox())
+            bytes += line->allocatedBytes();
+    }
+    return bytes;
+}
+
 bool RenderView::backgroundIsKnownToBeOpaqueInRect(const LayoutRect&) const
 {
     // FIXME: Remove this main frame check. Same concept applies to subframes too.
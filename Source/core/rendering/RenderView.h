@@ -35,6 +35,7 @@ namespace blink {
 class FlowThreadController;
 class RenderLayerCompositor;
 class RenderQuote;
+class ViewDisplayList;
 
 // The root of the render tree, corresponding to the CSS initial containing block.
 // It's dimensions match that of the logical viewport (which may be different from
@@ -144,6 +145,12 @@ public:
 
     IntervalArena* intervalArena();
 
+    // The memory taken by the line boxes of every block in this frame.
+    size_t lineBoxBytes() const;
+
+    // Display items cached across paints when SlimmingPaint is enabled.
+    ViewDisplayList& viewDisplayList();
+
     void setRenderQuoteHead(RenderQuote* head) { m_renderQuoteHead = head; }
     RenderQuote* renderQuoteHead() const { return m_renderQuoteHead; }
 
@@ -197,6 +204,7 @@ private:
     OwnPtr<RenderLayerCompositor> m_compositor;
     OwnPtr<FlowThreadController> m_flowThreadController;
     RefPtr<IntervalArena> m_intervalArena;
+    OwnPtr<ViewDisplayList> m_viewDisplayList;
 
     RawPtrWillBeMember<RenderQuote> m_renderQuoteHead;
     unsigned m_renderCounterCount;
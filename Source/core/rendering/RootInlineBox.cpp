@@ -38,7 +38,7 @@ namespace blink {
 
 struct SameSizeAsRootInlineBox : public InlineFlowBox {
     unsigned unsignedVariable;
-    void* pointers[4];
+    void* pointers[3];
     LayoutUnit layoutVariables[5];
 };
 
@@ -90,6 +90,16 @@ void RootInlineBox::clearTruncation()
     }
 }
 
+size_t RootInlineBox::allocatedBytes() const
+{
+    size_t bytes = InlineFlowBox::allocatedBytes();
+    if (m_rareData)
+        bytes += sizeof(RootInlineBoxRareData) + m_rareData->m_floats.capacity() * sizeof(RenderBox*);
+    if (EllipsisBox* ellipsis = ellipsisBox())
+        bytes += ellipsis->allocatedBytes();
+    return bytes;
+}
+
 int RootInlineBox::baselinePosition(FontBaseline baselineType) const
 {
     return boxModelObject()->baselinePosition(baselineType, isFirstLineStyle(), isHorizontal() ? HorizontalLine : VerticalLine, PositionOfInteriorLineBoxes);
@@ -54,14 +54,14 @@ public:
     LayoutUnit lineTopWithLeading() const { return m_lineTopWithLeading; }
     LayoutUnit lineBottomWithLeading() const { return m_lineBottomWithLeading; }
 
-    LayoutUnit paginationStrut() const { return m_fragmentationData ? m_fragmentationData->m_paginationStrut : LayoutUnit(0); }
-    void setPaginationStrut(LayoutUnit strut) { ensureLineFragmentationData()->m_paginationStrut = strut; }
+    LayoutUnit paginationStrut() const { return m_rareData ? m_rareData->m_paginationStrut : LayoutUnit(0); }
+    void setPaginationStrut(LayoutUnit strut) { ensureRareData()->m_paginationStrut = strut; }
 
-    bool isFirstAfterPageBreak() const { return m_fragmentationData ? m_fragmentationData->m_isFirstAfterPageBreak : false; }
-    void setIsFirstAfterPageBreak(bool isFirstAfterPageBreak) { ensureLineFragmentationData()->m_isFirstAfterPageBreak = isFirstAfterPageBreak; }
+    bool isFirstAfterPageBreak() const { return m_rareData ? m_rareData->m_isFirstAfterPageBreak : false; }
+    void setIsFirstAfterPageBreak(bool isFirstAfterPageBreak) { ensureRareData()->m_isFirstAfterPageBreak = isFirstAfterPageBreak; }
 
-    LayoutUnit paginatedLineWidth() const { return m_fragmentationData ? m_fragmentationData->m_paginatedLineWidth : LayoutUnit(0); }
-    void setPaginatedLineWidth(LayoutUnit width) { ensureLineFragmentationData()->m_paginatedLineWidth = width; }
+    LayoutUnit paginatedLineWidth() const { return m_rareData ? m_rareData->m_paginatedLineWidth : LayoutUnit(0); }
+    void setPaginatedLineWidth(LayoutUnit width) { ensureRareData()->m_paginatedLineWidth = width; }
 
     LayoutUnit selectionTop() const;
     LayoutUnit selectionBottom() const;
@@ -109,6 +109,8 @@ public:
 
     virtual void clearTruncation() OVERRIDE FINAL;
 
+    virtual size_t allocatedBytes() const OVERRIDE FINAL;
+
     virtual int baselinePosition(FontBaseline baselineType) const OVERRIDE FINAL;
     virtual LayoutUnit lineHeight() const OVERRIDE FINAL;
 
@@ -132,13 +134,14 @@ public:
     void appendFloat(RenderBox* floatingBox)
     {
         ASSERT(!isDirty());
-        if (m_floats)
-            m_floats->append(floatingBox);
-        else
-            m_floats= adoptPtr(new Vector<RenderBox*>(1, floatingBox));
+        ensureRareData()->m_floats.append(floatingBox);
     }
 
-    Vector<RenderBox*>* floatsPtr() { ASSERT(!isDirty()); return m_floats.get(); }
+    Vector<RenderBox*>* floatsPtr()
+    {
+        ASSERT(!isDirty());
+        return m_rareData && !m_rareData->m_floats.isEmpty() ? &m_rareData->m_floats : 0;
+    }
 
     virtual void extractLineBoxFromRenderObject() OVERRIDE FINAL;
     virtual void attachLineBoxToRenderObject() OVERRIDE FINAL;
@@ -189,13 +192,13 @@ public:
 private:
     LayoutUnit beforeAnnotationsAdjustment() const;
 
-    struct LineFragmentationData;
-    LineFragmentationData* ensureLineFragmentationData()
+    struct RootInlineBoxRareData;
+    RootInlineBoxRareData* ensureRareData()
     {
-        if (!m_fragmentationData)
-            m_fragmentationData = adoptPtr(new LineFragmentationData());
+        if (!m_rareData)
+            m_rareData = adoptPtr(new RootInlineBoxRareData());
 
-        return m_fragmentationData.get();
+        return m_rareData.get();
     }
 
     // This folds into the padding at the end of InlineFlowBox on 64-bit.
@@ -206,10 +209,12 @@ private:
     RenderObject* m_lineBreakObj;
     RefPtr<BidiContext> m_lineBreakContext;
 
-    struct LineFragmentationData {
-        WTF_MAKE_NONCOPYABLE(LineFragmentationData); WTF_MAKE_FAST_ALLOCATED;
+    // Only lines that are paginated or that had floats placed on them need
+    // this, so it is kept out of line to keep every other line small.
+    struct RootInlineBoxRareData {
+        WTF_MAKE_NONCOPYABLE(RootInlineBoxRareData); WTF_MAKE_FAST_ALLOCATED;
     public:
-        LineFragmentationData()
+        RootInlineBoxRareData()
             : m_paginationStrut(0)
             , m_paginatedLineWidth(0)
             , m_isFirstAfterPageBreak(false)
@@ -220,13 +225,13 @@ private:
         LayoutUnit m_paginationStrut;
         LayoutUnit m_paginatedLineWidth;
         bool m_isFirstAfterPageBreak;
-    };
 
-    OwnPtr<LineFragmentationData> m_fragmentationData;
+        // Floats hanging off the line are pushed into this vector during layout. It is only
+        // good for as long as the line has not been marked dirty.
+        Vector<RenderBox*> m_floats;
+    };
 
-    // Floats hanging off the line are pushed into this vector during layout. It is only
-    // good for as long as the line has not been marked dirty.
-    OwnPtr<Vector<RenderBox*> > m_floats;
+    OwnPtr<RootInlineBoxRareData> m_rareData;
 
     LayoutUnit m_lineTop;
     LayoutUnit m_lineBottom;
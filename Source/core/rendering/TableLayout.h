@@ -28,6 +28,7 @@ namespace blink {
 
 class LayoutUnit;
 class RenderTable;
+class RenderTableCell;
 
 class TableLayout {
     WTF_MAKE_NONCOPYABLE(TableLayout); WTF_MAKE_FAST_ALLOCATED;
@@ -44,6 +45,11 @@ public:
     virtual void layout() = 0;
     virtual void willChangeTableLayout() = 0;
 
+    // Hints letting implementations keep intrinsic column widths across recalcs.
+    // The default is to recompute everything in computeIntrinsicLogicalWidths.
+    virtual void cellPreferredLogicalWidthsChanged(const RenderTableCell&) { }
+    virtual void invalidateIntrinsicLogicalWidths() { }
+
 protected:
     // FIXME: Once we enable SATURATED_LAYOUT_ARITHMETHIC, this should just be LayoutUnit::nearlyMax().
     // Until then though, using nearlyMax causes overflow in some tests, so we just pick a large number.
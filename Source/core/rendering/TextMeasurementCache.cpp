@@ -0,0 +1,55 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/rendering/TextMeasurementCache.h"
+
+#include "wtf/MainThread.h"
+
+namespace blink {
+
+size_t TextMeasurementCache::s_totalEntries = 0;
+
+TextMeasurementCache::TextMeasurementCache(const String& text)
+    : m_hasTab(text.find('\t') != kNotFound)
+{
+}
+
+TextMeasurementCache::~TextMeasurementCache()
+{
+    ASSERT(s_totalEntries >= m_widths.size());
+    s_totalEntries -= m_widths.size();
+}
+
+void TextMeasurementCache::add(unsigned from, unsigned length, float width)
+{
+    ASSERT(isMainThread());
+    ASSERT(length);
+    if (m_widths.size() >= maxEntries)
+        return;
+    if (m_widths.add(key(from, length), width).isNewEntry)
+        ++s_totalEntries;
+}
+
+void TextMeasurementCache::didReplaceText(const String& text, unsigned offset, unsigned oldLength, unsigned newLength)
+{
+    HashMap<uint64_t, float> widths;
+    widths.swap(m_widths);
+    ASSERT(s_totalEntries >= widths.size());
+    s_totalEntries -= widths.size();
+
+    HashMap<uint64_t, float>::const_iterator end = widths.end();
+    for (HashMap<uint64_t, float>::const_iterator it = widths.begin(); it != end; ++it) {
+        unsigned from = static_cast<unsigned>(it->key >> 32);
+        unsigned length = static_cast<unsigned>(it->key);
+        if (from + length <= offset)
+            add(from, length, it->value);
+        else if (from >= offset + oldLength)
+            add(from - oldLength + newLength, length, it->value);
+    }
+
+    m_hasTab = text.find('\t') != kNotFound;
+}
+
+} // namespace blink
@@ -0,0 +1,87 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TextMeasurementCache_h
+#define TextMeasurementCache_h
+
+#include "wtf/FastAllocBase.h"
+#include "wtf/HashMap.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/PassOwnPtr.h"
+#include "wtf/text/WTFString.h"
+
+namespace blink {
+
+// The widths of the words of a RenderText as measured by the line breaker.
+// A relayout which only changes the available width, e.g. a window resize or
+// a flexbox measure pass, breaks the text into lines at different places but
+// measures the same words again; those widths come from here instead of from
+// shaping the text again.
+//
+// Only widths measured with the RenderText's own font, and which didn't use
+// any fallback fonts, are cached. The RenderText throws the cache away when
+// its font changes, and keeps the widths of the unchanged words when its text
+// is edited.
+class TextMeasurementCache {
+    WTF_MAKE_NONCOPYABLE(TextMeasurementCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<TextMeasurementCache> create(const String& text)
+    {
+        return adoptPtr(new TextMeasurementCache(text));
+    }
+
+    ~TextMeasurementCache();
+
+    // Texts shorter than this are usually measured as a whole, which goes
+    // through RenderText::width() instead.
+    static const unsigned minimumTextLength = 32;
+
+    // Tabs make the width of a run depend on where the run starts on the
+    // line, so runs of texts with tabs are only cached when the tabs are
+    // collapsed to spaces.
+    bool canCache(bool collapseWhiteSpace) const { return collapseWhiteSpace || !m_hasTab; }
+
+    bool lookup(unsigned from, unsigned length, float& width) const
+    {
+        HashMap<uint64_t, float>::const_iterator it = m_widths.find(key(from, length));
+        if (it == m_widths.end())
+            return false;
+        width = it->value;
+        return true;
+    }
+
+    void add(unsigned from, unsigned length, float width);
+
+    // The characters in [offset, offset + oldLength) were replaced by
+    // newLength characters, giving |text|. The widths of the runs before the
+    // edit stay where they are, those of the runs after it move with their
+    // characters, and those of the runs overlapping it are dropped.
+    void didReplaceText(const String& text, unsigned offset, unsigned oldLength, unsigned newLength);
+
+    // The number of widths cached by all the TextMeasurementCaches, so that
+    // their owners can bound their memory use.
+    static size_t totalEntries() { return s_totalEntries; }
+
+private:
+    explicit TextMeasurementCache(const String&);
+
+    static uint64_t key(unsigned from, unsigned length)
+    {
+        // |length| is never 0, so the key is never the empty value.
+        return (static_cast<uint64_t>(from) << 32) | length;
+    }
+
+    // A single paragraph rarely has more distinct words than this; breaking
+    // long words character by character is what fills the cache beyond it.
+    static const unsigned maxEntries = 1024;
+
+    HashMap<uint64_t, float> m_widths;
+    bool m_hasTab;
+
+    static size_t s_totalEntries;
+};
+
+} // namespace blink
+
+#endif // TextMeasurementCache_h
@@ -0,0 +1,88 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/rendering/TextMeasurementCache.h"
+
+#include "wtf/OwnPtr.h"
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+TEST(TextMeasurementCacheTest, LookupByRange)
+{
+    OwnPtr<TextMeasurementCache> cache = TextMeasurementCache::create("Lorem ipsum dolor sit amet, consectetur adipiscing elit.");
+    float width = 0;
+    EXPECT_FALSE(cache->lookup(0, 5, width));
+
+    cache->add(0, 5, 31.5f);
+    cache->add(6, 5, 33.25f);
+    EXPECT_TRUE(cache->lookup(0, 5, width));
+    EXPECT_EQ(31.5f, width);
+    EXPECT_TRUE(cache->lookup(6, 5, width));
+    EXPECT_EQ(33.25f, width);
+    EXPECT_FALSE(cache->lookup(0, 6, width));
+    EXPECT_FALSE(cache->lookup(5, 5, width));
+}
+
+TEST(TextMeasurementCacheTest, Tabs)
+{
+    OwnPtr<TextMeasurementCache> withoutTabs = TextMeasurementCache::create("no tabs here");
+    EXPECT_TRUE(withoutTabs->canCache(true));
+    EXPECT_TRUE(withoutTabs->canCache(false));
+
+    OwnPtr<TextMeasurementCache> withTabs = TextMeasurementCache::create("one\ttab");
+    EXPECT_TRUE(withTabs->canCache(true));
+    EXPECT_FALSE(withTabs->canCache(false));
+}
+
+TEST(TextMeasurementCacheTest, TotalEntries)
+{
+    size_t initialEntries = TextMeasurementCache::totalEntries();
+    {
+        OwnPtr<TextMeasurementCache> cache = TextMeasurementCache::create("text");
+        cache->add(0, 1, 1);
+        cache->add(1, 1, 1);
+        cache->add(1, 1, 1);
+        EXPECT_EQ(initialEntries + 2, TextMeasurementCache::totalEntries());
+    }
+    EXPECT_EQ(initialEntries, TextMeasurementCache::totalEntries());
+}
+
+TEST(TextMeasurementCacheTest, ReplaceText)
+{
+    OwnPtr<TextMeasurementCache> cache = TextMeasurementCache::create("one two three");
+    cache->add(0, 3, 30);
+    cache->add(4, 3, 31);
+    cache->add(8, 5, 50);
+
+    // "one two three" -> "one 2 three"
+    cache->didReplaceText("one 2 three", 4, 3, 1);
+    float width;
+    EXPECT_TRUE(cache->lookup(0, 3, width));
+    EXPECT_EQ(30, width);
+    EXPECT_FALSE(cache->lookup(4, 3, width));
+    EXPECT_FALSE(cache->lookup(4, 1, width));
+    EXPECT_FALSE(cache->lookup(8, 5, width));
+    EXPECT_TRUE(cache->lookup(6, 5, width));
+    EXPECT_EQ(50, width);
+
+    // Appending a tab means runs can no longer be cached unless tabs collapse.
+    EXPECT_TRUE(cache->canCache(false));
+    cache->didReplaceText("one 2 three\tfour", 11, 0, 5);
+    EXPECT_TRUE(cache->lookup(6, 5, width));
+    EXPECT_FALSE(cache->canCache(false));
+}
+
+TEST(TextMeasurementCacheTest, Bounded)
+{
+    OwnPtr<TextMeasurementCache> cache = TextMeasurementCache::create("text");
+    for (unsigned i = 0; i < 100000; ++i)
+        cache->add(i, 1, 1);
+    EXPECT_GT(100000u, TextMeasurementCache::totalEntries());
+}
+
+} // namespace
@@ -2182,6 +2182,9 @@ void CompositedLayerMapping::paintContents(const GraphicsLayer* graphicsLayer, G
     // FIXME(361045): remove InspectorInstrumentation calls once DevTools Timeline migrates to tracing.
     InspectorInstrumentation::willPaint(m_owningLayer.renderer(), graphicsLayer);
 
+    // The compositor rasters the recorded content at the device scale factor.
+    context.setDeviceScaleFactor(deviceScaleFactor(renderer()->frame()));
+
     PaintLayerFlags paintLayerFlags = 0;
     if (graphicsLayerPaintingPhase & GraphicsLayerPaintBackground)
         paintLayerFlags |= PaintLayerPaintingCompositingBackgroundPhase;
@@ -106,6 +106,8 @@ void CompositingInputsUpdater::updateRecursive(RenderLayer* layer, UpdateType up
     }
 
     if (updateType == ForceUpdate) {
+        layer->setNeedsCompositingRequirementsUpdate();
+
         RenderLayer::AncestorDependentCompositingInputs properties;
 
         if (!layer->isRootLayer()) {
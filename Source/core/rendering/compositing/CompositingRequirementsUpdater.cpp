@@ -31,16 +31,32 @@
 #include "core/rendering/RenderLayerStackingNodeIterator.h"
 #include "core/rendering/RenderView.h"
 #include "core/rendering/compositing/RenderLayerCompositor.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/TraceEvent.h"
+#include "wtf/HashMap.h"
+#include "wtf/OwnPtr.h"
 
 namespace blink {
 
+// Holds the bounds of the layers painted so far in one overlap testing
+// context. Once a context holds more than a handful of rects they are also
+// bucketed into a uniform grid, so that testing a layer only looks at the
+// rects that share a cell with it instead of at every rect in the context.
 class OverlapMapContainer {
 public:
+    OverlapMapContainer()
+        : m_hasGrid(false)
+    {
+    }
+
     void add(const IntRect& bounds)
     {
         m_layerRects.append(bounds);
         m_boundingBox.unite(bounds);
+        if (m_hasGrid)
+            addToGrid(m_layerRects.size() - 1);
+        else if (m_layerRects.size() > minimumRectsForGrid)
+            buildGrid();
     }
 
     bool overlapsLayers(const IntRect& bounds) const
@@ -50,21 +66,104 @@ public:
         // never overlap with each other.
         if (!bounds.intersects(m_boundingBox))
             return false;
-        for (unsigned i = 0; i < m_layerRects.size(); i++) {
-            if (m_layerRects[i].intersects(bounds))
+
+        IntRect cells;
+        if (!m_hasGrid || !cellsForRect(bounds, cells)) {
+            for (unsigned i = 0; i < m_layerRects.size(); i++) {
+                if (m_layerRects[i].intersects(bounds))
+                    return true;
+            }
+            return false;
+        }
+
+        for (unsigned i = 0; i < m_largeRects.size(); i++) {
+            if (m_layerRects[m_largeRects[i]].intersects(bounds))
                 return true;
         }
+        for (int y = cells.y(); y < cells.maxY(); ++y) {
+            for (int x = cells.x(); x < cells.maxX(); ++x) {
+                Grid::const_iterator it = m_grid.find(cellKey(x, y));
+                if (it == m_grid.end())
+                    continue;
+                const Vector<unsigned>& cell = it->value;
+                for (unsigned i = 0; i < cell.size(); i++) {
+                    if (m_layerRects[cell[i]].intersects(bounds))
+                        return true;
+                }
+            }
+        }
         return false;
     }
 
     void unite(const OverlapMapContainer& otherContainer)
     {
-        m_layerRects.appendVector(otherContainer.m_layerRects);
-        m_boundingBox.unite(otherContainer.m_boundingBox);
+        for (unsigned i = 0; i < otherContainer.m_layerRects.size(); i++)
+            add(otherContainer.m_layerRects[i]);
     }
+
+    const Vector<IntRect, 64>& layerRects() const { return m_layerRects; }
+
 private:
+    // Below this many rects a linear scan beats maintaining the grid.
+    static const unsigned minimumRectsForGrid = 16;
+    static const int cellSize = 256;
+    // Rects spanning more cells than this are kept out of the grid and
+    // always tested, and queries spanning more cells scan linearly.
+    static const int maximumCellsPerRect = 64;
+
+    typedef HashMap<uint64_t, Vector<unsigned> > Grid;
+
+    static int cellCoordinate(int coordinate)
+    {
+        // Round towards negative infinity so that negative offsets get their own cells.
+        return coordinate >= 0 ? coordinate / cellSize : -((-coordinate - 1) / cellSize) - 1;
+    }
+
+    static bool cellsForRect(const IntRect& rect, IntRect& cells)
+    {
+        if (rect.isEmpty())
+            return false;
+        int minX = cellCoordinate(rect.x());
+        int minY = cellCoordinate(rect.y());
+        cells = IntRect(minX, minY, cellCoordinate(rect.maxX() - 1) - minX + 1, cellCoordinate(rect.maxY() - 1) - minY + 1);
+        return cells.width() <= maximumCellsPerRect && cells.height() <= maximumCellsPerRect && cells.width() * cells.height() <= maximumCellsPerRect;
+    }
+
+    static uint64_t cellKey(int x, int y)
+    {
+        // Cell coordinates fit in 24 bits, so biasing them keeps the key
+        // clear of the hash table's empty (0) and deleted (all ones) values.
+        const int bias = 1 << 24;
+        return (static_cast<uint64_t>(x + bias) << 32) | static_cast<uint32_t>(y + bias);
+    }
+
+    void buildGrid()
+    {
+        ASSERT(!m_hasGrid);
+        m_hasGrid = true;
+        for (unsigned i = 0; i < m_layerRects.size(); i++)
+            addToGrid(i);
+    }
+
+    void addToGrid(unsigned index)
+    {
+        IntRect cells;
+        if (!cellsForRect(m_layerRects[index], cells)) {
+            if (!m_layerRects[index].isEmpty())
+                m_largeRects.append(index);
+            return;
+        }
+        for (int y = cells.y(); y < cells.maxY(); ++y) {
+            for (int x = cells.x(); x < cells.maxX(); ++x)
+                m_grid.add(cellKey(x, y), Vector<unsigned>()).storedValue->value.append(index);
+        }
+    }
+
     Vector<IntRect, 64> m_layerRects;
     IntRect m_boundingBox;
+    Grid m_grid;
+    Vector<unsigned> m_largeRects;
+    bool m_hasGrid;
 };
 
 class CompositingRequirementsUpdater::OverlapMap {
@@ -88,7 +187,7 @@ public:
         // contribute to overlap as soon as they have been recursively processed
         // and popped off the stack.
         ASSERT(m_overlapStack.size() >= 2);
-        m_overlapStack[m_overlapStack.size() - 2].add(bounds);
+        addToContext(m_overlapStack.size() - 2, bounds);
     }
 
     bool overlapsLayers(const IntRect& bounds) const
@@ -96,6 +195,41 @@ public:
         return m_overlapStack.last().overlapsLayers(bounds);
     }
 
+    // The rects added to the current context so far, including those merged
+    // in from finished nested contexts.
+    const Vector<IntRect, 64>& currentContextRects() const
+    {
+        return m_overlapStack.last().layerRects();
+    }
+
+    void addToCurrentContext(const Vector<IntRect>& rects)
+    {
+        for (unsigned i = 0; i < rects.size(); ++i)
+            addToContext(m_overlapStack.size() - 1, rects[i]);
+    }
+
+    // Non-composited layers add their bounds to the context below the top of
+    // the stack. While recording, the rects added to the context below the
+    // current one are also appended to the given vector, so that they can be
+    // replayed with addToParentContext().
+    void beginRecordingParentContext(Vector<IntRect>& rects)
+    {
+        ASSERT(m_overlapStack.size() >= 2);
+        m_recordings.append(Recording(m_overlapStack.size() - 2, &rects));
+    }
+
+    void finishRecordingParentContext()
+    {
+        m_recordings.removeLast();
+    }
+
+    void addToParentContext(const Vector<IntRect>& rects)
+    {
+        ASSERT(m_overlapStack.size() >= 2);
+        for (unsigned i = 0; i < rects.size(); ++i)
+            addToContext(m_overlapStack.size() - 2, rects[i]);
+    }
+
     void beginNewOverlapTestingContext()
     {
         // This effectively creates a new "clean slate" for overlap state.
@@ -118,7 +252,30 @@ public:
     }
 
 private:
+    struct Recording {
+        Recording(size_t contextIndex, Vector<IntRect>* rects)
+            : contextIndex(contextIndex)
+            , rects(rects)
+        {
+        }
+
+        size_t contextIndex;
+        Vector<IntRect>* rects;
+    };
+
+    void addToContext(size_t contextIndex, const IntRect& bounds)
+    {
+        m_overlapStack[contextIndex].add(bounds);
+        // Subtrees being recorded may be nested, and one replayed inside another
+        // has to be recorded again by the outer one.
+        for (unsigned i = 0; i < m_recordings.size(); ++i) {
+            if (m_recordings[i].contextIndex == contextIndex)
+                m_recordings[i].rects->append(bounds);
+        }
+    }
+
     Vector<OverlapMapContainer> m_overlapStack;
+    Vector<Recording> m_recordings;
 };
 
 class CompositingRequirementsUpdater::RecursionData {
@@ -178,6 +335,7 @@ static CompositingReasons subtreeReasonsForCompositing(RenderLayer* layer, bool
 CompositingRequirementsUpdater::CompositingRequirementsUpdater(RenderView& renderView, CompositingReasonFinder& compositingReasonFinder)
     : m_renderView(renderView)
     , m_compositingReasonFinder(compositingReasonFinder)
+    , m_reuseUnchangedSubtrees(false)
 {
 }
 
@@ -185,10 +343,12 @@ CompositingRequirementsUpdater::~CompositingRequirementsUpdater()
 {
 }
 
-void CompositingRequirementsUpdater::update(RenderLayer* root)
+void CompositingRequirementsUpdater::update(RenderLayer* root, SubtreeReuse subtreeReuse)
 {
     TRACE_EVENT0("blink", "CompositingRequirementsUpdater::updateRecursive");
 
+    m_reuseUnchangedSubtrees = subtreeReuse == ReuseUnchangedSubtrees && RuntimeEnabledFeatures::compositingDecisionCachingEnabled();
+
     // Go through the layers in presentation order, so that we can compute which RenderLayers need compositing layers.
     // FIXME: we could maybe do this and the hierarchy udpate in one pass, but the parenting logic would be more complex.
     RecursionData recursionData(root);
@@ -202,6 +362,8 @@ void CompositingRequirementsUpdater::update(RenderLayer* root)
     Vector<RenderLayer*> unclippedDescendants;
     IntRect absoluteDecendantBoundingBox;
     updateRecursive(0, root, overlapTestRequestMap, recursionData, saw3DTransform, unclippedDescendants, absoluteDecendantBoundingBox);
+
+    root->clearNeedsCompositingRequirementsUpdate();
 }
 
 void CompositingRequirementsUpdater::updateRecursive(RenderLayer* ancestorLayer, RenderLayer* layer, OverlapMap& overlapMap, RecursionData& currentRecursionData, bool& descendantHas3DTransform, Vector<RenderLayer*>& unclippedDescendants, IntRect& absoluteDecendantBoundingBox)
@@ -288,56 +450,102 @@ void CompositingRequirementsUpdater::updateRecursive(RenderLayer* ancestorLayer,
 #endif
 
     bool anyDescendantHas3DTransform = false;
-    bool willHaveForegroundLayer = false;
 
-    if (layer->stackingNode()->isStackingContext()) {
-        RenderLayerStackingNodeIterator iterator(*layer->stackingNode(), NegativeZOrderChildren);
-        while (RenderLayerStackingNode* curNode = iterator.next()) {
-            IntRect absoluteChildDecendantBoundingBox;
-            updateRecursive(layer, curNode->layer(), overlapMap, childRecursionData, anyDescendantHas3DTransform, unclippedDescendants, absoluteChildDecendantBoundingBox);
-            absoluteDecendantBoundingBox.unite(absoluteChildDecendantBoundingBox);
-
-            // If we have to make a layer for this child, make one now so we can have a contents layer
-            // (since we need to ensure that the -ve z-order child renders underneath our contents).
-            if (childRecursionData.m_subtreeIsCompositing) {
-                reasonsToComposite |= CompositingReasonNegativeZIndexChildren;
-
-                if (!willBeCompositedOrSquashed) {
-                    // make layer compositing
-                    childRecursionData.m_compositingAncestor = layer;
-                    overlapMap.beginNewOverlapTestingContext();
-                    willBeCompositedOrSquashed = true;
-                    willHaveForegroundLayer = true;
-
-                    // FIXME: temporary solution for the first negative z-index composited child:
-                    //        re-compute the absBounds for the child so that we can add the
-                    //        negative z-index child's bounds to the new overlap context.
-                    overlapMap.beginNewOverlapTestingContext();
-                    overlapMap.add(curNode->layer(), curNode->layer()->clippedAbsoluteBoundingBox());
-                    overlapMap.finishCurrentOverlapTestingContext();
+    // A layer composited for direct reasons gives its descendants a fresh
+    // overlap testing context, so what they compute depends only on the
+    // subtree itself and can be reused while none of its layers change.
+    bool canReuseSubtree = m_reuseUnchangedSubtrees && !layer->isRootLayer() && willBeCompositedOrSquashed
+        && requiresCompositingOrSquashing(directReasons) && !compositor->preferCompositingToLCDTextEnabled();
+    CompositedSubtreeRequirements* subtreeRequirements = canReuseSubtree ? layer->compositedSubtreeRequirements() : 0;
+    if (subtreeRequirements && !layer->needsCompositingRequirementsUpdate()
+        && subtreeRequirements->inheritedUnisolatedCompositedBlendingDescendant == childRecursionData.m_hasUnisolatedCompositedBlendingDescendant) {
+        reasonsToComposite |= subtreeRequirements->reasonsFromDescendants;
+        absoluteDecendantBoundingBox.unite(subtreeRequirements->descendantBoundingBox);
+        overlapMap.addToCurrentContext(subtreeRequirements->overlapRects);
+        overlapMap.addToParentContext(subtreeRequirements->parentContextOverlapRects);
+        childRecursionData.m_subtreeIsCompositing = subtreeRequirements->subtreeIsCompositing;
+        childRecursionData.m_hasUnisolatedCompositedBlendingDescendant = subtreeRequirements->hasUnisolatedCompositedBlendingDescendant;
+        childRecursionData.m_testingOverlap = subtreeRequirements->testingOverlap;
+        anyDescendantHas3DTransform = subtreeRequirements->descendantHas3DTransform;
+    } else {
+        bool inheritedUnisolatedCompositedBlendingDescendant = childRecursionData.m_hasUnisolatedCompositedBlendingDescendant;
+        IntRect descendantBoundingBox;
+        bool willHaveForegroundLayer = false;
+
+        // Descendants painting into this layer's backing add their bounds to the
+        // context this layer's own context will be merged into.
+        OwnPtr<CompositedSubtreeRequirements> requirements;
+        if (canReuseSubtree) {
+            requirements = adoptPtr(new CompositedSubtreeRequirements);
+            overlapMap.beginRecordingParentContext(requirements->parentContextOverlapRects);
+        }
+
+        if (layer->stackingNode()->isStackingContext()) {
+            RenderLayerStackingNodeIterator iterator(*layer->stackingNode(), NegativeZOrderChildren);
+            while (RenderLayerStackingNode* curNode = iterator.next()) {
+                IntRect absoluteChildDecendantBoundingBox;
+                updateRecursive(layer, curNode->layer(), overlapMap, childRecursionData, anyDescendantHas3DTransform, unclippedDescendants, absoluteChildDecendantBoundingBox);
+                descendantBoundingBox.unite(absoluteChildDecendantBoundingBox);
+
+                // If we have to make a layer for this child, make one now so we can have a contents layer
+                // (since we need to ensure that the -ve z-order child renders underneath our contents).
+                if (childRecursionData.m_subtreeIsCompositing) {
+                    reasonsToComposite |= CompositingReasonNegativeZIndexChildren;
+
+                    if (!willBeCompositedOrSquashed) {
+                        // make layer compositing
+                        childRecursionData.m_compositingAncestor = layer;
+                        overlapMap.beginNewOverlapTestingContext();
+                        willBeCompositedOrSquashed = true;
+                        willHaveForegroundLayer = true;
+
+                        // FIXME: temporary solution for the first negative z-index composited child:
+                        //        re-compute the absBounds for the child so that we can add the
+                        //        negative z-index child's bounds to the new overlap context.
+                        overlapMap.beginNewOverlapTestingContext();
+                        overlapMap.add(curNode->layer(), curNode->layer()->clippedAbsoluteBoundingBox());
+                        overlapMap.finishCurrentOverlapTestingContext();
+                    }
                 }
             }
         }
-    }
 
-    if (willHaveForegroundLayer) {
-        ASSERT(willBeCompositedOrSquashed);
-        // A foreground layer effectively is a new backing for all subsequent children, so
-        // we don't need to test for overlap with anything behind this. So, we can finish
-        // the previous context that was accumulating rects for the negative z-index
-        // children, and start with a fresh new empty context.
-        overlapMap.finishCurrentOverlapTestingContext();
-        overlapMap.beginNewOverlapTestingContext();
-        // This layer is going to be composited, so children can safely ignore the fact that there's an
-        // animation running behind this layer, meaning they can rely on the overlap map testing again
-        childRecursionData.m_testingOverlap = true;
-    }
+        if (willHaveForegroundLayer) {
+            ASSERT(willBeCompositedOrSquashed);
+            // A foreground layer effectively is a new backing for all subsequent children, so
+            // we don't need to test for overlap with anything behind this. So, we can finish
+            // the previous context that was accumulating rects for the negative z-index
+            // children, and start with a fresh new empty context.
+            overlapMap.finishCurrentOverlapTestingContext();
+            overlapMap.beginNewOverlapTestingContext();
+            // This layer is going to be composited, so children can safely ignore the fact that there's an
+            // animation running behind this layer, meaning they can rely on the overlap map testing again
+            childRecursionData.m_testingOverlap = true;
+        }
+
+        RenderLayerStackingNodeIterator iterator(*layer->stackingNode(), NormalFlowChildren | PositiveZOrderChildren);
+        while (RenderLayerStackingNode* curNode = iterator.next()) {
+            IntRect absoluteChildDecendantBoundingBox;
+            updateRecursive(layer, curNode->layer(), overlapMap, childRecursionData, anyDescendantHas3DTransform, unclippedDescendants, absoluteChildDecendantBoundingBox);
+            descendantBoundingBox.unite(absoluteChildDecendantBoundingBox);
+        }
 
-    RenderLayerStackingNodeIterator iterator(*layer->stackingNode(), NormalFlowChildren | PositiveZOrderChildren);
-    while (RenderLayerStackingNode* curNode = iterator.next()) {
-        IntRect absoluteChildDecendantBoundingBox;
-        updateRecursive(layer, curNode->layer(), overlapMap, childRecursionData, anyDescendantHas3DTransform, unclippedDescendants, absoluteChildDecendantBoundingBox);
-        absoluteDecendantBoundingBox.unite(absoluteChildDecendantBoundingBox);
+        absoluteDecendantBoundingBox.unite(descendantBoundingBox);
+
+        if (canReuseSubtree) {
+            overlapMap.finishRecordingParentContext();
+            requirements->overlapRects.appendVector(overlapMap.currentContextRects());
+            requirements->descendantBoundingBox = descendantBoundingBox;
+            requirements->reasonsFromDescendants = reasonsToComposite & CompositingReasonNegativeZIndexChildren;
+            requirements->inheritedUnisolatedCompositedBlendingDescendant = inheritedUnisolatedCompositedBlendingDescendant;
+            requirements->subtreeIsCompositing = childRecursionData.m_subtreeIsCompositing;
+            requirements->hasUnisolatedCompositedBlendingDescendant = childRecursionData.m_hasUnisolatedCompositedBlendingDescendant;
+            requirements->testingOverlap = childRecursionData.m_testingOverlap;
+            requirements->descendantHas3DTransform = anyDescendantHas3DTransform;
+            layer->setCompositedSubtreeRequirements(requirements.release());
+        } else {
+            layer->setCompositedSubtreeRequirements(nullptr);
+        }
     }
 
     // Now that the subtree has been traversed, we can check for compositing reasons that depended on the state of the subtree.
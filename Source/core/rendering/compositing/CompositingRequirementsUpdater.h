@@ -29,6 +29,8 @@
 
 #include "platform/geometry/IntRect.h"
 #include "platform/graphics/CompositingReasons.h"
+#include "wtf/FastAllocBase.h"
+#include "wtf/Noncopyable.h"
 #include "wtf/Vector.h"
 
 namespace blink {
@@ -37,6 +39,41 @@ class CompositingReasonFinder;
 class RenderLayer;
 class RenderView;
 
+// What the descendants of a layer composited for direct reasons contributed
+// to it the last time compositing requirements were computed. Such a layer
+// starts a fresh overlap testing context, so as long as nothing in its
+// subtree has changed, these values can stand in for walking the subtree.
+class CompositedSubtreeRequirements {
+    WTF_MAKE_NONCOPYABLE(CompositedSubtreeRequirements); WTF_MAKE_FAST_ALLOCATED;
+public:
+    CompositedSubtreeRequirements()
+        : reasonsFromDescendants(CompositingReasonNone)
+        , inheritedUnisolatedCompositedBlendingDescendant(false)
+        , subtreeIsCompositing(false)
+        , hasUnisolatedCompositedBlendingDescendant(false)
+        , testingOverlap(true)
+        , descendantHas3DTransform(false)
+    {
+    }
+
+    // The rects the descendants added to the layer's overlap testing context.
+    Vector<IntRect> overlapRects;
+    // The rects the descendants painting into the layer's backing added to the
+    // context the layer's own context is merged into.
+    Vector<IntRect> parentContextOverlapRects;
+    IntRect descendantBoundingBox;
+    CompositingReasons reasonsFromDescendants;
+
+    // The state the walk of the subtree started from; the results only apply
+    // when it is the same.
+    bool inheritedUnisolatedCompositedBlendingDescendant;
+
+    bool subtreeIsCompositing;
+    bool hasUnisolatedCompositedBlendingDescendant;
+    bool testingOverlap;
+    bool descendantHas3DTransform;
+};
+
 class CompositingRequirementsUpdater {
 public:
     CompositingRequirementsUpdater(RenderView&, CompositingReasonFinder&);
@@ -51,7 +88,15 @@ public:
     //      must be compositing so that its contents render over that child.
     //      This implies that its positive z-index children must also be compositing.
     //
-    void update(RenderLayer* root);
+    //  Subtrees rooted at layers composited for direct reasons are skipped when
+    //  none of their layers changed since the previous update, unless
+    //  RecomputeAllSubtrees is passed.
+    //
+    enum SubtreeReuse {
+        ReuseUnchangedSubtrees,
+        RecomputeAllSubtrees
+    };
+    void update(RenderLayer* root, SubtreeReuse = RecomputeAllSubtrees);
 
 private:
     class OverlapMap;
@@ -61,6 +106,7 @@ private:
 
     RenderView& m_renderView;
     CompositingReasonFinder& m_compositingReasonFinder;
+    bool m_reuseUnchangedSubtrees;
 };
 
 } // namespace blink
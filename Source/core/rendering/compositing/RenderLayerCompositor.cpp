@@ -67,6 +67,7 @@ RenderLayerCompositor::RenderLayerCompositor(RenderView& renderView)
     , m_hasAcceleratedCompositing(true)
     , m_compositing(false)
     , m_rootShouldAlwaysCompositeDirty(true)
+    , m_compositedSubtreeRequirementsAreStale(true)
     , m_needsUpdateFixedBackground(false)
     , m_isTrackingPaintInvalidations(false)
     , m_rootLayerAttachment(RootLayerUnattached)
@@ -99,6 +100,7 @@ void RenderLayerCompositor::setCompositingModeEnabled(bool enable)
         return;
 
     m_compositing = enable;
+    m_compositedSubtreeRequirementsAreStale = true;
 
     // RenderPart::requiresAcceleratedCompositing is used to determine self-paintingness
     // and bases it's return value for frames on the m_compositing bit here.
@@ -147,6 +149,7 @@ void RenderLayerCompositor::updateAcceleratedCompositingSettings()
     m_compositingReasonFinder.updateTriggers();
     m_hasAcceleratedCompositing = m_renderView.document().settings()->acceleratedCompositingEnabled();
     m_rootShouldAlwaysCompositeDirty = true;
+    m_compositedSubtreeRequirementsAreStale = true;
 }
 
 bool RenderLayerCompositor::layerSquashingEnabled() const
@@ -337,7 +340,9 @@ void RenderLayerCompositor::updateIfNeeded()
         CompositingInputsUpdater::assertNeedsCompositingInputsUpdateBitsCleared(updateRoot);
 #endif
 
-        CompositingRequirementsUpdater(m_renderView, m_compositingReasonFinder).update(updateRoot);
+        CompositingRequirementsUpdater::SubtreeReuse subtreeReuse = m_compositedSubtreeRequirementsAreStale ? CompositingRequirementsUpdater::RecomputeAllSubtrees : CompositingRequirementsUpdater::ReuseUnchangedSubtrees;
+        m_compositedSubtreeRequirementsAreStale = false;
+        CompositingRequirementsUpdater(m_renderView, m_compositingReasonFinder).update(updateRoot, subtreeReuse);
 
         CompositingLayerAssigner layerAssigner(this);
         layerAssigner.assign(updateRoot, layersNeedingPaintInvalidation);
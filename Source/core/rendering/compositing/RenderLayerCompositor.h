@@ -226,6 +226,9 @@ private:
     // except the one in updateIfNeeded, then rename this to
     // m_compositingDirty.
     bool m_rootShouldAlwaysCompositeDirty;
+    // Set when a change outside of the layer tree, such as to the compositing
+    // settings or mode, invalidates the requirements cached for subtrees.
+    bool m_compositedSubtreeRequirementsAreStale;
     bool m_needsUpdateFixedBackground;
     bool m_isTrackingPaintInvalidations; // Used for testing.
 
@@ -32,6 +32,7 @@
 #include "core/rendering/RenderListMarker.h"
 #include "core/rendering/RenderObjectInlines.h"
 #include "core/rendering/RenderRubyRun.h"
+#include "core/rendering/TextMeasurementCache.h"
 #include "core/rendering/TextRunConstructor.h"
 #include "core/rendering/break_lines.h"
 #include "core/rendering/line/LineBreaker.h"
@@ -519,12 +520,38 @@ ALWAYS_INLINE float textWidth(RenderText* text, unsigned from, unsigned len, con
     if (isFixedPitch || (!from && len == text->textLength()) || text->style()->hasTextCombine())
         return text->width(from, len, font, xPos, text->style()->direction(), fallbackFonts, &glyphOverflow);
 
+    float width;
+    if (text->widthForLatin1Text(font, from, len, text->style()->direction(), !collapseWhiteSpace, width))
+        return width;
+
+    // The cache only holds widths measured with the text's own font, not the
+    // first-line one.
+    TextMeasurementCache* cache = len && &font == &text->style()->font() ? text->measurementCache() : 0;
+    if (cache && !cache->canCache(collapseWhiteSpace))
+        cache = 0;
+    if (cache && cache->lookup(from, len, width))
+        return width;
+
     TextRun run = constructTextRun(text, font, text, from, len, text->style());
     run.setCharacterScanForCodePath(!text->canUseSimpleFontCodePath());
     run.setUseComplexCodePath(!text->canUseSimpleFontCodePath());
     run.setTabSize(!collapseWhiteSpace, text->style()->tabSize());
     run.setXPos(xPos);
-    return font.width(run, fallbackFonts, &glyphOverflow);
+    if (!cache)
+        return font.width(run, fallbackFonts, &glyphOverflow);
+
+    // Widths which needed fallback fonts aren't cached, since the caller
+    // needs to know about those fonts to compute the line height.
+    HashSet<const SimpleFontData*> runFallbackFonts;
+    width = font.width(run, &runFallbackFonts, &glyphOverflow);
+    if (runFallbackFonts.isEmpty()) {
+        cache->add(from, len, width);
+    } else if (fallbackFonts) {
+        HashSet<const SimpleFontData*>::const_iterator end = runFallbackFonts.end();
+        for (HashSet<const SimpleFontData*>::const_iterator it = runFallbackFonts.begin(); it != end; ++it)
+            fallbackFonts->add(*it);
+    }
+    return width;
 }
 
 inline bool BreakingContext::handleText(WordMeasurements& wordMeasurements, bool& hyphenated)
@@ -118,6 +118,44 @@ void RasterShapeIntervals::initializeBounds()
     }
 }
 
+void RasterShapeIntervals::computeUnionTable() const
+{
+    ASSERT(m_unionTable.isEmpty());
+    unsigned size = m_intervals.size();
+    for (unsigned runLength = 2; runLength <= size; runLength *= 2) {
+        const IntShapeIntervals& shorterRuns = m_unionTable.isEmpty() ? m_intervals : m_unionTable.last();
+        unsigned shorterRunLength = runLength / 2;
+        IntShapeIntervals runs(size - runLength + 1);
+        for (unsigned i = 0; i < runs.size(); ++i) {
+            runs[i] = shorterRuns[i];
+            runs[i].unite(shorterRuns[i + shorterRunLength]);
+        }
+        m_unionTable.append(IntShapeIntervals());
+        m_unionTable.last().swap(runs);
+    }
+}
+
+IntShapeInterval RasterShapeIntervals::unionOfIntervals(int y1, int y2) const
+{
+    ASSERT(y1 < y2 && y1 >= minY() && y2 <= maxY());
+    unsigned begin = y1 + m_offset;
+    unsigned length = y2 - y1;
+    if (length == 1)
+        return m_intervals[begin];
+
+    if (m_unionTable.isEmpty())
+        computeUnionTable();
+
+    // Cover the rows with two, possibly overlapping, power of two long runs.
+    unsigned level = 1;
+    while ((2u << level) <= length)
+        ++level;
+    const IntShapeIntervals& runs = m_unionTable[level - 1];
+    IntShapeInterval result = runs[begin];
+    result.unite(runs[begin + length - (1u << level)]);
+    return result;
+}
+
 void RasterShapeIntervals::buildBoundsPath(Path& path) const
 {
     int maxY = bounds().maxY();
@@ -166,12 +204,10 @@ LineSegment RasterShape::getExcludedInterval(LayoutUnit logicalTop, LayoutUnit l
     y2 = std::min(y2, intervals.bounds().maxY());
     IntShapeInterval excludedInterval;
 
-    if (y1 == y2) {
+    if (y1 == y2)
         excludedInterval = intervals.intervalAt(y1);
-    } else {
-        for (int y = y1; y < y2; y++)
-            excludedInterval.unite(intervals.intervalAt(y));
-    }
+    else
+        excludedInterval = intervals.unionOfIntervals(y1, y2);
 
     // Note: |marginIntervals()| returns end-point exclusive
     // intervals. |excludedInterval.x2()| contains the left-most pixel
@@ -62,6 +62,8 @@ public:
         return m_intervals[y + m_offset];
     }
 
+    IntShapeInterval unionOfIntervals(int y1, int y2) const;
+
     PassOwnPtr<RasterShapeIntervals> computeShapeMarginIntervals(int shapeMargin) const;
 
     void buildBoundsPath(Path&) const;
@@ -72,9 +74,15 @@ private:
     int minY() const { return -m_offset; }
     int maxY() const { return -m_offset + m_intervals.size(); }
 
+    void computeUnionTable() const;
+
     IntRect m_bounds;
     Vector<IntShapeInterval> m_intervals;
     int m_offset;
+
+    // Entry n - 1 holds, for every row, the union of the intervals of the
+    // 2^n rows starting there.
+    mutable Vector<IntShapeIntervals> m_unionTable;
 };
 
 class RasterShape FINAL : public Shape {
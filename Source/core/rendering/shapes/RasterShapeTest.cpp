@@ -0,0 +1,33 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/rendering/shapes/RasterShape.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+TEST(RasterShapeTest, UnionOfIntervalsMatchesUnionOfRows)
+{
+    // A 100px tall shape whose row y spans [50 - y % 7, 50 + y % 11).
+    OwnPtr<RasterShapeIntervals> intervals = adoptPtr(new RasterShapeIntervals(100));
+    for (int y = 0; y < 100; ++y)
+        intervals->intervalAt(y) = IntShapeInterval(50 - y % 7, 50 + y % 11);
+    intervals->initializeBounds();
+
+    for (int y1 = 0; y1 < 100; ++y1) {
+        IntShapeInterval expected;
+        for (int y2 = y1 + 1; y2 <= 100; ++y2) {
+            expected.unite(intervals->intervalAt(y2 - 1));
+            EXPECT_EQ(expected, intervals->unionOfIntervals(y1, y2));
+        }
+    }
+}
+
+} // namespace
+
+} // namespace blink
@@ -35,6 +35,7 @@
 #include "core/page/Page.h"
 #include "platform/RuntimeEnabledFeatures.h"
 #include "platform/Supplementable.h"
+#include "platform/graphics/TiledPictureRasterizer.h"
 #include "platform/text/LocaleToScriptMapping.h"
 
 #define InternalSettingsGuardForSettingsReturn(returnValue) \
@@ -74,6 +75,10 @@ InternalSettings::Backup::Backup(Settings* settings)
     , m_defaultVideoPosterURL(settings->defaultVideoPosterURL())
     , m_originalLayerSquashingEnabled(settings->layerSquashingEnabled())
     , m_originalPseudoClassesInMatchingCriteriaInAuthorShadowTreesEnabled(RuntimeEnabledFeatures::pseudoClassesInMatchingCriteriaInAuthorShadowTreesEnabled())
+    , m_originalParallelRasterizationEnabled(RuntimeEnabledFeatures::parallelRasterizationEnabled())
+    , m_originalRasterizationThreadCount(TiledPictureRasterizer::threadCount())
+    , m_originalCompositingDecisionCachingEnabled(RuntimeEnabledFeatures::compositingDecisionCachingEnabled())
+    , m_originalDisplayList2dCanvasEnabled(RuntimeEnabledFeatures::displayList2dCanvasEnabled())
 {
 }
 
@@ -96,6 +101,10 @@ void InternalSettings::Backup::restoreTo(Settings* settings)
     settings->setLayerSquashingEnabled(m_originalLayerSquashingEnabled);
     settings->genericFontFamilySettings().reset();
     RuntimeEnabledFeatures::setPseudoClassesInMatchingCriteriaInAuthorShadowTreesEnabled(m_originalPseudoClassesInMatchingCriteriaInAuthorShadowTreesEnabled);
+    RuntimeEnabledFeatures::setParallelRasterizationEnabled(m_originalParallelRasterizationEnabled);
+    TiledPictureRasterizer::setThreadCount(m_originalRasterizationThreadCount);
+    RuntimeEnabledFeatures::setCompositingDecisionCachingEnabled(m_originalCompositingDecisionCachingEnabled);
+    RuntimeEnabledFeatures::setDisplayList2dCanvasEnabled(m_originalDisplayList2dCanvasEnabled);
 }
 
 #if ENABLE(OILPAN)
@@ -202,6 +211,26 @@ void InternalSettings::setOverlayScrollbarsEnabled(bool enabled)
     RuntimeEnabledFeatures::setOverlayScrollbarsEnabled(enabled);
 }
 
+void InternalSettings::setParallelRasterizationEnabled(bool enabled)
+{
+    RuntimeEnabledFeatures::setParallelRasterizationEnabled(enabled);
+}
+
+void InternalSettings::setRasterizationThreadCount(unsigned count)
+{
+    TiledPictureRasterizer::setThreadCount(count);
+}
+
+void InternalSettings::setCompositingDecisionCachingEnabled(bool enabled)
+{
+    RuntimeEnabledFeatures::setCompositingDecisionCachingEnabled(enabled);
+}
+
+void InternalSettings::setDisplayList2dCanvasEnabled(bool enabled)
+{
+    RuntimeEnabledFeatures::setDisplayList2dCanvasEnabled(enabled);
+}
+
 void InternalSettings::setViewportEnabled(bool enabled, ExceptionState& exceptionState)
 {
     InternalSettingsGuardForSettings();
@@ -72,6 +72,10 @@ public:
         String m_defaultVideoPosterURL;
         bool m_originalLayerSquashingEnabled;
         bool m_originalPseudoClassesInMatchingCriteriaInAuthorShadowTreesEnabled;
+        bool m_originalParallelRasterizationEnabled;
+        unsigned m_originalRasterizationThreadCount;
+        bool m_originalCompositingDecisionCachingEnabled;
+        bool m_originalDisplayList2dCanvasEnabled;
     };
 
     static PassRefPtrWillBeRawPtr<InternalSettings> create(Page& page)
@@ -119,6 +123,10 @@ public:
     void setExperimentalContentSecurityPolicyFeaturesEnabled(bool);
     void setPseudoClassesInMatchingCriteriaInAuthorShadowTreesEnabled(bool);
     void setLaxMixedContentCheckingEnabled(bool);
+    void setParallelRasterizationEnabled(bool);
+    void setCompositingDecisionCachingEnabled(bool);
+    void setDisplayList2dCanvasEnabled(bool);
+    void setRasterizationThreadCount(unsigned);
 
     virtual void trace(Visitor*) OVERRIDE;
 
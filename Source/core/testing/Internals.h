@@ -55,6 +55,7 @@ class Element;
 class ExceptionState;
 class ExecutionContext;
 class GCObservation;
+class HTMLCanvasElement;
 class HTMLElement;
 class HTMLMediaElement;
 class InternalProfilers;
@@ -319,6 +320,7 @@ public:
     void hideAllTransitionElements();
 
     unsigned countHitRegions(CanvasRenderingContext2D*);
+    bool isCanvasRecording(HTMLCanvasElement*);
 
     void forcePluginPlaceholder(HTMLElement* plugin, const String& htmlSource, ExceptionState&);
     void forcePluginPlaceholder(HTMLElement* plugin, const Dictionary& options, ExceptionState&);
@@ -40,17 +40,6 @@
 namespace blink {
 
 static const unsigned segmentSize = 0x1000;
-static const unsigned segmentPositionMask = 0x0FFF;
-
-static inline unsigned segmentIndex(unsigned position)
-{
-    return position / segmentSize;
-}
-
-static inline unsigned offsetInSegment(unsigned position)
-{
-    return position & segmentPositionMask;
-}
 
 static inline char* allocateSegment()
 {
@@ -219,6 +208,13 @@ PassRefPtr<SharedBuffer> SharedBuffer::adoptVector(Vector<char>& vector)
     return buffer.release();
 }
 
+PassRefPtr<SharedBuffer> SharedBuffer::adoptExternalMemory(PassRefPtr<ExternalMemory> memory)
+{
+    RefPtr<SharedBuffer> buffer = create();
+    buffer->append(memory);
+    return buffer.release();
+}
+
 unsigned SharedBuffer::size() const
 {
     return m_size;
@@ -226,17 +222,26 @@ unsigned SharedBuffer::size() const
 
 const char* SharedBuffer::data() const
 {
+    // A buffer made of a single piece of external memory, typically a
+    // memory-mapped file, is already contiguous.
+    if (!m_buffer.size() && m_segments.size() == 1 && m_segments[0].external)
+        return m_segments[0].data;
+
     mergeSegmentsIntoBuffer();
     return m_buffer.data();
 }
 
 void SharedBuffer::append(PassRefPtr<SharedBuffer> data)
 {
-    const char* segment;
-    size_t position = 0;
-    while (size_t length = data->getSomeData(segment, position)) {
-        append(segment, length);
-        position += length;
+    RefPtr<SharedBuffer> buffer = data;
+    ASSERT(buffer != this);
+    append(buffer->m_buffer.data(), buffer->m_buffer.size());
+    for (size_t i = 0; i < buffer->m_segments.size(); ++i) {
+        const Segment& segment = buffer->m_segments[i];
+        if (segment.external)
+            append(segment.external);
+        else
+            append(segment.data, segment.size);
     }
 }
 
@@ -247,35 +252,32 @@ void SharedBuffer::append(const char* data, unsigned length)
         return;
 
     ASSERT(m_size >= m_buffer.size());
-    unsigned positionInSegment = offsetInSegment(m_size - m_buffer.size());
     m_size += length;
 
-    if (m_size <= segmentSize) {
+    if (m_segments.isEmpty() && m_size <= segmentSize) {
         // No need to use segments for small resource data.
         m_buffer.append(data, length);
         return;
     }
 
-    char* segment;
-    if (!positionInSegment) {
-        segment = allocateSegment();
-        m_segments.append(segment);
-    } else
-        segment = m_segments.last() + positionInSegment;
-
-    unsigned segmentFreeSpace = segmentSize - positionInSegment;
-    unsigned bytesToCopy = std::min(length, segmentFreeSpace);
-
-    for (;;) {
-        memcpy(segment, data, bytesToCopy);
-        if (static_cast<unsigned>(length) == bytesToCopy)
-            break;
-
-        length -= bytesToCopy;
+    if (!m_segments.isEmpty() && !m_segments.last().external && m_segments.last().size < segmentSize) {
+        // Fill up the last segment first.
+        Segment& last = m_segments.last();
+        unsigned bytesToCopy = std::min(length, segmentSize - last.size);
+        memcpy(last.data + last.size, data, bytesToCopy);
+        last.size += bytesToCopy;
         data += bytesToCopy;
-        segment = allocateSegment();
-        m_segments.append(segment);
-        bytesToCopy = std::min(length, segmentSize);
+        length -= bytesToCopy;
+    }
+
+    while (length) {
+        Segment segment;
+        segment.data = allocateSegment();
+        segment.size = std::min(length, segmentSize);
+        memcpy(segment.data, data, segment.size);
+        data += segment.size;
+        length -= segment.size;
+        appendSegment(segment);
     }
 }
 
@@ -284,12 +286,52 @@ void SharedBuffer::append(const Vector<char>& data)
     append(data.data(), data.size());
 }
 
-void SharedBuffer::clear()
+void SharedBuffer::append(PassRefPtr<ExternalMemory> memory)
+{
+    ASSERT(isLocked());
+    if (!memory || !memory->size())
+        return;
+
+    Segment segment;
+    // External memory is never written to; the segment only needs a
+    // mutable pointer because owned segments are filled in place.
+    segment.data = const_cast<char*>(memory->data());
+    segment.size = memory->size();
+    segment.external = memory;
+    m_size += segment.size;
+    appendSegment(segment);
+}
+
+void SharedBuffer::appendSegment(const Segment& segment)
+{
+    m_segments.append(segment);
+    if (m_segments.size() > 1) {
+        const Segment& previous = m_segments[m_segments.size() - 2];
+        m_segments.last().offset = previous.offset + previous.size;
+    }
+}
+
+bool SharedBuffer::hasOwnedSegments() const
 {
-    for (unsigned i = 0; i < m_segments.size(); ++i)
-        freeSegment(m_segments[i]);
+    for (size_t i = 0; i < m_segments.size(); ++i) {
+        if (!m_segments[i].external)
+            return true;
+    }
+    return false;
+}
 
+void SharedBuffer::clearSegments() const
+{
+    for (size_t i = 0; i < m_segments.size(); ++i) {
+        if (!m_segments[i].external)
+            freeSegment(m_segments[i].data);
+    }
     m_segments.clear();
+}
+
+void SharedBuffer::clear()
+{
+    clearSegments();
     m_size = 0;
     m_buffer.clear();
 }
@@ -297,35 +339,56 @@ void SharedBuffer::clear()
 PassRefPtr<SharedBuffer> SharedBuffer::copy() const
 {
     RefPtr<SharedBuffer> clone(adoptRef(new SharedBuffer));
-    clone->m_size = m_size;
-    clone->m_buffer.reserveCapacity(m_size);
+
+    // Copy everything up to the first piece of external memory into a flat
+    // buffer, and share the external memory from there on.
+    size_t firstExternal = 0;
+    unsigned flatSize = m_buffer.size();
+    for (; firstExternal < m_segments.size() && !m_segments[firstExternal].external; ++firstExternal)
+        flatSize += m_segments[firstExternal].size;
+
+    clone->m_size = flatSize;
+    clone->m_buffer.reserveCapacity(flatSize);
     clone->m_buffer.append(m_buffer.data(), m_buffer.size());
-    if (!m_segments.isEmpty()) {
-        const char* segment = 0;
-        unsigned position = m_buffer.size();
-        while (unsigned segmentSize = getSomeData(segment, position)) {
-            clone->m_buffer.append(segment, segmentSize);
-            position += segmentSize;
-        }
-        ASSERT(position == clone->size());
+    for (size_t i = 0; i < firstExternal; ++i)
+        clone->m_buffer.append(m_segments[i].data, m_segments[i].size);
+
+    for (size_t i = firstExternal; i < m_segments.size(); ++i) {
+        if (m_segments[i].external)
+            clone->append(m_segments[i].external);
+        else
+            clone->append(m_segments[i].data, m_segments[i].size);
     }
+    ASSERT(clone->size() == size());
     return clone.release();
 }
 
 void SharedBuffer::mergeSegmentsIntoBuffer() const
 {
-    unsigned bufferSize = m_buffer.size();
-    if (m_size > bufferSize) {
-        m_buffer.reserveCapacity(m_size);
-        unsigned bytesLeft = m_size - bufferSize;
-        for (unsigned i = 0; i < m_segments.size(); ++i) {
-            unsigned bytesToCopy = std::min(bytesLeft, segmentSize);
-            m_buffer.append(m_segments[i], bytesToCopy);
-            bytesLeft -= bytesToCopy;
-            freeSegment(m_segments[i]);
-        }
-        m_segments.clear();
+    if (m_segments.isEmpty())
+        return;
+
+    m_buffer.reserveCapacity(m_size);
+    for (size_t i = 0; i < m_segments.size(); ++i)
+        m_buffer.append(m_segments[i].data, m_segments[i].size);
+    clearSegments();
+    ASSERT(m_buffer.size() == m_size);
+}
+
+size_t SharedBuffer::segmentIndexForPosition(unsigned position) const
+{
+    // Binary search for the last segment starting at or before |position|.
+    ASSERT(!m_segments.isEmpty());
+    size_t low = 0;
+    size_t high = m_segments.size();
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+        if (m_segments[middle].offset <= position)
+            low = middle;
+        else
+            high = middle;
     }
+    return low;
 }
 
 unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) const
@@ -345,19 +408,11 @@ unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) con
     }
 
     position -= consecutiveSize;
-    unsigned segments = m_segments.size();
-    unsigned maxSegmentedSize = segments * segmentSize;
-    unsigned segment = segmentIndex(position);
-    if (segment < segments) {
-        unsigned bytesLeft = totalSize - consecutiveSize;
-        unsigned segmentedSize = std::min(maxSegmentedSize, bytesLeft);
-
-        unsigned positionInSegment = offsetInSegment(position);
-        someData = m_segments[segment] + positionInSegment;
-        return segment == segments - 1 ? segmentedSize - position : segmentSize - positionInSegment;
-    }
-    ASSERT_NOT_REACHED();
-    return 0;
+    const Segment& segment = m_segments[segmentIndexForPosition(position)];
+    unsigned positionInSegment = position - segment.offset;
+    ASSERT_WITH_SECURITY_IMPLICATION(positionInSegment < segment.size);
+    someData = segment.data + positionInSegment;
+    return segment.size - positionInSegment;
 }
 
 PassRefPtr<ArrayBuffer> SharedBuffer::getAsArrayBuffer() const
@@ -410,7 +465,8 @@ bool SharedBuffer::lock()
 
 void SharedBuffer::unlock()
 {
-    mergeSegmentsIntoBuffer();
+    if (hasOwnedSegments())
+        mergeSegmentsIntoBuffer();
     m_buffer.unlock();
 }
 
@@ -34,12 +34,24 @@
 #include "wtf/Forward.h"
 #include "wtf/OwnPtr.h"
 #include "wtf/RefCounted.h"
+#include "wtf/ThreadSafeRefCounted.h"
 #include "wtf/text/WTFString.h"
 
 namespace blink {
 
 class PLATFORM_EXPORT SharedBuffer : public RefCounted<SharedBuffer> {
 public:
+    // Immutable memory that is owned outside of the SharedBuffer, such as a
+    // memory-mapped file or a disk cache entry handed over by the embedder.
+    // It is referenced, not copied, when appended to a SharedBuffer, and it
+    // can be shared by any number of SharedBuffers.
+    class PLATFORM_EXPORT ExternalMemory : public ThreadSafeRefCounted<ExternalMemory> {
+    public:
+        virtual ~ExternalMemory() { }
+        virtual const char* data() const = 0;
+        virtual unsigned size() const = 0;
+    };
+
     static PassRefPtr<SharedBuffer> create() { return adoptRef(new SharedBuffer); }
     static PassRefPtr<SharedBuffer> create(size_t size) { return adoptRef(new SharedBuffer(size)); }
     static PassRefPtr<SharedBuffer> create(const char* c, int i) { return adoptRef(new SharedBuffer(c, i)); }
@@ -48,21 +60,26 @@ public:
     static PassRefPtr<SharedBuffer> createPurgeable(const char* c, int i) { return adoptRef(new SharedBuffer(c, i, PurgeableVector::Purgeable)); }
 
     static PassRefPtr<SharedBuffer> adoptVector(Vector<char>&);
+    static PassRefPtr<SharedBuffer> adoptExternalMemory(PassRefPtr<ExternalMemory>);
 
     ~SharedBuffer();
 
     // Calling this function will force internal segmented buffers to be merged
-    // into a flat buffer. Use getSomeData() whenever possible for better
-    // performance.
+    // into a flat buffer, unless the whole buffer is a single piece of
+    // external memory. Use getSomeData() or SharedBufferChunkReader whenever
+    // possible for better performance.
     const char* data() const;
 
     unsigned size() const;
 
     bool isEmpty() const { return !size(); }
 
+    // Appending another SharedBuffer references its external memory instead
+    // of copying it.
     void append(PassRefPtr<SharedBuffer>);
     void append(const char*, unsigned);
     void append(const Vector<char>&);
+    void append(PassRefPtr<ExternalMemory>);
 
     void clear();
 
@@ -97,6 +114,8 @@ public:
     // WARNING: Calling unlock() on a SharedBuffer that wasn't created with the
     // purgeability option does an extra memcpy(). Please use
     // SharedBuffer::createPurgeable() if you intend to call unlock().
+    // External memory is left alone, since its owner decides whether it can
+    // be discarded (a memory-mapped file can always be paged out).
     void unlock();
 
     bool isLocked() const;
@@ -108,12 +127,27 @@ private:
     SharedBuffer(const char*, int, PurgeableVector::PurgeableOption);
     SharedBuffer(const unsigned char*, int);
 
+    // Data past m_buffer is kept in an ordered list of segments. A segment
+    // either points into a fixed size block allocated and owned by the
+    // SharedBuffer, or into external memory it holds a reference to.
+    struct Segment {
+        Segment() : data(0), size(0), offset(0) { }
+        char* data;
+        unsigned size;
+        unsigned offset; // Position of the first byte, relative to the end of m_buffer.
+        RefPtr<ExternalMemory> external;
+    };
+
     // See SharedBuffer::data().
     void mergeSegmentsIntoBuffer() const;
+    void appendSegment(const Segment&);
+    bool hasOwnedSegments() const;
+    void clearSegments() const;
+    size_t segmentIndexForPosition(unsigned position) const;
 
     unsigned m_size;
     mutable PurgeableVector m_buffer;
-    mutable Vector<char*> m_segments;
+    mutable Vector<Segment> m_segments;
 };
 
 } // namespace blink
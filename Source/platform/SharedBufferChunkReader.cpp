@@ -35,7 +35,18 @@
 
 namespace blink {
 
-SharedBufferChunkReader::SharedBufferChunkReader(SharedBuffer* buffer, const Vector<char>& separator)
+SharedBufferChunkReader::SharedBufferChunkReader(const SharedBuffer* buffer)
+    : m_buffer(buffer)
+    , m_bufferPosition(0)
+    , m_segment(0)
+    , m_segmentLength(0)
+    , m_segmentIndex(0)
+    , m_reachedEndOfFile(false)
+    , m_separatorIndex(0)
+{
+}
+
+SharedBufferChunkReader::SharedBufferChunkReader(const SharedBuffer* buffer, const Vector<char>& separator)
     : m_buffer(buffer)
     , m_bufferPosition(0)
     , m_segment(0)
@@ -47,7 +58,7 @@ SharedBufferChunkReader::SharedBufferChunkReader(SharedBuffer* buffer, const Vec
 {
 }
 
-SharedBufferChunkReader::SharedBufferChunkReader(SharedBuffer* buffer, const char* separator)
+SharedBufferChunkReader::SharedBufferChunkReader(const SharedBuffer* buffer, const char* separator)
     : m_buffer(buffer)
     , m_bufferPosition(0)
     , m_segment(0)
@@ -72,6 +83,7 @@ void SharedBufferChunkReader::setSeparator(const char* separator)
 
 bool SharedBufferChunkReader::nextChunk(Vector<char>& chunk, bool includeSeparator)
 {
+    ASSERT(!m_separator.isEmpty());
     if (m_reachedEndOfFile)
         return false;
 
@@ -41,8 +41,10 @@ class SharedBuffer;
 
 class PLATFORM_EXPORT SharedBufferChunkReader {
 public:
-    SharedBufferChunkReader(SharedBuffer*, const Vector<char>& separator);
-    SharedBufferChunkReader(SharedBuffer*, const char* separator);
+    // For callers that only peek() at the start of the buffer.
+    explicit SharedBufferChunkReader(const SharedBuffer*);
+    SharedBufferChunkReader(const SharedBuffer*, const Vector<char>& separator);
+    SharedBufferChunkReader(const SharedBuffer*, const char* separator);
 
     void setSeparator(const Vector<char>&);
     void setSeparator(const char*);
@@ -58,7 +60,7 @@ public:
     size_t peek(Vector<char>&, size_t);
 
 private:
-    SharedBuffer* m_buffer;
+    const SharedBuffer* m_buffer;
     size_t m_bufferPosition;
     const char* m_segment;
     size_t m_segmentLength;
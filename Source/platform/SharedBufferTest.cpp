@@ -34,6 +34,7 @@
 #include <cstdlib>
 
 #include "platform/SharedBuffer.h"
+#include "platform/SharedBufferChunkReader.h"
 #include "platform/TestingPlatformSupport.h"
 #include "public/platform/WebDiscardableMemory.h"
 
@@ -154,4 +155,123 @@ TEST(SharedBufferTest, createPurgeable)
     ASSERT_EQ(0, memcmp(data, testData.data(), length));
 }
 
+class TestExternalMemory : public SharedBuffer::ExternalMemory {
+public:
+    static PassRefPtr<TestExternalMemory> create(const char* data, unsigned size, bool* destroyed = 0)
+    {
+        return adoptRef(new TestExternalMemory(data, size, destroyed));
+    }
+
+    virtual ~TestExternalMemory()
+    {
+        if (m_destroyed)
+            *m_destroyed = true;
+    }
+
+    virtual const char* data() const OVERRIDE { return m_data.data(); }
+    virtual unsigned size() const OVERRIDE { return m_data.size(); }
+
+private:
+    TestExternalMemory(const char* data, unsigned size, bool* destroyed)
+        : m_destroyed(destroyed)
+    {
+        m_data.append(data, size);
+    }
+
+    Vector<char> m_data;
+    bool* m_destroyed;
+};
+
+TEST(SharedBufferTest, externalMemoryIsNotCopied)
+{
+    Vector<char> testData(10000);
+    std::generate(testData.begin(), testData.end(), &std::rand);
+
+    bool destroyed = false;
+    RefPtr<TestExternalMemory> memory = TestExternalMemory::create(testData.data(), testData.size(), &destroyed);
+    const char* externalData = memory->data();
+    RefPtr<SharedBuffer> sharedBuffer = SharedBuffer::adoptExternalMemory(memory.release());
+    ASSERT_EQ(testData.size(), sharedBuffer->size());
+
+    const char* data;
+    EXPECT_EQ(testData.size(), sharedBuffer->getSomeData(data, 0));
+    EXPECT_EQ(externalData, data);
+    EXPECT_EQ(externalData, sharedBuffer->data());
+
+    // Unlocking must not merge external memory into an owned buffer.
+    sharedBuffer->unlock();
+    EXPECT_EQ(externalData, sharedBuffer->data());
+
+    sharedBuffer.clear();
+    EXPECT_TRUE(destroyed);
+}
+
+TEST(SharedBufferTest, appendMixedSegments)
+{
+    Vector<char> testData(20000);
+    std::generate(testData.begin(), testData.end(), &std::rand);
+
+    RefPtr<SharedBuffer> sharedBuffer = SharedBuffer::create(testData.data(), 3000);
+    sharedBuffer->append(TestExternalMemory::create(testData.data() + 3000, 5000));
+    sharedBuffer->append(testData.data() + 8000, 6000);
+    sharedBuffer->append(TestExternalMemory::create(testData.data() + 14000, 6000));
+    ASSERT_EQ(testData.size(), sharedBuffer->size());
+
+    Vector<char> gathered;
+    const char* segment;
+    while (unsigned length = sharedBuffer->getSomeData(segment, gathered.size()))
+        gathered.append(segment, length);
+    ASSERT_EQ(testData.size(), gathered.size());
+    EXPECT_EQ(0, memcmp(gathered.data(), testData.data(), testData.size()));
+
+    // Random access into the middle of each kind of segment.
+    EXPECT_EQ(1000u, sharedBuffer->getSomeData(segment, 7000));
+    EXPECT_EQ(0, memcmp(segment, testData.data() + 7000, 1000));
+    EXPECT_EQ(1000u, sharedBuffer->getSomeData(segment, 19000));
+    EXPECT_EQ(0, memcmp(segment, testData.data() + 19000, 1000));
+
+    EXPECT_EQ(0, memcmp(sharedBuffer->data(), testData.data(), testData.size()));
+}
+
+TEST(SharedBufferTest, copySharesExternalMemory)
+{
+    Vector<char> testData(12000);
+    std::generate(testData.begin(), testData.end(), &std::rand);
+
+    RefPtr<SharedBuffer> sharedBuffer = SharedBuffer::create(testData.data(), 2000);
+    RefPtr<TestExternalMemory> memory = TestExternalMemory::create(testData.data() + 2000, 10000);
+    const char* externalData = memory->data();
+    sharedBuffer->append(memory.release());
+
+    RefPtr<SharedBuffer> clone = sharedBuffer->copy();
+    ASSERT_EQ(testData.size(), clone->size());
+    const char* segment;
+    EXPECT_EQ(10000u, clone->getSomeData(segment, 2000));
+    EXPECT_EQ(externalData, segment);
+    EXPECT_EQ(0, memcmp(clone->data(), testData.data(), testData.size()));
+}
+
+TEST(SharedBufferTest, chunkReaderAcrossExternalSegments)
+{
+    const char testData[] = "first line\r\nsecond line\r\nthird";
+    const unsigned length = sizeof(testData) - 1;
+
+    // Split the data so that lines and the separator straddle owned and
+    // external segments.
+    RefPtr<SharedBuffer> sharedBuffer = SharedBuffer::create(testData, 6);
+    sharedBuffer->append(TestExternalMemory::create(testData + 6, 6));
+    sharedBuffer->append(testData + 12, 10);
+    sharedBuffer->append(TestExternalMemory::create(testData + 22, length - 22));
+
+    Vector<char> peeked;
+    EXPECT_EQ(14u, SharedBufferChunkReader(sharedBuffer.get()).peek(peeked, 14));
+    EXPECT_EQ(0, memcmp(peeked.data(), testData, 14));
+
+    SharedBufferChunkReader reader(sharedBuffer.get(), "\r\n");
+    EXPECT_EQ("first line", reader.nextChunkAsUTF8StringWithLatin1Fallback());
+    EXPECT_EQ("second line", reader.nextChunkAsUTF8StringWithLatin1Fallback());
+    EXPECT_EQ("third", reader.nextChunkAsUTF8StringWithLatin1Fallback());
+    EXPECT_TRUE(reader.nextChunkAsUTF8StringWithLatin1Fallback().isNull());
+}
+
 } // namespace
@@ -33,8 +33,29 @@
 
 #include "platform/SharedBuffer.h"
 
+#include <limits>
+
 namespace blink {
 
+namespace {
+
+class WebExternalMemory FINAL : public SharedBuffer::ExternalMemory {
+public:
+    explicit WebExternalMemory(PassOwnPtr<WebData::ExternalMemory> memory)
+        : m_memory(memory)
+    {
+        RELEASE_ASSERT(m_memory->size() <= std::numeric_limits<unsigned>::max());
+    }
+
+    virtual const char* data() const OVERRIDE { return m_memory->data(); }
+    virtual unsigned size() const OVERRIDE { return static_cast<unsigned>(m_memory->size()); }
+
+private:
+    OwnPtr<WebData::ExternalMemory> m_memory;
+};
+
+} // namespace
+
 void WebData::reset()
 {
     m_private.reset();
@@ -50,6 +71,11 @@ void WebData::assign(const char* data, size_t size)
     m_private = SharedBuffer::create(data, size);
 }
 
+void WebData::assign(ExternalMemory* memory)
+{
+    m_private = SharedBuffer::adoptExternalMemory(adoptRef(new WebExternalMemory(adoptPtr(memory))));
+}
+
 size_t WebData::size() const
 {
     if (m_private.isNull())
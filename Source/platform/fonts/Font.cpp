@@ -191,6 +191,43 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
     return result;
 }
 
+bool Font::widthForLatin1Text(const LChar* characters, unsigned length, bool allowTabs, float& width) const
+{
+    // Anything that would send an 8-bit run down the complex path, or make
+    // the simple path do more than add up advances, disqualifies the font.
+    if (s_codePath == ComplexPath)
+        return false;
+    const FontDescription& description = fontDescription();
+    if ((description.featureSettings() && description.featureSettings()->size() > 0)
+        || description.widthVariant() != RegularWidth
+        || (length > 1 && description.typesettingFeatures())
+        || description.textRendering() == OptimizeLegibility || description.textRendering() == GeometricPrecision
+        || description.letterSpacing() || description.wordSpacing()
+        || description.variant() != FontVariantNormal)
+        return false;
+
+    const FontData* fontData = fontDataAt(0);
+    if (!fontData || fontData->isSegmented())
+        return false;
+    const SimpleFontData* simpleFontData = toSimpleFontData(fontData);
+    if (simpleFontData->isSVGFont())
+        return false;
+    const float* advances = simpleFontData->latin1Advances();
+    if (!advances)
+        return false;
+
+    float result = 0;
+    for (unsigned i = 0; i < length; ++i) {
+        LChar character = characters[i];
+        float advance = advances[character];
+        if (advance < 0 || (character == '\t' && allowTabs))
+            return false;
+        result += advance;
+    }
+    width = result;
+    return true;
+}
+
 float Font::width(const TextRun& run, int& charsConsumed, Glyph& glyphId) const
 {
 #if ENABLE(SVG_FONTS)
@@ -106,6 +106,11 @@ public:
     float width(const TextRun&, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0) const;
     float width(const TextRun&, int& charsConsumed, Glyph& glyphId) const;
 
+    // Measures left-to-right 8-bit text by summing the primary font's Latin-1
+    // advances, without building a TextRun. Returns false when the font or
+    // the text needs the full simple or complex path.
+    bool widthForLatin1Text(const LChar*, unsigned length, bool allowTabs, float& width) const;
+
     int offsetForPosition(const TextRun&, float position, bool includePartialGlyphs) const;
     FloatRect selectionRectForText(const TextRun&, const FloatPoint&, int h, int from = 0, int to = -1, bool accountForGlyphBounds = false) const;
 
@@ -29,6 +29,9 @@
 
 #include "platform/fonts/Character.h"
 #include "platform/fonts/Font.h"
+#include "platform/fonts/FontDescription.h"
+#include "platform/text/TextRun.h"
+#include "wtf/text/WTFString.h"
 
 #include <gtest/gtest.h>
 
@@ -179,6 +182,63 @@ TEST(FontTest, TestCharacterRangeCodePathString)
     EXPECT_EQ(ComplexPath, Character::characterRangeCodePath(c10, 3));
 }
 
+static Font createStandardFont(float letterSpacing = 0, float wordSpacing = 0)
+{
+    FontDescription description;
+    description.setGenericFamily(FontDescription::StandardFamily);
+    description.setSpecifiedSize(16);
+    description.setComputedSize(16);
+    description.setLetterSpacing(letterSpacing);
+    description.setWordSpacing(wordSpacing);
+    Font font(description);
+    font.update(nullptr);
+    return font;
+}
+
+// Returns whether the Latin-1 fast path measured the text. When it did, its
+// width must be exactly what Font::width gives for the same text.
+static bool TestLatin1WidthMatchesTextRun(const Font& font, const char* text, bool allowTabs = false)
+{
+    String string(text);
+    ASSERT(string.is8Bit());
+    TextRun run(string);
+    run.setTabSize(allowTabs, 8);
+
+    float latin1Width = 0;
+    if (!font.widthForLatin1Text(string.characters8(), string.length(), allowTabs, latin1Width))
+        return false;
+    EXPECT_EQ(font.width(run), latin1Width) << text;
+    return true;
+}
+
+TEST(FontTest, TestLatin1WidthMatchesTextRun)
+{
+    Font font = createStandardFont();
+
+    EXPECT_TRUE(TestLatin1WidthMatchesTextRun(font, ""));
+    EXPECT_TRUE(TestLatin1WidthMatchesTextRun(font, "The quick brown fox jumps over the lazy dog."));
+    EXPECT_TRUE(TestLatin1WidthMatchesTextRun(font, "  leading and trailing spaces  "));
+    EXPECT_TRUE(TestLatin1WidthMatchesTextRun(font, "non\xA0" "breaking\xA0spaces"));
+    EXPECT_TRUE(TestLatin1WidthMatchesTextRun(font, "caf\xE9 na\xEFve \xC5ngstr\xF6m"));
+
+    // Tabs are only measured as glyphs when the run doesn't expand them.
+    TestLatin1WidthMatchesTextRun(font, "tab\tseparated");
+    EXPECT_FALSE(TestLatin1WidthMatchesTextRun(font, "tab\tseparated", true));
+
+    // Zero-width characters: soft hyphen and C0/C1 controls.
+    TestLatin1WidthMatchesTextRun(font, "soft\xADhyphen");
+    TestLatin1WidthMatchesTextRun(font, "control\x01\x1F\x7F\x85" "characters");
+}
+
+TEST(FontTest, TestLatin1WidthRejectsSpacing)
+{
+    const char* text = "letter and word spacing";
+
+    EXPECT_FALSE(TestLatin1WidthMatchesTextRun(createStandardFont(2, 0), text));
+    EXPECT_FALSE(TestLatin1WidthMatchesTextRun(createStandardFont(0, 4), text));
+    EXPECT_FALSE(TestLatin1WidthMatchesTextRun(createStandardFont(2, 4), text));
+}
+
 static void TestSpecificUChar32RangeIdeograph(UChar32 rangeStart, UChar32 rangeEnd)
 {
     EXPECT_FALSE(Character::isCJKIdeograph(rangeStart - 1));
@@ -160,6 +160,24 @@ Glyph SimpleFontData::glyphForCharacter(UChar32 character) const
     return node->page() ? node->page()->glyphAt(character & 0xFF) : 0;
 }
 
+const float* SimpleFontData::latin1Advances() const
+{
+    if (m_latin1Advances)
+        return m_latin1Advances.get();
+    if (platformData().orientation() != Horizontal && !isTextOrientationFallback())
+        return 0;
+
+    // Latin-1 is exactly glyph page zero.
+    COMPILE_ASSERT(GlyphPage::size == 256, GlyphPageZeroIsLatin1);
+    m_latin1Advances = adoptArrayPtr(new float[GlyphPage::size]);
+    GlyphPage* glyphPageZero = GlyphPageTreeNode::getRootChild(this, 0)->page();
+    for (unsigned i = 0; i < GlyphPage::size; ++i) {
+        GlyphData glyphData = glyphPageZero ? glyphPageZero->glyphDataForIndex(i) : GlyphData();
+        m_latin1Advances[i] = glyphData.fontData == this ? widthForGlyph(glyphData.glyph) : -1;
+    }
+    return m_latin1Advances.get();
+}
+
 bool SimpleFontData::isSegmented() const
 {
     return false;
@@ -115,6 +115,11 @@ public:
     FloatRect platformBoundsForGlyph(Glyph) const;
     float platformWidthForGlyph(Glyph) const;
 
+    // The advance of each Latin-1 character, indexed by the character, or a
+    // negative value where the font has no glyph for it. Null if the font's
+    // glyphs aren't laid out horizontally.
+    const float* latin1Advances() const;
+
     float spaceWidth() const { return m_spaceWidth; }
     void setSpaceWidth(float spaceWidth) { m_spaceWidth = spaceWidth; }
 
@@ -187,6 +192,7 @@ private:
 
     mutable OwnPtr<GlyphMetricsMap<FloatRect> > m_glyphToBoundsMap;
     mutable GlyphMetricsMap<float> m_glyphToWidthMap;
+    mutable OwnPtr<float[]> m_latin1Advances;
 
     bool m_treatAsFixedPitch;
 
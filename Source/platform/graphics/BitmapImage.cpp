@@ -27,13 +27,16 @@
 #include "config.h"
 #include "platform/graphics/BitmapImage.h"
 
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/Timer.h"
 #include "platform/TraceEvent.h"
 #include "platform/geometry/FloatRect.h"
+#include "platform/graphics/DeferredImageDecoder.h"
 #include "platform/graphics/GraphicsContextStateSaver.h"
 #include "platform/graphics/ImageObserver.h"
 #include "platform/graphics/skia/NativeImageSkia.h"
 #include "platform/graphics/skia/SkiaUtils.h"
+#include "wtf/MathExtras.h"
 #include "wtf/PassRefPtr.h"
 #include "wtf/text/WTFString.h"
 
@@ -285,6 +288,15 @@ void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dstRect, const Fl
     if (shouldRespectImageOrientation == RespectImageOrientation)
         orientation = frameOrientationAtIndex(m_currentFrame);
 
+    if (orientation == DefaultImageOrientation) {
+        if (RefPtr<NativeImageSkia> scaledImage = scaledFrameForDrawing(ctxt, image->bitmap(), normSrcRect, normDstRect)) {
+            normSrcRect.scale(
+                static_cast<float>(scaledImage->bitmap().width()) / image->bitmap().width(),
+                static_cast<float>(scaledImage->bitmap().height()) / image->bitmap().height());
+            image = scaledImage.release();
+        }
+    }
+
     GraphicsContextStateSaver saveContext(*ctxt, false);
     if (orientation != DefaultImageOrientation) {
         saveContext.save();
@@ -308,6 +320,25 @@ void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dstRect, const Fl
         observer->didDraw(this);
 }
 
+PassRefPtr<NativeImageSkia> BitmapImage::scaledFrameForDrawing(GraphicsContext* ctxt, const SkBitmap& decodedFrame, const FloatRect& srcRect, const FloatRect& dstRect)
+{
+    if (!RuntimeEnabledFeatures::decodeToSizeEnabled() || !DeferredImageDecoder::isLazyDecoded(decodedFrame))
+        return nullptr;
+
+    // The compositor rasters composited layers at the device scale factor on
+    // top of the CTM, so leave room for it. Without compositing the CTM
+    // already includes it, and this only makes the decode more conservative.
+    float headroom = std::max(1.0f, ctxt->deviceScaleFactor());
+    FloatRect deviceDstRect = ctxt->getCTM().mapRect(dstRect);
+    float scaleX = headroom * deviceDstRect.width() / srcRect.width();
+    float scaleY = headroom * deviceDstRect.height() / srcRect.height();
+    if (scaleX >= 1 || scaleY >= 1)
+        return nullptr;
+
+    IntSize minimumSize(ceilf(decodedFrame.width() * scaleX), ceilf(decodedFrame.height() * scaleY));
+    return m_source.createScaledFrameAtIndex(m_currentFrame, minimumSize);
+}
+
 void BitmapImage::resetDecoder()
 {
     ASSERT(isMainThread());
@@ -36,6 +36,8 @@
 #include "platform/graphics/ImageSource.h"
 #include "wtf/Forward.h"
 
+class SkBitmap;
+
 namespace blink {
 
 class NativeImageSkia;
@@ -110,6 +112,10 @@ protected:
 
     PassRefPtr<NativeImageSkia> frameAtIndex(size_t);
 
+    // Returns the current frame decoded at a reduced size if it is going to
+    // be drawn much smaller than its decoded size, or 0.
+    PassRefPtr<NativeImageSkia> scaledFrameForDrawing(GraphicsContext*, const SkBitmap& decodedFrame, const FloatRect& srcRect, const FloatRect& dstRect);
+
     bool frameIsCompleteAtIndex(size_t);
     float frameDurationAtIndex(size_t);
     bool frameHasAlphaAtIndex(size_t);
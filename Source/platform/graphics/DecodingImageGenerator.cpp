@@ -71,7 +71,7 @@ bool DecodingImageGenerator::onGetPixels(const SkImageInfo& info, void* pixels,
 {
     TRACE_EVENT1("blink", "DecodingImageGenerator::getPixels", "index", static_cast<int>(m_frameIndex));
 
-    // Implementation doesn't support scaling yet so make sure we're not given a different size.
+    // The size was fixed when the pixel ref was created, so make sure we're not given a different one.
     if (info.width() != m_imageInfo.width() || info.height() != m_imageInfo.height() || info.colorType() != m_imageInfo.colorType()) {
         // ImageFrame may have changed the owning SkBitmap to kOpaque_SkAlphaType after sniffing the encoded data, so if we see a request
         // for opaque, that is ok even if our initial alphatype was not opaque.
@@ -89,6 +89,10 @@ bool DecodingImageGenerator::onGetYUV8Planes(SkISize sizes[3], void* planes[3],
     if (!RuntimeEnabledFeatures::decodeToYUVEnabled())
         return false;
 
+    // YUV planes are only produced at full size.
+    if (m_imageInfo.width() != m_frameGenerator->getFullSize().width() || m_imageInfo.height() != m_frameGenerator->getFullSize().height())
+        return false;
+
     if (!planes || !planes[0])
         return m_frameGenerator->getYUVComponentSizes(sizes);
 
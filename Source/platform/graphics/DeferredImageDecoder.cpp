@@ -26,7 +26,9 @@
 #include "config.h"
 #include "platform/graphics/DeferredImageDecoder.h"
 
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/graphics/DecodingImageGenerator.h"
+#include "platform/graphics/ImageDecodeScheduler.h"
 #include "platform/graphics/ImageDecodingStore.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "wtf/PassOwnPtr.h"
@@ -46,6 +48,7 @@ DeferredImageDecoder::DeferredImageDecoder(PassOwnPtr<ImageDecoder> actualDecode
     : m_allDataReceived(false)
     , m_lastDataSize(0)
     , m_dataChanged(false)
+    , m_hasBeenDrawn(false)
     , m_actualDecoder(actualDecoder)
     , m_orientation(DefaultImageOrientation)
     , m_repetitionCount(cAnimationNone)
@@ -94,6 +97,13 @@ ImageFrame* DeferredImageDecoder::frameBufferAtIndex(size_t index)
 {
     prepareLazyDecodedFrames();
     if (index < m_lazyDecodedFrames.size()) {
+        // Asking for the frame means it is about to be drawn, which makes it
+        // more urgent to decode than images nobody has looked at yet.
+        if (!m_hasBeenDrawn) {
+            m_hasBeenDrawn = true;
+            scheduleBackgroundDecode();
+        }
+
         // ImageFrameGenerator has the latest known alpha state. There will
         // be a performance boost if this frame is opaque.
         m_lazyDecodedFrames[index]->setHasAlpha(m_frameGenerator->hasAlpha(index));
@@ -104,6 +114,31 @@ ImageFrame* DeferredImageDecoder::frameBufferAtIndex(size_t index)
     return 0;
 }
 
+SkBitmap DeferredImageDecoder::scaledFrameBitmapAtIndex(size_t index, const IntSize& minimumSize)
+{
+    // The frame generator only scales single frame images, and only once all
+    // data has arrived do we know the lazily decoded frame won't change.
+    if (index || !m_frameGenerator || m_actualDecoder || m_frameGenerator->isMultiFrame() || m_lazyDecodedFrames.isEmpty())
+        return SkBitmap();
+
+    // Halving keeps the number of distinct sizes small, and matches the
+    // sizes the JPEG decoder can produce by itself.
+    IntSize fullSize(m_frameGenerator->getFullSize().width(), m_frameGenerator->getFullSize().height());
+    IntSize scaledSize = fullSize;
+    while (scaledSize.width() > 1 && scaledSize.height() > 1
+        && (scaledSize.width() + 1) / 2 >= minimumSize.width()
+        && (scaledSize.height() + 1) / 2 >= minimumSize.height())
+        scaledSize = IntSize((scaledSize.width() + 1) / 2, (scaledSize.height() + 1) / 2);
+    if (scaledSize == fullSize)
+        return SkBitmap();
+
+    if (m_scaledBitmap.width() != scaledSize.width() || m_scaledBitmap.height() != scaledSize.height())
+        m_scaledBitmap = createBitmap(index, scaledSize);
+    if (!m_frameGenerator->hasAlpha(index))
+        m_scaledBitmap.setAlphaType(kOpaque_SkAlphaType);
+    return m_scaledBitmap;
+}
+
 void DeferredImageDecoder::setData(SharedBuffer& data, bool allDataReceived)
 {
     if (m_actualDecoder) {
@@ -117,8 +152,17 @@ void DeferredImageDecoder::setData(SharedBuffer& data, bool allDataReceived)
         prepareLazyDecodedFrames();
     }
 
-    if (m_frameGenerator)
+    if (m_frameGenerator) {
         m_frameGenerator->setData(&data, allDataReceived);
+        scheduleBackgroundDecode();
+    }
+}
+
+void DeferredImageDecoder::scheduleBackgroundDecode()
+{
+    if (!RuntimeEnabledFeatures::backgroundImageDecodingEnabled() || m_frameGenerator->isMultiFrame())
+        return;
+    ImageDecodeScheduler::instance()->schedule(m_frameGenerator.get(), m_hasBeenDrawn ? ImageDecodeScheduler::VisiblePriority : ImageDecodeScheduler::OffscreenPriority);
 }
 
 bool DeferredImageDecoder::isSizeAvailable()
@@ -259,10 +303,14 @@ void DeferredImageDecoder::prepareLazyDecodedFrames()
     }
 }
 
-// Creates a SkBitmap that is backed by SkDiscardablePixelRef.
 SkBitmap DeferredImageDecoder::createBitmap(size_t index)
 {
-    IntSize decodedSize = m_actualDecoder->decodedSize();
+    return createBitmap(index, m_actualDecoder->decodedSize());
+}
+
+// Creates a SkBitmap that is backed by SkDiscardablePixelRef.
+SkBitmap DeferredImageDecoder::createBitmap(size_t index, const IntSize& decodedSize)
+{
     ASSERT(decodedSize.width() > 0);
     ASSERT(decodedSize.height() > 0);
 
@@ -59,6 +59,13 @@ public:
 
     ImageFrame* frameBufferAtIndex(size_t index);
 
+    // Returns a lazily decoded bitmap of a single frame image that is at
+    // least |minimumSize|, halving the decoded size as often as that allows,
+    // so that large images drawn small are never decoded at full size.
+    // Returns a null bitmap if no smaller size would do or the image cannot
+    // be decoded at reduced size, e.g. because its data is still arriving.
+    SkBitmap scaledFrameBitmapAtIndex(size_t index, const IntSize& minimumSize);
+
     void setData(SharedBuffer& data, bool allDataReceived);
 
     bool isSizeAvailable();
@@ -82,12 +89,15 @@ private:
     explicit DeferredImageDecoder(PassOwnPtr<ImageDecoder> actualDecoder);
     void prepareLazyDecodedFrames();
     SkBitmap createBitmap(size_t index);
+    SkBitmap createBitmap(size_t index, const IntSize& decodedSize);
     void activateLazyDecoding();
+    void scheduleBackgroundDecode();
 
     RefPtr<SharedBuffer> m_data;
     bool m_allDataReceived;
     unsigned m_lastDataSize;
     bool m_dataChanged;
+    bool m_hasBeenDrawn;
     OwnPtr<ImageDecoder> m_actualDecoder;
 
     String m_filenameExtension;
@@ -99,6 +109,10 @@ private:
     Vector<OwnPtr<ImageFrame> > m_lazyDecodedFrames;
     RefPtr<ImageFrameGenerator> m_frameGenerator;
 
+    // The last bitmap handed out by scaledFrameBitmapAtIndex(). Reusing it
+    // keeps its pixels cached across paints.
+    SkBitmap m_scaledBitmap;
+
     static bool s_enabled;
 };
 
@@ -6,11 +6,18 @@
 #include "platform/graphics/FirstPaintInvalidationTracking.h"
 
 #include "platform/TraceEvent.h"
+#include "wtf/StdLibExtras.h"
 
 namespace blink {
 
 static bool showPaintRectsEnabled = false;
 
+static PaintInvalidationCoverage& coverage()
+{
+    DEFINE_STATIC_LOCAL(PaintInvalidationCoverage, coverage, ());
+    return coverage;
+}
+
 bool firstPaintInvalidationTrackingEnabled()
 {
     if (showPaintRectsEnabled)
@@ -26,4 +33,26 @@ void setFirstPaintInvalidationTrackingEnabledForShowPaintRects(bool b)
     showPaintRectsEnabled = b;
 }
 
+void recordPaintInvalidationCoverage(uint64_t changedPixels, uint64_t invalidatedPixels, unsigned invalidatedRects)
+{
+    if (!firstPaintInvalidationTrackingEnabled())
+        return;
+
+    PaintInvalidationCoverage& totals = coverage();
+    totals.changedPixels += changedPixels;
+    totals.invalidatedPixels += invalidatedPixels;
+    totals.invalidatedRects += invalidatedRects;
+    TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("blink.invalidation"), "PaintInvalidationCoverage", "changedPixels", changedPixels, "invalidatedPixels", invalidatedPixels);
+}
+
+const PaintInvalidationCoverage& paintInvalidationCoverage()
+{
+    return coverage();
+}
+
+void resetPaintInvalidationCoverage()
+{
+    coverage() = PaintInvalidationCoverage();
+}
+
 }
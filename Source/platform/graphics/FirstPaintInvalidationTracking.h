@@ -7,11 +7,33 @@
 
 #include "platform/PlatformExport.h"
 
+#include <stdint.h>
+
 namespace blink {
 
 PLATFORM_EXPORT bool firstPaintInvalidationTrackingEnabled();
 PLATFORM_EXPORT void setFirstPaintInvalidationTrackingEnabledForShowPaintRects(bool);
 
+// Totals over all layers of the pixels renderers reported as changed and the
+// pixels the compositor was then asked to repaint. Only recorded while
+// firstPaintInvalidationTrackingEnabled().
+struct PaintInvalidationCoverage {
+    PaintInvalidationCoverage()
+        : changedPixels(0)
+        , invalidatedPixels(0)
+        , invalidatedRects(0)
+    {
+    }
+
+    uint64_t changedPixels;
+    uint64_t invalidatedPixels;
+    unsigned invalidatedRects;
+};
+
+PLATFORM_EXPORT void recordPaintInvalidationCoverage(uint64_t changedPixels, uint64_t invalidatedPixels, unsigned invalidatedRects);
+PLATFORM_EXPORT const PaintInvalidationCoverage& paintInvalidationCoverage();
+PLATFORM_EXPORT void resetPaintInvalidationCoverage();
+
 } // namespace blink
 
 #endif // FirstPaintInvalidationTracking_h
@@ -29,12 +29,14 @@
 
 #include "SkImageFilter.h"
 #include "SkMatrix44.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/TraceEvent.h"
 #include "platform/geometry/FloatRect.h"
 #include "platform/geometry/LayoutRect.h"
 #include "platform/graphics/FirstPaintInvalidationTracking.h"
 #include "platform/graphics/GraphicsLayerFactory.h"
 #include "platform/graphics/Image.h"
+#include "platform/graphics/PaintInvalidationTracker.h"
 #include "platform/graphics/filters/SkiaImageFilterBuilder.h"
 #include "platform/graphics/skia/NativeImageSkia.h"
 #include "platform/scroll/ScrollableArea.h"
@@ -75,6 +77,13 @@ static RepaintMap& repaintRectMap()
     return map;
 }
 
+typedef HashSet<GraphicsLayer*> GraphicsLayerSet;
+static GraphicsLayerSet& layersWithCoalescedPaintInvalidations()
+{
+    DEFINE_STATIC_LOCAL(GraphicsLayerSet, layers, ());
+    return layers;
+}
+
 PassOwnPtr<GraphicsLayer> GraphicsLayer::create(GraphicsLayerFactory* factory, GraphicsLayerClient* client)
 {
     return factory->createGraphicsLayer(client);
@@ -139,6 +148,7 @@ GraphicsLayer::~GraphicsLayer()
     removeAllChildren();
     removeFromParent();
 
+    layersWithCoalescedPaintInvalidations().remove(this);
     resetTrackedPaintInvalidations();
     ASSERT(!m_parent);
 }
@@ -895,6 +905,8 @@ void GraphicsLayer::setNeedsDisplay()
 {
     if (drawsContent()) {
         m_layer->layer()->invalidate();
+        if (m_paintInvalidationTracker)
+            m_paintInvalidationTracker->clearPendingInvalidations();
         addRepaintRect(FloatRect(FloatPoint(), m_size));
         for (size_t i = 0; i < m_linkHighlights.size(); ++i)
             m_linkHighlights[i]->invalidate();
@@ -904,7 +916,14 @@ void GraphicsLayer::setNeedsDisplay()
 void GraphicsLayer::setNeedsDisplayInRect(const FloatRect& rect, WebInvalidationDebugAnnotations annotations)
 {
     if (drawsContent()) {
-        m_layer->layer()->invalidateRect(rect);
+        if (PaintInvalidationCoalescingScope::isCoalescing()) {
+            if (!m_paintInvalidationTracker)
+                m_paintInvalidationTracker = adoptPtr(new PaintInvalidationTracker);
+            m_paintInvalidationTracker->invalidate(enclosingIntRect(rect));
+            layersWithCoalescedPaintInvalidations().add(this);
+        } else {
+            m_layer->layer()->invalidateRect(rect);
+        }
         if (firstPaintInvalidationTrackingEnabled())
             m_debugInfo.appendAnnotatedInvalidateRect(rect, annotations);
         addRepaintRect(rect);
@@ -913,6 +932,53 @@ void GraphicsLayer::setNeedsDisplayInRect(const FloatRect& rect, WebInvalidation
     }
 }
 
+void GraphicsLayer::issueCoalescedPaintInvalidations()
+{
+    if (!m_paintInvalidationTracker || !m_paintInvalidationTracker->hasPendingInvalidations())
+        return;
+
+    PaintInvalidationTracker::Statistics before = m_paintInvalidationTracker->statistics();
+    Vector<IntRect> rects = m_paintInvalidationTracker->takeCoalescedRects();
+    for (size_t i = 0; i < rects.size(); ++i)
+        m_layer->layer()->invalidateRect(FloatRect(rects[i]));
+
+    const PaintInvalidationTracker::Statistics& after = m_paintInvalidationTracker->statistics();
+    recordPaintInvalidationCoverage(after.changedPixels - before.changedPixels, after.invalidatedPixels - before.invalidatedPixels, rects.size());
+}
+
+void GraphicsLayer::flushCoalescedPaintInvalidations()
+{
+    GraphicsLayerSet& pendingLayers = layersWithCoalescedPaintInvalidations();
+    if (pendingLayers.isEmpty())
+        return;
+
+    TRACE_EVENT1("blink", "GraphicsLayer::flushCoalescedPaintInvalidations", "layers", pendingLayers.size());
+    Vector<GraphicsLayer*> layers;
+    copyToVector(pendingLayers, layers);
+    pendingLayers.clear();
+    for (size_t i = 0; i < layers.size(); ++i)
+        layers[i]->issueCoalescedPaintInvalidations();
+}
+
+unsigned PaintInvalidationCoalescingScope::s_depth = 0;
+
+PaintInvalidationCoalescingScope::PaintInvalidationCoalescingScope()
+{
+    ++s_depth;
+}
+
+PaintInvalidationCoalescingScope::~PaintInvalidationCoalescingScope()
+{
+    ASSERT(s_depth);
+    if (!--s_depth)
+        GraphicsLayer::flushCoalescedPaintInvalidations();
+}
+
+bool PaintInvalidationCoalescingScope::isCoalescing()
+{
+    return s_depth && RuntimeEnabledFeatures::paintInvalidationCoalescingEnabled();
+}
+
 void GraphicsLayer::setContentsRect(const IntRect& rect)
 {
     if (rect == m_contentsRect)
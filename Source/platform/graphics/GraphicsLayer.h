@@ -58,6 +58,7 @@ class GraphicsLayerFactory;
 class GraphicsLayerFactoryChromium;
 class Image;
 class JSONObject;
+class PaintInvalidationTracker;
 class ScrollableArea;
 class WebCompositorAnimation;
 class WebLayer;
@@ -183,6 +184,8 @@ public:
 
     void setNeedsDisplay();
     // mark the given rect (in layer coords) as needing dispay. Never goes deep.
+    // Inside a PaintInvalidationCoalescingScope the rect may be held back and
+    // passed on to the compositor, merged with others, when the scope ends.
     void setNeedsDisplayInRect(const FloatRect&, WebInvalidationDebugAnnotations);
 
     void setContentsNeedsDisplay();
@@ -232,6 +235,11 @@ public:
     static void registerContentsLayer(WebLayer*);
     static void unregisterContentsLayer(WebLayer*);
 
+    // Hands the rects accumulated by every layer inside the current
+    // PaintInvalidationCoalescingScope to the compositor.
+    static void flushCoalescedPaintInvalidations();
+    const PaintInvalidationTracker* paintInvalidationTracker() const { return m_paintInvalidationTracker.get(); }
+
     // GraphicsContextPainter implementation.
     virtual void paint(GraphicsContext&, const IntRect& clip) OVERRIDE;
 
@@ -260,6 +268,8 @@ private:
     // can be batched before updating.
     void addChildInternal(GraphicsLayer*);
 
+    void issueCoalescedPaintInvalidations();
+
 #if ENABLE(ASSERT)
     bool hasAncestor(GraphicsLayer*) const;
 #endif
@@ -340,9 +350,26 @@ private:
 
     ScrollableArea* m_scrollableArea;
     GraphicsLayerDebugInfo m_debugInfo;
+    OwnPtr<PaintInvalidationTracker> m_paintInvalidationTracker;
     int m_3dRenderingContext;
 };
 
+// Defers rect invalidations of GraphicsLayers while alive so that each layer
+// can coalesce them (see PaintInvalidationTracker). Scopes nest; the pending
+// rects are flushed when the outermost one goes away. Has no effect unless
+// the PaintInvalidationCoalescing runtime feature is enabled.
+class PLATFORM_EXPORT PaintInvalidationCoalescingScope {
+    WTF_MAKE_NONCOPYABLE(PaintInvalidationCoalescingScope);
+public:
+    PaintInvalidationCoalescingScope();
+    ~PaintInvalidationCoalescingScope();
+
+    static bool isCoalescing();
+
+private:
+    static unsigned s_depth;
+};
+
 } // namespace blink
 
 #ifndef NDEBUG
@@ -0,0 +1,104 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/ImageDecodeScheduler.h"
+
+#include "platform/Task.h"
+#include "platform/TraceEvent.h"
+#include "platform/graphics/ImageFrameGenerator.h"
+#include "public/platform/Platform.h"
+#include "wtf/MainThread.h"
+#include "wtf/Threading.h"
+
+#include <algorithm>
+
+namespace blink {
+
+const size_t ImageDecodeScheduler::maxThreads;
+
+ImageDecodeScheduler* ImageDecodeScheduler::instance()
+{
+    AtomicallyInitializedStatic(ImageDecodeScheduler*, scheduler = new ImageDecodeScheduler);
+    return scheduler;
+}
+
+ImageDecodeScheduler::ImageDecodeScheduler()
+    : m_activeWorkers(0)
+{
+}
+
+void ImageDecodeScheduler::schedule(ImageFrameGenerator* generator, Priority priority)
+{
+    ASSERT(isMainThread());
+
+    size_t workerIndex;
+    {
+        MutexLocker lock(m_mutex);
+        bool alreadyQueued = false;
+        for (size_t i = 0; i < m_queue.size(); ++i) {
+            if (m_queue[i].generator == generator) {
+                m_queue[i].priority = std::max(m_queue[i].priority, priority);
+                alreadyQueued = true;
+                break;
+            }
+        }
+        if (!alreadyQueued) {
+            QueuedDecode decode = { generator, priority };
+            m_queue.append(decode);
+        }
+
+        if (m_activeWorkers >= maxThreads || m_activeWorkers >= m_queue.size())
+            return;
+        workerIndex = m_activeWorkers++;
+    }
+
+    if (m_threads.size() <= workerIndex)
+        m_threads.resize(workerIndex + 1);
+    if (!m_threads[workerIndex])
+        m_threads[workerIndex] = adoptPtr(Platform::current()->createThread("Blink Image Decode Thread"));
+
+    if (!m_threads[workerIndex]) {
+        // Without worker threads images are decoded by raster, as before.
+        MutexLocker lock(m_mutex);
+        --m_activeWorkers;
+        m_queue.clear();
+        return;
+    }
+
+    m_threads[workerIndex]->postTask(new Task(WTF::bind(&ImageDecodeScheduler::decodeQueuedImages, this)));
+}
+
+bool ImageDecodeScheduler::takeNextGenerator(RefPtr<ImageFrameGenerator>* generator)
+{
+    MutexLocker lock(m_mutex);
+    if (m_queue.isEmpty()) {
+        ASSERT(m_activeWorkers);
+        --m_activeWorkers;
+        return false;
+    }
+
+    // The queue is in scheduling order, so the first entry with the highest
+    // priority is the oldest one.
+    size_t next = 0;
+    for (size_t i = 1; i < m_queue.size(); ++i) {
+        if (m_queue[i].priority > m_queue[next].priority)
+            next = i;
+    }
+    *generator = m_queue[next].generator.release();
+    m_queue.remove(next);
+    return true;
+}
+
+void ImageDecodeScheduler::decodeQueuedImages()
+{
+    RefPtr<ImageFrameGenerator> generator;
+    while (takeNextGenerator(&generator)) {
+        TRACE_EVENT0("blink", "ImageDecodeScheduler::decodeQueuedImages");
+        generator->decodeInBackground();
+        generator.clear();
+    }
+}
+
+} // namespace blink
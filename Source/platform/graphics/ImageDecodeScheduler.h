@@ -0,0 +1,68 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ImageDecodeScheduler_h
+#define ImageDecodeScheduler_h
+
+#include "platform/PlatformExport.h"
+#include "public/platform/WebThread.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/OwnPtr.h"
+#include "wtf/RefPtr.h"
+#include "wtf/ThreadingPrimitives.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+class ImageFrameGenerator;
+
+// Decodes lazily decoded images on worker threads as their data arrives, so
+// that raster finds the decoder already caught up in ImageDecodingStore and
+// only has to copy pixels out. Progressive and interlaced images get each
+// pass decoded as soon as its data is in, instead of when raster asks.
+//
+// Generators that have been drawn are decoded before ones that have not.
+// Within a priority, generators are decoded in the order they were queued.
+//
+// THREAD SAFETY
+//
+// schedule() must be called on the main thread, which owns the workers.
+class PLATFORM_EXPORT ImageDecodeScheduler {
+    WTF_MAKE_NONCOPYABLE(ImageDecodeScheduler);
+public:
+    enum Priority {
+        OffscreenPriority,
+        VisiblePriority
+    };
+
+    static ImageDecodeScheduler* instance();
+
+    // Queues a decode of the data the generator has received so far. A
+    // generator is only queued once; scheduling it again can raise its
+    // priority but never lowers it.
+    void schedule(ImageFrameGenerator*, Priority);
+
+    static const size_t maxThreads = 2;
+
+private:
+    ImageDecodeScheduler();
+
+    struct QueuedDecode {
+        RefPtr<ImageFrameGenerator> generator;
+        Priority priority;
+    };
+
+    // Runs on a worker thread until the queue is empty.
+    void decodeQueuedImages();
+    bool takeNextGenerator(RefPtr<ImageFrameGenerator>*);
+
+    Vector<OwnPtr<WebThread>, maxThreads> m_threads; // Only used by the main thread.
+    Vector<QueuedDecode> m_queue;
+    size_t m_activeWorkers;
+    Mutex m_mutex; // Guards m_queue and m_activeWorkers.
+};
+
+} // namespace blink
+
+#endif // ImageDecodeScheduler_h
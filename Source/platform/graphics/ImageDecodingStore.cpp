@@ -50,6 +50,7 @@ ImageDecodingStore::~ImageDecodingStore()
     ASSERT(!m_decoderCacheMap.size());
     ASSERT(!m_orderedCacheList.size());
     ASSERT(!m_decoderCacheKeyMap.size());
+    ASSERT(!m_yuvPlanesCacheMap.size());
 #endif
 }
 
@@ -125,6 +126,66 @@ void ImageDecodingStore::removeDecoder(const ImageFrameGenerator* generator, con
     }
 }
 
+bool ImageDecodingStore::lockYUVPlanes(const ImageFrameGenerator* generator, SkISize componentSizes[3], const void* planes[3], size_t rowBytes[3])
+{
+    MutexLocker lock(m_mutex);
+    YUVPlanesCacheMap::iterator iter = m_yuvPlanesCacheMap.find(generator);
+    if (iter == m_yuvPlanesCacheMap.end())
+        return false;
+
+    YUVPlanesCacheEntry* cacheEntry = iter->value.get();
+
+    // Planes are only read while the generator holds its decode mutex, so
+    // there can only be one user at a time.
+    ASSERT(!cacheEntry->useCount());
+    cacheEntry->incrementUseCount();
+    for (int i = 0; i < 3; ++i) {
+        componentSizes[i] = cacheEntry->componentSize(i);
+        planes[i] = cacheEntry->plane(i);
+        rowBytes[i] = componentSizes[i].width();
+    }
+    return true;
+}
+
+void ImageDecodingStore::unlockYUVPlanes(const ImageFrameGenerator* generator)
+{
+    MutexLocker lock(m_mutex);
+    YUVPlanesCacheMap::iterator iter = m_yuvPlanesCacheMap.find(generator);
+    ASSERT_WITH_SECURITY_IMPLICATION(iter != m_yuvPlanesCacheMap.end());
+
+    CacheEntry* cacheEntry = iter->value.get();
+    cacheEntry->decrementUseCount();
+
+    // Put the entry to the end of list.
+    m_orderedCacheList.remove(cacheEntry);
+    m_orderedCacheList.append(cacheEntry);
+}
+
+void ImageDecodingStore::insertYUVPlanes(const ImageFrameGenerator* generator, const SkISize componentSizes[3], const void* const planes[3], const size_t rowBytes[3])
+{
+    // Copy the planes before taking the lock.
+    OwnPtr<YUVPlanesCacheEntry> newCacheEntry = YUVPlanesCacheEntry::create(generator, componentSizes, planes, rowBytes);
+
+    // Prune old cache entries to give space for the new one.
+    prune();
+
+    Vector<OwnPtr<CacheEntry> > cacheEntriesToDelete;
+    {
+        MutexLocker lock(m_mutex);
+
+        // A generator decodes its planes again if they were not found in the
+        // cache, but another decode could have inserted them in the meantime.
+        YUVPlanesCacheMap::iterator iter = m_yuvPlanesCacheMap.find(generator);
+        if (iter != m_yuvPlanesCacheMap.end()) {
+            if (iter->value->useCount())
+                return;
+            removeFromCacheInternal(iter->value.get(), &cacheEntriesToDelete);
+            removeFromCacheListInternal(cacheEntriesToDelete);
+        }
+        insertCacheInternal(newCacheEntry.release(), &m_yuvPlanesCacheMap);
+    }
+}
+
 void ImageDecodingStore::removeCacheIndexedByGenerator(const ImageFrameGenerator* generator)
 {
     Vector<OwnPtr<CacheEntry> > cacheEntriesToDelete;
@@ -135,6 +196,13 @@ void ImageDecodingStore::removeCacheIndexedByGenerator(const ImageFrameGenerator
         // with a ImageFrameGenerator.
         removeCacheIndexedByGeneratorInternal(&m_decoderCacheMap, &m_decoderCacheKeyMap, generator, &cacheEntriesToDelete);
 
+        // The YUV planes of a generator are keyed by the generator itself.
+        YUVPlanesCacheMap::iterator iter = m_yuvPlanesCacheMap.find(generator);
+        if (iter != m_yuvPlanesCacheMap.end()) {
+            ASSERT(!iter->value->useCount());
+            removeFromCacheInternal(iter->value.get(), &m_yuvPlanesCacheMap, &cacheEntriesToDelete);
+        }
+
         // Remove from LRU list as well.
         removeFromCacheListInternal(cacheEntriesToDelete);
     }
@@ -175,7 +243,7 @@ size_t ImageDecodingStore::memoryUsageInBytes()
 int ImageDecodingStore::cacheEntries()
 {
     MutexLocker lock(m_mutex);
-    return m_decoderCacheMap.size();
+    return m_decoderCacheMap.size() + m_yuvPlanesCacheMap.size();
 }
 
 int ImageDecodingStore::decoderCacheEntries()
@@ -184,6 +252,12 @@ int ImageDecodingStore::decoderCacheEntries()
     return m_decoderCacheMap.size();
 }
 
+int ImageDecodingStore::yuvPlanesCacheEntries()
+{
+    MutexLocker lock(m_mutex);
+    return m_yuvPlanesCacheMap.size();
+}
+
 void ImageDecodingStore::prune()
 {
     TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("blink.image_decoding"), "ImageDecodingStore::prune");
@@ -215,6 +289,14 @@ void ImageDecodingStore::prune()
 
 template<class T, class U, class V>
 void ImageDecodingStore::insertCacheInternal(PassOwnPtr<T> cacheEntry, U* cacheMap, V* identifierMap)
+{
+    typename V::AddResult result = identifierMap->add(cacheEntry->generator(), typename V::MappedType());
+    result.storedValue->value.add(cacheEntry->cacheKey());
+    insertCacheInternal(cacheEntry, cacheMap);
+}
+
+template<class T, class U>
+void ImageDecodingStore::insertCacheInternal(PassOwnPtr<T> cacheEntry, U* cacheMap)
 {
     const size_t cacheEntryBytes = cacheEntry->memoryUsageInBytes();
     m_heapMemoryUsageInBytes += cacheEntryBytes;
@@ -224,8 +306,6 @@ void ImageDecodingStore::insertCacheInternal(PassOwnPtr<T> cacheEntry, U* cacheM
     m_orderedCacheList.append(cacheEntry.get());
 
     typename U::KeyType key = cacheEntry->cacheKey();
-    typename V::AddResult result = identifierMap->add(cacheEntry->generator(), typename V::MappedType());
-    result.storedValue->value.add(key);
     cacheMap->add(key, cacheEntry);
 
     TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("blink.image_decoding"), "ImageDecodingStoreHeapMemoryUsageBytes", m_heapMemoryUsageInBytes);
@@ -235,10 +315,6 @@ void ImageDecodingStore::insertCacheInternal(PassOwnPtr<T> cacheEntry, U* cacheM
 template<class T, class U, class V>
 void ImageDecodingStore::removeFromCacheInternal(const T* cacheEntry, U* cacheMap, V* identifierMap, Vector<OwnPtr<CacheEntry> >* deletionList)
 {
-    const size_t cacheEntryBytes = cacheEntry->memoryUsageInBytes();
-    ASSERT(m_heapMemoryUsageInBytes >= cacheEntryBytes);
-    m_heapMemoryUsageInBytes -= cacheEntryBytes;
-
     // Remove entry from identifier map.
     typename V::iterator iter = identifierMap->find(cacheEntry->generator());
     ASSERT(iter != identifierMap->end());
@@ -246,6 +322,16 @@ void ImageDecodingStore::removeFromCacheInternal(const T* cacheEntry, U* cacheMa
     if (!iter->value.size())
         identifierMap->remove(iter);
 
+    removeFromCacheInternal(cacheEntry, cacheMap, deletionList);
+}
+
+template<class T, class U>
+void ImageDecodingStore::removeFromCacheInternal(const T* cacheEntry, U* cacheMap, Vector<OwnPtr<CacheEntry> >* deletionList)
+{
+    const size_t cacheEntryBytes = cacheEntry->memoryUsageInBytes();
+    ASSERT(m_heapMemoryUsageInBytes >= cacheEntryBytes);
+    m_heapMemoryUsageInBytes -= cacheEntryBytes;
+
     // Remove entry from cache map.
     deletionList->append(cacheMap->take(cacheEntry->cacheKey()));
 
@@ -257,6 +343,8 @@ void ImageDecodingStore::removeFromCacheInternal(const CacheEntry* cacheEntry, V
 {
     if (cacheEntry->type() == CacheEntry::TypeDecoder) {
         removeFromCacheInternal(static_cast<const DecoderCacheEntry*>(cacheEntry), &m_decoderCacheMap, &m_decoderCacheKeyMap, deletionList);
+    } else if (cacheEntry->type() == CacheEntry::TypeYUVPlanes) {
+        removeFromCacheInternal(static_cast<const YUVPlanesCacheEntry*>(cacheEntry), &m_yuvPlanesCacheMap, deletionList);
     } else {
         ASSERT(false);
     }
@@ -282,6 +370,32 @@ void ImageDecodingStore::removeCacheIndexedByGeneratorInternal(U* cacheMap, V* i
     }
 }
 
+PassOwnPtr<ImageDecodingStore::YUVPlanesCacheEntry> ImageDecodingStore::YUVPlanesCacheEntry::create(const ImageFrameGenerator* generator, const SkISize componentSizes[3], const void* const planes[3], const size_t rowBytes[3])
+{
+    OwnPtr<YUVPlanesCacheEntry> cacheEntry = adoptPtr(new YUVPlanesCacheEntry(generator, componentSizes));
+    for (int i = 0; i < 3; ++i) {
+        const size_t width = componentSizes[i].width();
+        ASSERT(rowBytes[i] >= width);
+        const char* source = static_cast<const char*>(planes[i]);
+        char* destination = cacheEntry->m_pixels.data() + cacheEntry->m_planeOffsets[i];
+        for (int row = 0; row < componentSizes[i].height(); ++row)
+            memcpy(destination + row * width, source + row * rowBytes[i], width);
+    }
+    return cacheEntry.release();
+}
+
+ImageDecodingStore::YUVPlanesCacheEntry::YUVPlanesCacheEntry(const ImageFrameGenerator* generator, const SkISize componentSizes[3])
+    : CacheEntry(generator, 0)
+{
+    size_t totalBytes = 0;
+    for (int i = 0; i < 3; ++i) {
+        m_componentSizes[i] = componentSizes[i];
+        m_planeOffsets[i] = totalBytes;
+        totalBytes += static_cast<size_t>(componentSizes[i].width()) * componentSizes[i].height();
+    }
+    m_pixels.resize(totalBytes);
+}
+
 void ImageDecodingStore::removeFromCacheListInternal(const Vector<OwnPtr<CacheEntry> >& deletionList)
 {
     for (size_t i = 0; i < deletionList.size(); ++i)
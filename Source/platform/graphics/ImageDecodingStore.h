@@ -45,7 +45,8 @@ class ImageFrameGenerator;
 
 // FUNCTION
 //
-// ImageDecodingStore is a class used to manage cached decoder objects.
+// ImageDecodingStore is a class used to manage cached decoder objects and
+// decoded YUV planes.
 //
 // EXTERNAL OBJECTS
 //
@@ -75,6 +76,14 @@ public:
     void insertDecoder(const ImageFrameGenerator*, PassOwnPtr<ImageDecoder>);
     void removeDecoder(const ImageFrameGenerator*, const ImageDecoder*);
 
+    // Access cached YUV planes. Planes are only decoded at full size, so they
+    // are indexed by origin (ImageFrameGenerator) alone. The pointers returned
+    // by lockYUVPlanes() stay valid until unlockYUVPlanes() is called.
+    bool lockYUVPlanes(const ImageFrameGenerator*, SkISize componentSizes[3], const void* planes[3], size_t rowBytes[3]);
+    void unlockYUVPlanes(const ImageFrameGenerator*);
+    // Copies the planes, so the caller keeps ownership of its buffers.
+    void insertYUVPlanes(const ImageFrameGenerator*, const SkISize componentSizes[3], const void* const planes[3], const size_t rowBytes[3]);
+
     // Remove all cache entries indexed by ImageFrameGenerator.
     void removeCacheIndexedByGenerator(const ImageFrameGenerator*);
 
@@ -83,6 +92,7 @@ public:
     size_t memoryUsageInBytes();
     int cacheEntries();
     int decoderCacheEntries();
+    int yuvPlanesCacheEntries();
 
 private:
     // Decoder cache entry is identified by:
@@ -90,12 +100,16 @@ private:
     // 2. Size of the image.
     typedef std::pair<const ImageFrameGenerator*, SkISize> DecoderCacheKey;
 
+    // YUV planes cache entry is identified by the pointer to ImageFrameGenerator.
+    typedef const ImageFrameGenerator* YUVPlanesCacheKey;
+
     // Base class for all cache entries.
     class CacheEntry : public DoublyLinkedListNode<CacheEntry> {
         friend class WTF::DoublyLinkedListNode<CacheEntry>;
     public:
         enum CacheType {
             TypeDecoder,
+            TypeYUVPlanes,
         };
 
         CacheEntry(const ImageFrameGenerator* generator, int useCount)
@@ -141,6 +155,7 @@ private:
             : CacheEntry(generator, count)
             , m_cachedDecoder(decoder)
             , m_size(SkISize::Make(m_cachedDecoder->decodedSize().width(), m_cachedDecoder->decodedSize().height()))
+            , m_keySize(keySize(m_cachedDecoder.get()))
         {
         }
 
@@ -153,14 +168,44 @@ private:
         }
         static DecoderCacheKey makeCacheKey(const ImageFrameGenerator* generator, const ImageDecoder* decoder)
         {
-            return std::make_pair(generator, SkISize::Make(decoder->decodedSize().width(), decoder->decodedSize().height()));
+            return std::make_pair(generator, keySize(decoder));
         }
-        DecoderCacheKey cacheKey() const { return makeCacheKey(m_generator, m_size); }
+        DecoderCacheKey cacheKey() const { return makeCacheKey(m_generator, m_keySize); }
         ImageDecoder* cachedDecoder() const { return m_cachedDecoder.get(); }
 
     private:
+        // A decoder asked for a reduced size is found by the size that was
+        // asked for, which can be smaller than what it actually decodes.
+        static SkISize keySize(const ImageDecoder* decoder)
+        {
+            IntSize size = decoder->targetDecodedSize().isEmpty() ? decoder->decodedSize() : decoder->targetDecodedSize();
+            return SkISize::Make(size.width(), size.height());
+        }
+
         OwnPtr<ImageDecoder> m_cachedDecoder;
         SkISize m_size;
+        SkISize m_keySize;
+    };
+
+    // Holds a copy of the Y, U and V planes of a full size decode, packed
+    // without row padding.
+    class YUVPlanesCacheEntry FINAL : public CacheEntry {
+    public:
+        static PassOwnPtr<YUVPlanesCacheEntry> create(const ImageFrameGenerator*, const SkISize componentSizes[3], const void* const planes[3], const size_t rowBytes[3]);
+
+        virtual size_t memoryUsageInBytes() const OVERRIDE { return m_pixels.size(); }
+        virtual CacheType type() const OVERRIDE { return TypeYUVPlanes; }
+
+        YUVPlanesCacheKey cacheKey() const { return m_generator; }
+        const SkISize& componentSize(int component) const { return m_componentSizes[component]; }
+        const void* plane(int component) const { return m_pixels.data() + m_planeOffsets[component]; }
+
+    private:
+        YUVPlanesCacheEntry(const ImageFrameGenerator*, const SkISize componentSizes[3]);
+
+        SkISize m_componentSizes[3];
+        size_t m_planeOffsets[3];
+        Vector<char> m_pixels;
     };
 
     ImageDecodingStore();
@@ -169,10 +214,13 @@ private:
 
     // These helper methods are called while m_mutex is locked.
     template<class T, class U, class V> void insertCacheInternal(PassOwnPtr<T> cacheEntry, U* cacheMap, V* identifierMap);
+    // For cache maps keyed by the generator alone, which need no identifier map.
+    template<class T, class U> void insertCacheInternal(PassOwnPtr<T> cacheEntry, U* cacheMap);
 
     // Helper method to remove a cache entry. Ownership is transferred to
     // deletionList. Use of Vector<> is handy when removing multiple entries.
     template<class T, class U, class V> void removeFromCacheInternal(const T* cacheEntry, U* cacheMap, V* identifierMap, Vector<OwnPtr<CacheEntry> >* deletionList);
+    template<class T, class U> void removeFromCacheInternal(const T* cacheEntry, U* cacheMap, Vector<OwnPtr<CacheEntry> >* deletionList);
 
     // Helper method to remove a cache entry. Uses the templated version base on
     // the type of cache entry.
@@ -201,6 +249,11 @@ private:
     typedef HashMap<const ImageFrameGenerator*, DecoderCacheKeySet> DecoderCacheKeyMap;
     DecoderCacheKeyMap m_decoderCacheKeyMap;
 
+    // A lookup table for all YUV planes cache objects. Owns all YUV planes
+    // cache objects. A generator has at most one, keyed by the generator.
+    typedef HashMap<YUVPlanesCacheKey, OwnPtr<YUVPlanesCacheEntry> > YUVPlanesCacheMap;
+    YUVPlanesCacheMap m_yuvPlanesCacheMap;
+
     size_t m_heapLimitInBytes;
     size_t m_heapMemoryUsageInBytes;
 
@@ -208,6 +261,7 @@ private:
     //   m_orderedCacheList
     //   m_decoderCacheMap and all CacheEntrys stored in it
     //   m_decoderCacheKeyMap
+    //   m_yuvPlanesCacheMap and all CacheEntrys stored in it
     //   m_heapLimitInBytes
     //   m_heapMemoryUsageInBytes
     // This mutex also protects calls to underlying skBitmap's
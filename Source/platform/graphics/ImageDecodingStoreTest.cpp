@@ -179,4 +179,69 @@ TEST_F(ImageDecodingStoreTest, removeDecoder)
     EXPECT_FALSE(ImageDecodingStore::instance()->lockDecoder(m_generator.get(), size, &testDecoder));
 }
 
+TEST_F(ImageDecodingStoreTest, insertYUVPlanes)
+{
+    // 4x2 luma with 2x1 chroma, each row padded to 8 bytes.
+    unsigned char yPlane[16] = { 1, 2, 3, 4, 0, 0, 0, 0, 5, 6, 7, 8, 0, 0, 0, 0 };
+    unsigned char uPlane[8] = { 9, 10, 0, 0, 0, 0, 0, 0 };
+    unsigned char vPlane[8] = { 11, 12, 0, 0, 0, 0, 0, 0 };
+    const SkISize sizes[3] = { SkISize::Make(4, 2), SkISize::Make(2, 1), SkISize::Make(2, 1) };
+    const void* const planes[3] = { yPlane, uPlane, vPlane };
+    const size_t rowBytes[3] = { 8, 8, 8 };
+    ImageDecodingStore::instance()->insertYUVPlanes(m_generator.get(), sizes, planes, rowBytes);
+    EXPECT_EQ(1, ImageDecodingStore::instance()->cacheEntries());
+    EXPECT_EQ(1, ImageDecodingStore::instance()->yuvPlanesCacheEntries());
+    EXPECT_EQ(0, ImageDecodingStore::instance()->decoderCacheEntries());
+
+    // Padding is not kept, so the planes take less memory than the same
+    // image decoded to RGBA.
+    EXPECT_EQ(12u, ImageDecodingStore::instance()->memoryUsageInBytes());
+
+    SkISize testSizes[3];
+    const void* testPlanes[3];
+    size_t testRowBytes[3];
+    EXPECT_TRUE(ImageDecodingStore::instance()->lockYUVPlanes(m_generator.get(), testSizes, testPlanes, testRowBytes));
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(sizes[i], testSizes[i]);
+        EXPECT_EQ(static_cast<size_t>(sizes[i].width()), testRowBytes[i]);
+    }
+    const unsigned char* testY = static_cast<const unsigned char*>(testPlanes[0]);
+    EXPECT_EQ(4, testY[3]);
+    EXPECT_EQ(5, testY[4]);
+    EXPECT_EQ(10, static_cast<const unsigned char*>(testPlanes[1])[1]);
+    EXPECT_EQ(11, static_cast<const unsigned char*>(testPlanes[2])[0]);
+    ImageDecodingStore::instance()->unlockYUVPlanes(m_generator.get());
+
+    // Planes go away with the rest of the generator's entries.
+    ImageDecodingStore::instance()->removeCacheIndexedByGenerator(m_generator.get());
+    EXPECT_FALSE(ImageDecodingStore::instance()->cacheEntries());
+    EXPECT_FALSE(ImageDecodingStore::instance()->memoryUsageInBytes());
+    EXPECT_FALSE(ImageDecodingStore::instance()->lockYUVPlanes(m_generator.get(), testSizes, testPlanes, testRowBytes));
+}
+
+TEST_F(ImageDecodingStoreTest, evictYUVPlanes)
+{
+    OwnPtr<ImageDecoder> decoder = MockImageDecoder::create(this);
+    decoder->setSize(1, 1);
+    ImageDecodingStore::instance()->insertDecoder(m_generator.get(), decoder.release());
+
+    unsigned char pixels[4] = { 0, 0, 0, 0 };
+    const SkISize sizes[3] = { SkISize::Make(2, 2), SkISize::Make(1, 1), SkISize::Make(1, 1) };
+    const void* const planes[3] = { pixels, pixels, pixels };
+    const size_t rowBytes[3] = { 2, 1, 1 };
+    ImageDecodingStore::instance()->insertYUVPlanes(m_generator.get(), sizes, planes, rowBytes);
+    EXPECT_EQ(2, ImageDecodingStore::instance()->cacheEntries());
+    EXPECT_EQ(10u, ImageDecodingStore::instance()->memoryUsageInBytes());
+
+    // Least recently used entries are evicted first, whatever their type.
+    evictOneCache();
+    EXPECT_EQ(1, ImageDecodingStore::instance()->yuvPlanesCacheEntries());
+    EXPECT_EQ(0, ImageDecodingStore::instance()->decoderCacheEntries());
+    EXPECT_EQ(6u, ImageDecodingStore::instance()->memoryUsageInBytes());
+
+    evictOneCache();
+    EXPECT_FALSE(ImageDecodingStore::instance()->cacheEntries());
+    EXPECT_FALSE(ImageDecodingStore::instance()->memoryUsageInBytes());
+}
+
 } // namespace
@@ -87,6 +87,7 @@ static bool updateYUVComponentSizes(ImageDecoder* decoder, SkISize componentSize
 
 ImageFrameGenerator::ImageFrameGenerator(const SkISize& fullSize, PassRefPtr<SharedBuffer> data, bool allDataReceived, bool isMultiFrame)
     : m_fullSize(fullSize)
+    , m_lastRequestedSize(fullSize)
     , m_isMultiFrame(isMultiFrame)
     , m_decodeFailedAndEmpty(false)
     , m_decodeCount(0)
@@ -119,27 +120,39 @@ bool ImageFrameGenerator::decodeAndScale(const SkImageInfo& info, size_t index,
     // Prevents concurrent decode or scale operations on the same image data.
     MutexLocker lock(m_decodeMutex);
 
-    // This implementation does not support scaling so check the requested size.
+    // Only downscaling is supported, and only for single frame images.
     SkISize scaledSize = SkISize::Make(info.fWidth, info.fHeight);
-    ASSERT(m_fullSize == scaledSize);
+    ASSERT(scaledSize.width() <= m_fullSize.width() && scaledSize.height() <= m_fullSize.height());
+    ASSERT(scaledSize == m_fullSize || !m_isMultiFrame);
 
     if (m_decodeFailedAndEmpty)
         return false;
 
     TRACE_EVENT2("blink", "ImageFrameGenerator::decodeAndScale", "generator", this, "decodeCount", m_decodeCount);
 
-    m_externalAllocator = adoptPtr(new ExternalMemoryAllocator(info, pixels, rowBytes));
+    m_lastRequestedSize = scaledSize;
+
+    // A decoder asked for a reduced size may still decode at a somewhat
+    // larger size, so it can only write straight into Skia's memory for
+    // full size decodes.
+    if (scaledSize == m_fullSize)
+        m_externalAllocator = adoptPtr(new ExternalMemoryAllocator(info, pixels, rowBytes));
 
     SkBitmap bitmap = tryToResumeDecode(scaledSize, index);
-    if (bitmap.isNull())
-        return false;
 
     // Don't keep the allocator because it contains a pointer to memory
     // that we do not own.
     m_externalAllocator.clear();
 
-    ASSERT(bitmap.width() == scaledSize.width());
-    ASSERT(bitmap.height() == scaledSize.height());
+    if (bitmap.isNull())
+        return false;
+
+    if (bitmap.width() != scaledSize.width() || bitmap.height() != scaledSize.height()) {
+        TRACE_EVENT0("blink", "ImageFrameGenerator::resize");
+        bitmap = skia::ImageOperations::Resize(bitmap, skia::ImageOperations::RESIZE_LANCZOS3, scaledSize.width(), scaledSize.height());
+        if (bitmap.isNull())
+            return false;
+    }
 
     bool result = true;
     // Check to see if decoder has written directly to the memory provided
@@ -149,6 +162,27 @@ bool ImageFrameGenerator::decodeAndScale(const SkImageInfo& info, size_t index,
     return result;
 }
 
+void ImageFrameGenerator::decodeInBackground()
+{
+    // If raster holds the lock it is already consuming the new data.
+    MutexTryLocker lock(m_decodeMutex);
+    if (!lock.locked() || m_decodeFailedAndEmpty || m_isMultiFrame || !m_data.hasNewData())
+        return;
+
+    TRACE_EVENT2("blink", "ImageFrameGenerator::decodeInBackground", "generator", this, "decodeCount", m_decodeCount);
+
+    // A failed decodeAndScale() may have left an allocator for memory we no
+    // longer have access to.
+    m_externalAllocator.clear();
+
+    // A completed frame only lives in its decoder's frame buffer, so keep the
+    // decoder cached until raster has copied the pixels out. Decoders are
+    // cached by the size raster asks for, so decode at the size it asked for
+    // last; a full size decoder would never be picked up by a reduced size
+    // raster.
+    tryToResumeDecode(m_lastRequestedSize, 0, CacheCompletedDecoder);
+}
+
 bool ImageFrameGenerator::decodeToYUV(SkISize componentSizes[3], void* planes[3], size_t rowBytes[3])
 {
     // This method is called to populate a discardable memory owned by Skia.
@@ -166,6 +200,9 @@ bool ImageFrameGenerator::decodeToYUV(SkISize componentSizes[3], void* planes[3]
         return false;
     }
 
+    if (copyCachedYUVPlanes(componentSizes, planes, rowBytes))
+        return true;
+
     SharedBuffer* data = 0;
     bool allDataReceived = false;
     m_data.data(&data, &allDataReceived);
@@ -186,21 +223,48 @@ bool ImageFrameGenerator::decodeToYUV(SkISize componentSizes[3], void* planes[3]
     RELEASE_ASSERT(sizeUpdated);
 
     bool yuvDecoded = decoder->decodeToYUV();
-    if (yuvDecoded)
+    if (yuvDecoded) {
         setHasAlpha(0, false); // YUV is always opaque
+
+        // Skia discards the planes it asked for under memory pressure. Keep a
+        // copy so that they don't have to be decoded from scratch again.
+        ImageDecodingStore::instance()->insertYUVPlanes(this, componentSizes, planes, rowBytes);
+    }
     return yuvDecoded;
 }
 
-SkBitmap ImageFrameGenerator::tryToResumeDecode(const SkISize& scaledSize, size_t index)
+bool ImageFrameGenerator::copyCachedYUVPlanes(SkISize componentSizes[3], void* planes[3], size_t rowBytes[3])
+{
+    SkISize cachedSizes[3];
+    const void* cachedPlanes[3];
+    size_t cachedRowBytes[3];
+    if (!ImageDecodingStore::instance()->lockYUVPlanes(this, cachedSizes, cachedPlanes, cachedRowBytes))
+        return false;
+
+    TRACE_EVENT0("blink", "ImageFrameGenerator::copyCachedYUVPlanes");
+    for (int i = 0; i < 3; ++i) {
+        componentSizes[i] = cachedSizes[i];
+        const size_t width = cachedSizes[i].width();
+        ASSERT(rowBytes[i] >= width);
+        for (int row = 0; row < cachedSizes[i].height(); ++row)
+            memcpy(static_cast<char*>(planes[i]) + row * rowBytes[i], static_cast<const char*>(cachedPlanes[i]) + row * cachedRowBytes[i], width);
+    }
+    ImageDecodingStore::instance()->unlockYUVPlanes(this);
+
+    setHasAlpha(0, false); // YUV is always opaque
+    return true;
+}
+
+SkBitmap ImageFrameGenerator::tryToResumeDecode(const SkISize& scaledSize, size_t index, CompletedDecoderHandling completedDecoderHandling)
 {
     TRACE_EVENT1("blink", "ImageFrameGenerator::tryToResumeDecodeAndScale", "index", static_cast<int>(index));
 
     ImageDecoder* decoder = 0;
-    const bool resumeDecoding = ImageDecodingStore::instance()->lockDecoder(this, m_fullSize, &decoder);
+    const bool resumeDecoding = ImageDecodingStore::instance()->lockDecoder(this, scaledSize, &decoder);
     ASSERT(!resumeDecoding || decoder);
 
     SkBitmap fullSizeImage;
-    bool complete = decode(index, &decoder, &fullSizeImage);
+    bool complete = decode(scaledSize, index, &decoder, &fullSizeImage);
 
     if (!decoder)
         return SkBitmap();
@@ -225,7 +289,7 @@ SkBitmap ImageFrameGenerator::tryToResumeDecode(const SkISize& scaledSize, size_
     // If the image generated is complete then there is no need to keep
     // the decoder. The exception is multi-frame decoder which can generate
     // multiple complete frames.
-    const bool removeDecoder = complete && !m_isMultiFrame;
+    const bool removeDecoder = complete && !m_isMultiFrame && completedDecoderHandling == DiscardCompletedDecoder;
 
     if (resumeDecoding) {
         if (removeDecoder)
@@ -250,7 +314,7 @@ void ImageFrameGenerator::setHasAlpha(size_t index, bool hasAlpha)
     m_hasAlpha[index] = hasAlpha;
 }
 
-bool ImageFrameGenerator::decode(size_t index, ImageDecoder** decoder, SkBitmap* bitmap)
+bool ImageFrameGenerator::decode(const SkISize& scaledSize, size_t index, ImageDecoder** decoder, SkBitmap* bitmap)
 {
     TRACE_EVENT2("blink", "ImageFrameGenerator::decode", "width", m_fullSize.width(), "height", m_fullSize.height());
 
@@ -271,12 +335,15 @@ bool ImageFrameGenerator::decode(size_t index, ImageDecoder** decoder, SkBitmap*
 
         if (!*decoder)
             return false;
+
+        if (scaledSize != m_fullSize)
+            (*decoder)->setTargetDecodedSize(IntSize(scaledSize.width(), scaledSize.height()));
     }
 
-    if (!m_isMultiFrame && newDecoder && allDataReceived) {
+    if (!m_isMultiFrame && newDecoder && allDataReceived && m_externalAllocator) {
         // If we're using an external memory allocator that means we're decoding
-        // directly into the output memory and we can save one memcpy.
-        ASSERT(m_externalAllocator.get());
+        // directly into the output memory and we can save one memcpy. Decodes
+        // started in the background have no output memory yet.
         (*decoder)->setMemoryAllocator(m_externalAllocator.get());
     }
     (*decoder)->setData(data, allDataReceived);
@@ -296,7 +363,7 @@ bool ImageFrameGenerator::decode(size_t index, ImageDecoder** decoder, SkBitmap*
     SkBitmap fullSizeBitmap = frame->getSkBitmap();
     if (!fullSizeBitmap.isNull())
     {
-        ASSERT(fullSizeBitmap.width() == m_fullSize.width() && fullSizeBitmap.height() == m_fullSize.height());
+        ASSERT(fullSizeBitmap.width() >= scaledSize.width() && fullSizeBitmap.height() >= scaledSize.height());
         setHasAlpha(index, !fullSizeBitmap.isOpaque());
     }
     *bitmap = fullSizeBitmap;
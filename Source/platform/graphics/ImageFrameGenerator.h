@@ -66,12 +66,22 @@ public:
 
     // Decodes and scales the specified frame indicated by |index|. Dimensions
     // and output format are specified in |info|. Decoded pixels are written
-    // into |pixels| with a stride of |rowBytes|.
+    // into |pixels| with a stride of |rowBytes|. Single frame images can be
+    // asked for a size smaller than getFullSize(); decoders that can, decode
+    // straight to about that size and the rest is resampled.
     //
     // Returns true if decoding was successful.
     bool decodeAndScale(const SkImageInfo&, size_t index, void* pixels, size_t rowBytes);
 
-    // Decodes YUV components directly into the provided memory planes.
+    // Advances the decode of a single frame image with whatever data has
+    // arrived since the last decode, leaving the decoder and its partially or
+    // fully decoded frame in ImageDecodingStore for decodeAndScale() to pick
+    // up. Does nothing if another thread is decoding this image already.
+    // Called on ImageDecodeScheduler threads.
+    void decodeInBackground();
+
+    // Decodes YUV components directly into the provided memory planes. The
+    // planes are kept in ImageDecodingStore and copied from there next time.
     bool decodeToYUV(SkISize componentSizes[3], void* planes[3], size_t rowBytes[3]);
 
     void setData(PassRefPtr<SharedBuffer>, bool allDataReceived);
@@ -97,14 +107,26 @@ private:
 
     void setHasAlpha(size_t index, bool hasAlpha);
 
+    enum CompletedDecoderHandling {
+        DiscardCompletedDecoder,
+        CacheCompletedDecoder
+    };
+
     // These methods are called while m_decodeMutex is locked.
-    SkBitmap tryToResumeDecode(const SkISize& scaledSize, size_t index);
+    SkBitmap tryToResumeDecode(const SkISize& scaledSize, size_t index, CompletedDecoderHandling = DiscardCompletedDecoder);
+
+    // Use the given decoder to decode. If a decoder is not given then try to create one
+    // that targets |scaledSize|. Returns true if decoding was complete.
+    bool decode(const SkISize& scaledSize, size_t index, ImageDecoder**, SkBitmap*);
 
-    // Use the given decoder to decode. If a decoder is not given then try to create one.
-    // Returns true if decoding was complete.
-    bool decode(size_t index, ImageDecoder**, SkBitmap*);
+    // Copies the YUV planes cached in ImageDecodingStore, if any, into the
+    // provided memory planes.
+    bool copyCachedYUVPlanes(SkISize componentSizes[3], void* planes[3], size_t rowBytes[3]);
 
     SkISize m_fullSize;
+    // The size decodeAndScale() was last asked for. Decoding in the background
+    // targets it. Guarded by m_decodeMutex.
+    SkISize m_lastRequestedSize;
     ThreadSafeDataTransport m_data;
     bool m_isMultiFrame;
     bool m_decodeFailedAndEmpty;
@@ -174,6 +174,90 @@ TEST_F(ImageFrameGeneratorTest, incompleteDecodeBecomesCompleteMultiThreaded)
     EXPECT_EQ(3, m_frameBufferRequestCount);
 }
 
+TEST_F(ImageFrameGeneratorTest, backgroundDecodeIsResumedByRaster)
+{
+    setFrameStatus(ImageFrame::FramePartial);
+    addNewData();
+
+    m_generator->decodeInBackground();
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+    EXPECT_EQ(1, ImageDecodingStore::instance()->decoderCacheEntries());
+
+    // Nothing new to decode.
+    m_generator->decodeInBackground();
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+
+    char buffer[100 * 100 * 4];
+    m_generator->decodeAndScale(imageInfo(), 0, buffer, 100 * 4);
+    EXPECT_EQ(2, m_frameBufferRequestCount);
+    EXPECT_EQ(0, m_decodersDestroyed);
+}
+
+TEST_F(ImageFrameGeneratorTest, backgroundDecodeKeepsCompleteFrameForRaster)
+{
+    setFrameStatus(ImageFrame::FrameComplete);
+    addNewData();
+
+    m_generator->decodeInBackground();
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+    EXPECT_EQ(0, m_decodersDestroyed);
+    EXPECT_EQ(1, ImageDecodingStore::instance()->decoderCacheEntries());
+
+    // Raster copies the frame out of the cached decoder, which is then
+    // no longer needed.
+    char buffer[100 * 100 * 4];
+    m_generator->decodeAndScale(imageInfo(), 0, buffer, 100 * 4);
+    EXPECT_EQ(2, m_frameBufferRequestCount);
+    EXPECT_EQ(1, m_decodersDestroyed);
+    EXPECT_EQ(0, ImageDecodingStore::instance()->decoderCacheEntries());
+}
+
+TEST_F(ImageFrameGeneratorTest, scaledDecodeIsCachedByScaledSize)
+{
+    setFrameStatus(ImageFrame::FramePartial);
+
+    SkImageInfo scaledInfo = SkImageInfo::Make(50, 50, kBGRA_8888_SkColorType, kOpaque_SkAlphaType);
+    char buffer[50 * 50 * 4];
+    EXPECT_TRUE(m_generator->decodeAndScale(scaledInfo, 0, buffer, 50 * 4));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+
+    ImageDecoder* tempDecoder = 0;
+    EXPECT_FALSE(ImageDecodingStore::instance()->lockDecoder(m_generator.get(), fullSize(), &tempDecoder));
+    EXPECT_TRUE(ImageDecodingStore::instance()->lockDecoder(m_generator.get(), SkISize::Make(50, 50), &tempDecoder));
+    ASSERT_TRUE(tempDecoder);
+    EXPECT_EQ(IntSize(50, 50), tempDecoder->targetDecodedSize());
+    ImageDecodingStore::instance()->unlockDecoder(m_generator.get(), tempDecoder);
+
+    // The scaled decoder is resumed rather than recreated.
+    addNewData();
+    EXPECT_TRUE(m_generator->decodeAndScale(scaledInfo, 0, buffer, 50 * 4));
+    EXPECT_EQ(2, m_frameBufferRequestCount);
+    EXPECT_EQ(0, m_decodersDestroyed);
+}
+
+TEST_F(ImageFrameGeneratorTest, backgroundDecodeUsesLastRequestedSize)
+{
+    setFrameStatus(ImageFrame::FramePartial);
+
+    SkImageInfo scaledInfo = SkImageInfo::Make(50, 50, kBGRA_8888_SkColorType, kOpaque_SkAlphaType);
+    char buffer[50 * 50 * 4];
+    EXPECT_TRUE(m_generator->decodeAndScale(scaledInfo, 0, buffer, 50 * 4));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+
+    // The background decode resumes the decoder raster asked for, instead of
+    // starting a full size one that raster would never use.
+    addNewData();
+    m_generator->decodeInBackground();
+    EXPECT_EQ(2, m_frameBufferRequestCount);
+    EXPECT_EQ(1, ImageDecodingStore::instance()->decoderCacheEntries());
+
+    ImageDecoder* tempDecoder = 0;
+    EXPECT_FALSE(ImageDecodingStore::instance()->lockDecoder(m_generator.get(), fullSize(), &tempDecoder));
+    EXPECT_TRUE(ImageDecodingStore::instance()->lockDecoder(m_generator.get(), SkISize::Make(50, 50), &tempDecoder));
+    ImageDecodingStore::instance()->unlockDecoder(m_generator.get(), tempDecoder);
+    EXPECT_EQ(0, m_decodersDestroyed);
+}
+
 TEST_F(ImageFrameGeneratorTest, frameHasAlpha)
 {
     setFrameStatus(ImageFrame::FramePartial);
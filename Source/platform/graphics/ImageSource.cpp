@@ -29,6 +29,7 @@
 #include "platform/graphics/ImageSource.h"
 
 #include "platform/graphics/DeferredImageDecoder.h"
+#include "platform/graphics/skia/NativeImageSkia.h"
 #include "platform/image-decoders/ImageDecoder.h"
 
 namespace blink {
@@ -135,6 +136,17 @@ PassRefPtr<NativeImageSkia> ImageSource::createFrameAtIndex(size_t index)
     return buffer->asNewNativeImage();
 }
 
+PassRefPtr<NativeImageSkia> ImageSource::createScaledFrameAtIndex(size_t index, const IntSize& minimumSize)
+{
+    if (!m_decoder)
+        return nullptr;
+
+    SkBitmap bitmap = m_decoder->scaledFrameBitmapAtIndex(index, minimumSize);
+    if (bitmap.isNull())
+        return nullptr;
+    return NativeImageSkia::create(bitmap);
+}
+
 float ImageSource::frameDurationAtIndex(size_t index) const
 {
     if (!m_decoder)
@@ -117,6 +117,11 @@ public:
 
     PassRefPtr<NativeImageSkia> createFrameAtIndex(size_t);
 
+    // Returns the frame decoded at a reduced size no smaller than
+    // |minimumSize|, or 0 if the decoder can't provide one. See
+    // DeferredImageDecoder::scaledFrameBitmapAtIndex().
+    PassRefPtr<NativeImageSkia> createScaledFrameAtIndex(size_t, const IntSize& minimumSize);
+
     float frameDurationAtIndex(size_t) const;
     bool frameHasAlphaAtIndex(size_t) const; // Whether or not the frame actually used any alpha.
     bool frameIsCompleteAtIndex(size_t) const; // Whether or not the frame is fully received.
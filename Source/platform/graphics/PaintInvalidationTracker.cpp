@@ -0,0 +1,76 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/PaintInvalidationTracker.h"
+
+#include <limits>
+
+namespace blink {
+
+const unsigned PaintInvalidationTracker::perRectCostInPixels;
+const size_t PaintInvalidationTracker::maxCoalescedRects;
+const size_t PaintInvalidationTracker::maxCandidateRects;
+
+static int64_t area(const IntRect& rect)
+{
+    return static_cast<int64_t>(rect.size().area());
+}
+
+void PaintInvalidationTracker::invalidate(const IntRect& rect)
+{
+    if (rect.isEmpty())
+        return;
+
+    ++m_statistics.requestedRects;
+    m_pendingRegion.unite(rect);
+}
+
+Vector<IntRect> PaintInvalidationTracker::takeCoalescedRects()
+{
+    Vector<IntRect> rects;
+    if (m_pendingRegion.isEmpty())
+        return rects;
+
+    m_statistics.changedPixels += m_pendingRegion.totalArea();
+
+    rects = m_pendingRegion.rects();
+    if (rects.size() > maxCandidateRects) {
+        rects.clear();
+        rects.append(m_pendingRegion.bounds());
+    }
+    m_pendingRegion = Region();
+
+    // Greedily merge the pair whose bounds waste the fewest pixels until the
+    // cheapest merge costs more than the rect it saves. The rects of a Region
+    // don't overlap, so the waste of a merge is never negative to start with.
+    while (rects.size() > 1) {
+        size_t bestFirst = 0;
+        size_t bestSecond = 1;
+        int64_t bestWaste = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < rects.size(); ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                int64_t waste = area(unionRect(rects[i], rects[j])) - area(rects[i]) - area(rects[j]);
+                if (waste < bestWaste) {
+                    bestWaste = waste;
+                    bestFirst = i;
+                    bestSecond = j;
+                }
+            }
+        }
+
+        if (bestWaste > static_cast<int64_t>(perRectCostInPixels) && rects.size() <= maxCoalescedRects)
+            break;
+
+        rects[bestFirst].unite(rects[bestSecond]);
+        rects.remove(bestSecond);
+    }
+
+    m_statistics.invalidatedRects += rects.size();
+    for (size_t i = 0; i < rects.size(); ++i)
+        m_statistics.invalidatedPixels += area(rects[i]);
+    return rects;
+}
+
+} // namespace blink
@@ -0,0 +1,75 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PaintInvalidationTracker_h
+#define PaintInvalidationTracker_h
+
+#include "platform/PlatformExport.h"
+#include "platform/geometry/IntRect.h"
+#include "platform/geometry/Region.h"
+#include "wtf/FastAllocBase.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+// Accumulates the rects a GraphicsLayer is asked to invalidate during a
+// lifecycle update so that they can be handed to the compositor as a few
+// well-chosen rects instead of one per renderer. The pending invalidation is
+// kept as a Region, so overlapping and repeated rects only count once, and
+// takeCoalescedRects() merges neighbouring pieces whenever the extra area
+// that would be repainted costs less than issuing another rect.
+class PLATFORM_EXPORT PaintInvalidationTracker {
+    WTF_MAKE_NONCOPYABLE(PaintInvalidationTracker); WTF_MAKE_FAST_ALLOCATED;
+public:
+    struct Statistics {
+        Statistics()
+            : requestedRects(0)
+            , changedPixels(0)
+            , invalidatedRects(0)
+            , invalidatedPixels(0)
+        {
+        }
+
+        // Rects passed to invalidate(), and the area of their union.
+        unsigned requestedRects;
+        uint64_t changedPixels;
+        // Rects returned by takeCoalescedRects(), and their total area.
+        unsigned invalidatedRects;
+        uint64_t invalidatedPixels;
+    };
+
+    PaintInvalidationTracker() { }
+
+    void invalidate(const IntRect&);
+    bool hasPendingInvalidations() const { return !m_pendingRegion.isEmpty(); }
+
+    // Returns rects covering everything invalidated since the last call and
+    // forgets about them.
+    Vector<IntRect> takeCoalescedRects();
+
+    // Drops the pending rects without reporting them, e.g. because the whole
+    // layer has been invalidated instead.
+    void clearPendingInvalidations() { m_pendingRegion = Region(); }
+
+    const Statistics& statistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = Statistics(); }
+
+    // The price of issuing one more rect, expressed as the number of pixels
+    // that could be repainted for the same cost. Two rects are merged if the
+    // area their bounds add is below this.
+    static const unsigned perRectCostInPixels = 128 * 128;
+    // Never issue more than this many rects for one layer, whatever the cost.
+    static const size_t maxCoalescedRects = 16;
+    // Regions made of more pieces than this are invalidated by their bounds.
+    static const size_t maxCandidateRects = 64;
+
+private:
+    Region m_pendingRegion;
+    Statistics m_statistics;
+};
+
+} // namespace blink
+
+#endif // PaintInvalidationTracker_h
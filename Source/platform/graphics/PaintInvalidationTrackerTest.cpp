@@ -0,0 +1,91 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/PaintInvalidationTracker.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+TEST(PaintInvalidationTrackerTest, RepeatedRectsAreIssuedOnce)
+{
+    PaintInvalidationTracker tracker;
+    tracker.invalidate(IntRect(10, 10, 50, 50));
+    tracker.invalidate(IntRect(10, 10, 50, 50));
+    tracker.invalidate(IntRect(20, 20, 10, 10));
+
+    Vector<IntRect> rects = tracker.takeCoalescedRects();
+    ASSERT_EQ(1u, rects.size());
+    EXPECT_EQ(IntRect(10, 10, 50, 50), rects[0]);
+    EXPECT_FALSE(tracker.hasPendingInvalidations());
+    EXPECT_TRUE(tracker.takeCoalescedRects().isEmpty());
+
+    EXPECT_EQ(3u, tracker.statistics().requestedRects);
+    EXPECT_EQ(2500u, tracker.statistics().changedPixels);
+    EXPECT_EQ(1u, tracker.statistics().invalidatedRects);
+    EXPECT_EQ(2500u, tracker.statistics().invalidatedPixels);
+}
+
+TEST(PaintInvalidationTrackerTest, NearbyRectsAreMerged)
+{
+    PaintInvalidationTracker tracker;
+    tracker.invalidate(IntRect(0, 0, 100, 10));
+    tracker.invalidate(IntRect(0, 12, 100, 10));
+
+    Vector<IntRect> rects = tracker.takeCoalescedRects();
+    ASSERT_EQ(1u, rects.size());
+    EXPECT_EQ(IntRect(0, 0, 100, 22), rects[0]);
+    EXPECT_EQ(2000u, tracker.statistics().changedPixels);
+    EXPECT_EQ(2200u, tracker.statistics().invalidatedPixels);
+}
+
+TEST(PaintInvalidationTrackerTest, DistantRectsAreKeptApart)
+{
+    PaintInvalidationTracker tracker;
+    tracker.invalidate(IntRect(0, 0, 10, 10));
+    tracker.invalidate(IntRect(1000, 1000, 10, 10));
+
+    Vector<IntRect> rects = tracker.takeCoalescedRects();
+    EXPECT_EQ(2u, rects.size());
+    EXPECT_EQ(200u, tracker.statistics().invalidatedPixels);
+}
+
+TEST(PaintInvalidationTrackerTest, RectCountIsBounded)
+{
+    PaintInvalidationTracker tracker;
+    for (int i = 0; i < 40; ++i)
+        tracker.invalidate(IntRect(i * 1000, i * 1000, 10, 10));
+
+    Vector<IntRect> rects = tracker.takeCoalescedRects();
+    EXPECT_LE(rects.size(), PaintInvalidationTracker::maxCoalescedRects);
+
+    // Everything that was invalidated must still be covered.
+    for (int i = 0; i < 40; ++i) {
+        IntRect invalidated(i * 1000, i * 1000, 10, 10);
+        bool covered = false;
+        for (size_t j = 0; j < rects.size(); ++j)
+            covered |= rects[j].contains(invalidated);
+        EXPECT_TRUE(covered);
+    }
+}
+
+TEST(PaintInvalidationTrackerTest, ClearingDropsPendingRects)
+{
+    PaintInvalidationTracker tracker;
+    tracker.invalidate(IntRect(0, 0, 10, 10));
+    tracker.invalidate(IntRect());
+    EXPECT_TRUE(tracker.hasPendingInvalidations());
+
+    tracker.clearPendingInvalidations();
+    EXPECT_FALSE(tracker.hasPendingInvalidations());
+    EXPECT_TRUE(tracker.takeCoalescedRects().isEmpty());
+    EXPECT_EQ(1u, tracker.statistics().requestedRects);
+}
+
+} // namespace
+
+} // namespace blink
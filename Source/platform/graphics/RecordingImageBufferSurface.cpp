@@ -6,8 +6,10 @@
 
 #include "platform/graphics/RecordingImageBufferSurface.h"
 
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/graphics/GraphicsContext.h"
 #include "platform/graphics/ImageBuffer.h"
+#include "platform/graphics/TiledPictureRasterizer.h"
 #include "public/platform/Platform.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
@@ -74,17 +76,34 @@ void RecordingImageBufferSurface::fallBackToRasterCanvas()
         return;
     }
 
-    m_rasterCanvas = adoptPtr(SkCanvas::NewRasterN32(size().width(), size().height()));
-
-    if (m_previousFrame) {
-        m_previousFrame->draw(m_rasterCanvas.get());
-        m_previousFrame.clear();
+    if (RuntimeEnabledFeatures::parallelRasterizationEnabled()) {
+        // The frames were recorded with an R-tree, so they can be played back
+        // tile by tile on several threads straight into the new backing store.
+        SkBitmap bitmap;
+        if (bitmap.allocN32Pixels(size().width(), size().height())) {
+            bitmap.eraseColor(SK_ColorTRANSPARENT);
+            if (m_previousFrame)
+                TiledPictureRasterizer::rasterize(m_previousFrame.get(), bitmap);
+            if (m_currentFrame) {
+                RefPtr<SkPicture> currentPicture = adoptRef(m_currentFrame->endRecording());
+                TiledPictureRasterizer::rasterize(currentPicture.get(), bitmap);
+            }
+            m_rasterCanvas = adoptPtr(new SkCanvas(bitmap));
+        }
     }
-    if (m_currentFrame) {
-        RefPtr<SkPicture> currentPicture = adoptRef(m_currentFrame->endRecording());
-        currentPicture->draw(m_rasterCanvas.get());
-        m_currentFrame.clear();
+
+    if (!m_rasterCanvas) {
+        m_rasterCanvas = adoptPtr(SkCanvas::NewRasterN32(size().width(), size().height()));
+
+        if (m_previousFrame)
+            m_previousFrame->draw(m_rasterCanvas.get());
+        if (m_currentFrame) {
+            RefPtr<SkPicture> currentPicture = adoptRef(m_currentFrame->endRecording());
+            currentPicture->draw(m_rasterCanvas.get());
+        }
     }
+    m_previousFrame.clear();
+    m_currentFrame.clear();
 
     if (m_imageBuffer) {
         m_imageBuffer->context()->setRegionTrackingMode(GraphicsContext::RegionTrackingDisabled);
@@ -30,6 +30,7 @@ public:
     virtual SkCanvas* canvas() const OVERRIDE;
     virtual PassRefPtr<SkPicture> getPicture() OVERRIDE;
     virtual bool isValid() const OVERRIDE { return true; }
+    virtual bool isRecording() const OVERRIDE { return !m_rasterCanvas; }
     virtual void willAccessPixels() OVERRIDE;
     virtual void finalizeFrame(const FloatRect&) OVERRIDE;
     virtual void didClearCanvas() OVERRIDE;
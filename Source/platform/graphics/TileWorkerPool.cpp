@@ -0,0 +1,181 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/TileWorkerPool.h"
+
+#include "platform/Task.h"
+#include "platform/TraceEvent.h"
+#include "public/platform/Platform.h"
+#include "wtf/Functional.h"
+#include "wtf/ThreadSafeRefCounted.h"
+#include "wtf/Threading.h"
+
+#include <algorithm>
+
+namespace blink {
+
+const size_t TileWorkerPool::tileSizeInBytes;
+
+// One call to runTiles(). Workers that only get to their task after the last
+// tile has been taken find nothing to do, so a job is ref counted rather than
+// owned by the caller, who only waits for the tiles.
+class TileWorkerPool::Job : public ThreadSafeRefCounted<Job> {
+public:
+    Job(const char* name, size_t tileCount, TileFunction function, void* context, size_t participants)
+        : m_name(name)
+        , m_function(function)
+        , m_context(context)
+        , m_remainingTiles(tileCount)
+    {
+        m_slices.resize(participants);
+        for (size_t i = 0; i < participants; ++i) {
+            m_slices[i].begin = tileCount * i / participants;
+            m_slices[i].end = tileCount * (i + 1) / participants;
+        }
+    }
+
+    void run(size_t participant)
+    {
+        TRACE_EVENT2("blink", "TileWorkerPool::runTiles", "job", m_name, "participant", static_cast<int>(participant));
+        size_t tile;
+        while (takeTile(participant, &tile)) {
+            m_function(m_context, tile);
+
+            MutexLocker lock(m_doneMutex);
+            ASSERT(m_remainingTiles);
+            if (!--m_remainingTiles)
+                m_doneCondition.signal();
+        }
+    }
+
+    void waitUntilDone()
+    {
+        MutexLocker lock(m_doneMutex);
+        while (m_remainingTiles)
+            m_doneCondition.wait(m_doneMutex);
+    }
+
+private:
+    struct Slice {
+        size_t begin;
+        size_t end;
+    };
+
+    bool takeTile(size_t participant, size_t* tile)
+    {
+        MutexLocker lock(m_slicesMutex);
+        Slice& slice = m_slices[participant];
+        if (slice.begin == slice.end) {
+            size_t victim = 0;
+            size_t largestSize = 0;
+            for (size_t i = 0; i < m_slices.size(); ++i) {
+                size_t size = m_slices[i].end - m_slices[i].begin;
+                if (size > largestSize) {
+                    largestSize = size;
+                    victim = i;
+                }
+            }
+            if (!largestSize)
+                return false;
+
+            size_t stolen = (largestSize + 1) / 2;
+            slice.end = m_slices[victim].end;
+            slice.begin = slice.end - stolen;
+            m_slices[victim].end = slice.begin;
+        }
+        *tile = slice.begin++;
+        return true;
+    }
+
+    const char* m_name;
+    TileFunction m_function;
+    void* m_context;
+
+    Vector<Slice> m_slices;
+    Mutex m_slicesMutex;
+
+    size_t m_remainingTiles;
+    Mutex m_doneMutex;
+    ThreadCondition m_doneCondition;
+};
+
+TileWorkerPool* TileWorkerPool::instance()
+{
+    AtomicallyInitializedStatic(TileWorkerPool*, pool = TileWorkerPool::create().leakPtr());
+    return pool;
+}
+
+TileWorkerPool::TileWorkerPool()
+    : m_threadCount(0)
+{
+}
+
+TileWorkerPool::~TileWorkerPool()
+{
+}
+
+void TileWorkerPool::setThreadCount(unsigned count)
+{
+    MutexLocker lock(m_mutex);
+    m_threadCount = count;
+}
+
+size_t TileWorkerPool::threadCount()
+{
+    MutexLocker lock(m_mutex);
+    if (m_threadCount)
+        return m_threadCount;
+    return std::max(Platform::current()->numberOfProcessors(), static_cast<size_t>(1));
+}
+
+size_t TileWorkerPool::rowsPerTile(size_t bytesPerRow)
+{
+    if (!bytesPerRow)
+        return 1;
+    return std::max(tileSizeInBytes / bytesPerRow, static_cast<size_t>(1));
+}
+
+Vector<WebThread*> TileWorkerPool::takeWorkers(size_t count)
+{
+    MutexLocker lock(m_mutex);
+    while (m_workers.size() < count) {
+        OwnPtr<WebThread> worker = adoptPtr(Platform::current()->createThread("Blink Tile Worker"));
+        if (!worker)
+            break;
+        m_workers.append(worker.release());
+    }
+
+    Vector<WebThread*> workers;
+    for (size_t i = 0; i < m_workers.size() && i < count; ++i)
+        workers.append(m_workers[i].get());
+    return workers;
+}
+
+void TileWorkerPool::runTiles(const char* jobName, size_t tileCount, TileFunction function, void* context, size_t maxThreads)
+{
+    if (!tileCount)
+        return;
+
+    size_t participants = std::min(tileCount, maxThreads ? maxThreads : threadCount());
+    Vector<WebThread*> workers;
+    if (participants > 1)
+        workers = takeWorkers(participants - 1);
+    participants = workers.size() + 1;
+
+    if (participants < 2) {
+        TRACE_EVENT1("blink", "TileWorkerPool::runTiles", "job", jobName);
+        for (size_t i = 0; i < tileCount; ++i)
+            function(context, i);
+        return;
+    }
+
+    RefPtr<Job> job = adoptRef(new Job(jobName, tileCount, function, context, participants));
+    for (size_t i = 0; i < workers.size(); ++i)
+        workers[i]->postTask(new Task(WTF::bind(&Job::run, job, i + 1)));
+    job->run(0);
+    job->waitUntilDone();
+}
+
+} // namespace blink
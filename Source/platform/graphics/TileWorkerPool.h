@@ -0,0 +1,75 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TileWorkerPool_h
+#define TileWorkerPool_h
+
+#include "platform/PlatformExport.h"
+#include "public/platform/WebThread.h"
+#include "wtf/FastAllocBase.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/OwnPtr.h"
+#include "wtf/PassOwnPtr.h"
+#include "wtf/ThreadingPrimitives.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+// Runs a function over a range of tiles, spread over persistent worker
+// threads and the calling thread. Every participant starts on its own slice
+// of the tiles; one that runs out steals the back half of the largest slice
+// left, so uneven tiles don't leave threads idle while one still has a queue.
+//
+// Tiles should be small enough to stay in cache and large enough that taking
+// one, a lock and a few compares, is cheap next to running it; see
+// rowsPerTile().
+//
+// THREAD SAFETY
+//
+// runTiles() can be called on any thread, including from a tile. It only
+// returns once every tile has run, so the function and its context can live
+// on the caller's stack.
+class PLATFORM_EXPORT TileWorkerPool {
+    WTF_MAKE_NONCOPYABLE(TileWorkerPool); WTF_MAKE_FAST_ALLOCATED;
+public:
+    typedef void (*TileFunction)(void* context, size_t tileIndex);
+
+    static PassOwnPtr<TileWorkerPool> create() { return adoptPtr(new TileWorkerPool); }
+    ~TileWorkerPool();
+
+    static TileWorkerPool* instance();
+
+    // Calls function(context, i) for every i in [0, tileCount). At most
+    // |maxThreads| threads, the caller included, run tiles; zero means
+    // threadCount(). |jobName| must be a string literal; it names the job in
+    // the trace events of every thread that takes part.
+    void runTiles(const char* jobName, size_t tileCount, TileFunction, void* context, size_t maxThreads = 0);
+
+    // The number of threads, the caller included, that share a job. Zero,
+    // the default, uses one thread per processor.
+    void setThreadCount(unsigned);
+    size_t threadCount();
+
+    // The number of rows of |bytesPerRow| bytes that fit in a tile.
+    static size_t rowsPerTile(size_t bytesPerRow);
+
+    static const size_t tileSizeInBytes = 64 * 1024;
+
+private:
+    class Job;
+
+    TileWorkerPool();
+
+    // Returns up to |count| workers, creating them as needed. Workers are
+    // never destroyed, so the pointers stay valid outside the lock.
+    Vector<WebThread*> takeWorkers(size_t count);
+
+    Vector<OwnPtr<WebThread> > m_workers;
+    unsigned m_threadCount;
+    Mutex m_mutex; // Guards m_workers and m_threadCount.
+};
+
+} // namespace blink
+
+#endif // TileWorkerPool_h
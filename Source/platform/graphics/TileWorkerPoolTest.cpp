@@ -0,0 +1,139 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/TileWorkerPool.h"
+
+#include "public/platform/Platform.h"
+#include "public/platform/WebThread.h"
+#include "wtf/Vector.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+// Hands out threads that run their tasks as soon as they are posted, so the
+// pool can be exercised deterministically.
+class ImmediateThreadPlatform : public Platform {
+public:
+    ImmediateThreadPlatform()
+        : m_oldPlatform(Platform::current())
+        , m_threadCount(0)
+    {
+        Platform::initialize(this);
+    }
+
+    virtual ~ImmediateThreadPlatform()
+    {
+        Platform::initialize(m_oldPlatform);
+    }
+
+    virtual void cryptographicallyRandomValues(unsigned char* buffer, size_t length) OVERRIDE { ASSERT_NOT_REACHED(); }
+    virtual const unsigned char* getTraceCategoryEnabledFlag(const char* categoryName) OVERRIDE
+    {
+        return m_oldPlatform->getTraceCategoryEnabledFlag(categoryName);
+    }
+    virtual size_t numberOfProcessors() OVERRIDE { return 4; }
+    virtual WebThread* createThread(const char*) OVERRIDE
+    {
+        ++m_threadCount;
+        return new ImmediateThread;
+    }
+
+    unsigned threadCount() const { return m_threadCount; }
+
+private:
+    class ImmediateThread : public WebThread {
+    public:
+        virtual void postTask(Task* task) OVERRIDE
+        {
+            task->run();
+            delete task;
+        }
+        virtual void postDelayedTask(Task*, long long) OVERRIDE { ASSERT_NOT_REACHED(); }
+        virtual bool isCurrentThread() const OVERRIDE { return false; }
+        virtual void enterRunLoop() OVERRIDE { ASSERT_NOT_REACHED(); }
+        virtual void exitRunLoop() OVERRIDE { ASSERT_NOT_REACHED(); }
+    };
+
+    Platform* m_oldPlatform;
+    unsigned m_threadCount;
+};
+
+void countTile(void* context, size_t tileIndex)
+{
+    Vector<unsigned>* runs = static_cast<Vector<unsigned>*>(context);
+    ++runs->at(tileIndex);
+}
+
+void expectEveryTileRanOnce(const Vector<unsigned>& runs)
+{
+    for (size_t i = 0; i < runs.size(); ++i)
+        EXPECT_EQ(1u, runs[i]) << "tile " << i;
+}
+
+TEST(TileWorkerPoolTest, EveryTileRunsOnce)
+{
+    ImmediateThreadPlatform platform;
+    OwnPtr<TileWorkerPool> pool = TileWorkerPool::create();
+
+    Vector<unsigned> runs(37);
+    runs.fill(0);
+    pool->runTiles("test", runs.size(), &countTile, &runs);
+    expectEveryTileRanOnce(runs);
+    EXPECT_EQ(3u, platform.threadCount());
+}
+
+TEST(TileWorkerPoolTest, ThreadsAreKeptAndCapped)
+{
+    ImmediateThreadPlatform platform;
+    OwnPtr<TileWorkerPool> pool = TileWorkerPool::create();
+
+    Vector<unsigned> runs(10);
+    runs.fill(0);
+    pool->runTiles("test", runs.size(), &countTile, &runs, 2);
+    expectEveryTileRanOnce(runs);
+    EXPECT_EQ(1u, platform.threadCount());
+
+    runs.fill(0);
+    pool->runTiles("test", runs.size(), &countTile, &runs);
+    expectEveryTileRanOnce(runs);
+    EXPECT_EQ(3u, platform.threadCount());
+
+    // No more threads than tiles.
+    runs.resize(2);
+    runs.fill(0);
+    pool->setThreadCount(8);
+    pool->runTiles("test", runs.size(), &countTile, &runs);
+    expectEveryTileRanOnce(runs);
+    EXPECT_EQ(3u, platform.threadCount());
+}
+
+TEST(TileWorkerPoolTest, SingleThreadRunsInline)
+{
+    ImmediateThreadPlatform platform;
+    OwnPtr<TileWorkerPool> pool = TileWorkerPool::create();
+    pool->setThreadCount(1);
+    EXPECT_EQ(1u, pool->threadCount());
+
+    Vector<unsigned> runs(5);
+    runs.fill(0);
+    pool->runTiles("test", runs.size(), &countTile, &runs);
+    expectEveryTileRanOnce(runs);
+    EXPECT_EQ(0u, platform.threadCount());
+
+    pool->runTiles("test", 0, &countTile, &runs);
+    expectEveryTileRanOnce(runs);
+}
+
+TEST(TileWorkerPoolTest, RowsPerTile)
+{
+    EXPECT_EQ(TileWorkerPool::tileSizeInBytes / 1024, TileWorkerPool::rowsPerTile(1024));
+    EXPECT_EQ(1u, TileWorkerPool::rowsPerTile(TileWorkerPool::tileSizeInBytes * 2));
+    EXPECT_EQ(1u, TileWorkerPool::rowsPerTile(0));
+}
+
+} // namespace
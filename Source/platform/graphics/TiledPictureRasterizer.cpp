@@ -0,0 +1,62 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/TiledPictureRasterizer.h"
+
+#include "platform/TraceEvent.h"
+#include "platform/graphics/TileWorkerPool.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace blink {
+
+// Below this many pixels, starting worker threads costs more than it saves.
+static const int minimumParallelArea = 512 * 512;
+
+unsigned TiledPictureRasterizer::s_threadCount = 0;
+
+void TiledPictureRasterizer::rasterizeTile(void* context, size_t tileIndex)
+{
+    TileJob* job = static_cast<TileJob*>(context);
+    const IntRect& tile = job->tiles->at(tileIndex);
+    SkBitmap tileBitmap;
+    if (!job->bitmap->extractSubset(&tileBitmap, tile))
+        return;
+    SkCanvas canvas(tileBitmap);
+    canvas.translate(-tile.x(), -tile.y());
+    canvas.drawPicture(job->picture);
+}
+
+void TiledPictureRasterizer::rasterize(const SkPicture* picture, const SkBitmap& bitmap)
+{
+    ASSERT(picture);
+    IntRect bounds(0, 0, bitmap.width(), bitmap.height());
+    if (bounds.isEmpty())
+        return;
+
+    TRACE_EVENT2("blink", "TiledPictureRasterizer::rasterize", "width", bounds.width(), "height", bounds.height());
+
+    Vector<IntRect> tiles;
+    for (int y = 0; y < bounds.height(); y += tileSize) {
+        for (int x = 0; x < bounds.width(); x += tileSize)
+            tiles.append(intersection(bounds, IntRect(x, y, tileSize, tileSize)));
+    }
+
+    SkAutoLockPixels lock(bitmap);
+
+    TileJob job = { picture, &bitmap, &tiles };
+    if (bounds.width() * bounds.height() < minimumParallelArea) {
+        for (size_t i = 0; i < tiles.size(); ++i)
+            rasterizeTile(&job, i);
+        return;
+    }
+
+    // Threads that run out of tiles steal from the others, so a cluster of
+    // expensive content near the top of the picture does not hold up the rest.
+    TileWorkerPool::instance()->runTiles("TiledPictureRasterizer", tiles.size(), &TiledPictureRasterizer::rasterizeTile, &job, s_threadCount);
+}
+
+} // namespace blink
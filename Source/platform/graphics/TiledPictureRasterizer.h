@@ -0,0 +1,50 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TiledPictureRasterizer_h
+#define TiledPictureRasterizer_h
+
+#include "platform/PlatformExport.h"
+#include "platform/geometry/IntRect.h"
+#include "wtf/Vector.h"
+
+class SkBitmap;
+class SkPicture;
+
+namespace blink {
+
+// Plays an SkPicture back into a raster bitmap one tile at a time and hands
+// the tiles out to TileWorkerPool threads. Every tile gets its own canvas
+// over a subset of the bitmap, so the threads never write the same pixels, and
+// a picture recorded with a bounding box hierarchy (see SkRTreeFactory) only
+// replays the draw commands that intersect each tile.
+class PLATFORM_EXPORT TiledPictureRasterizer {
+public:
+    // Draws the picture over the current contents of the bitmap. The bitmap's
+    // origin is the picture's origin.
+    static void rasterize(const SkPicture*, const SkBitmap&);
+
+    // The number of threads rasterize() may spread tiles over. Zero, the
+    // default, uses one thread per processor.
+    static void setThreadCount(unsigned count) { s_threadCount = count; }
+    static unsigned threadCount() { return s_threadCount; }
+
+    static const int tileSize = 256;
+
+private:
+    struct TileJob {
+        const SkPicture* picture;
+        const SkBitmap* bitmap;
+        const Vector<IntRect>* tiles;
+    };
+
+    // A TileWorkerPool::TileFunction.
+    static void rasterizeTile(void* job, size_t tileIndex);
+
+    static unsigned s_threadCount;
+};
+
+} // namespace blink
+
+#endif // TiledPictureRasterizer_h
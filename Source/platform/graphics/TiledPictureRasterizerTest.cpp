@@ -0,0 +1,188 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+
+#include "platform/graphics/TiledPictureRasterizer.h"
+
+#include "public/platform/Platform.h"
+#include "public/platform/WebThread.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "wtf/PassRefPtr.h"
+#include "wtf/RefPtr.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+// Hands out threads that run their tasks as soon as they are posted, so that
+// the parallel code path can be exercised without a real thread pool.
+class ImmediateThreadPlatform : public Platform {
+public:
+    ImmediateThreadPlatform()
+        : m_oldPlatform(Platform::current())
+        , m_threadCount(0)
+    {
+        Platform::initialize(this);
+    }
+
+    virtual ~ImmediateThreadPlatform()
+    {
+        Platform::initialize(m_oldPlatform);
+    }
+
+    virtual void cryptographicallyRandomValues(unsigned char* buffer, size_t length) OVERRIDE { ASSERT_NOT_REACHED(); }
+    virtual const unsigned char* getTraceCategoryEnabledFlag(const char* categoryName) OVERRIDE
+    {
+        return m_oldPlatform->getTraceCategoryEnabledFlag(categoryName);
+    }
+    virtual size_t numberOfProcessors() OVERRIDE { return 4; }
+    virtual WebThread* createThread(const char*) OVERRIDE
+    {
+        ++m_threadCount;
+        return new ImmediateThread;
+    }
+
+    unsigned threadCount() const { return m_threadCount; }
+
+private:
+    class ImmediateThread : public WebThread {
+    public:
+        virtual void postTask(Task* task) OVERRIDE
+        {
+            task->run();
+            delete task;
+        }
+        virtual void postDelayedTask(Task*, long long) OVERRIDE { ASSERT_NOT_REACHED(); }
+        virtual bool isCurrentThread() const OVERRIDE { return false; }
+        virtual void enterRunLoop() OVERRIDE { ASSERT_NOT_REACHED(); }
+        virtual void exitRunLoop() OVERRIDE { ASSERT_NOT_REACHED(); }
+    };
+
+    Platform* m_oldPlatform;
+    unsigned m_threadCount;
+};
+
+class TiledPictureRasterizerTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        m_threadCount = TiledPictureRasterizer::threadCount();
+    }
+
+    virtual void TearDown()
+    {
+        TiledPictureRasterizer::setThreadCount(m_threadCount);
+    }
+
+    // A grid of overlapping, translucent circles and rects that straddle
+    // tile boundaries, recorded with an R-tree like RecordingImageBufferSurface.
+    PassRefPtr<SkPicture> recordPicture(int width, int height)
+    {
+        SkRTreeFactory rTreeFactory;
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(width, height, &rTreeFactory);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int y = 0; y < height; y += 90) {
+            for (int x = 0; x < width; x += 110) {
+                paint.setColor(SkColorSetARGB(0xC0, x % 255, y % 255, (x + y) % 255));
+                canvas->drawCircle(x + 20, y + 30, 70, paint);
+                paint.setColor(SkColorSetARGB(0x80, y % 255, 0x40, x % 255));
+                canvas->drawRect(SkRect::MakeXYWH(x + 50, y - 10, 90, 40), paint);
+            }
+        }
+        return adoptRef(recorder.endRecording());
+    }
+
+    void allocate(SkBitmap& bitmap, int width, int height)
+    {
+        ASSERT_TRUE(bitmap.allocN32Pixels(width, height));
+        bitmap.eraseColor(SK_ColorWHITE);
+    }
+
+    void expectSamePixels(const SkBitmap& expected, const SkBitmap& actual)
+    {
+        ASSERT_EQ(expected.width(), actual.width());
+        ASSERT_EQ(expected.height(), actual.height());
+        SkAutoLockPixels expectedLock(expected);
+        SkAutoLockPixels actualLock(actual);
+        for (int y = 0; y < expected.height(); ++y) {
+            for (int x = 0; x < expected.width(); ++x) {
+                if (*expected.getAddr32(x, y) != *actual.getAddr32(x, y)) {
+                    ADD_FAILURE() << "Pixels differ at (" << x << ", " << y << ")";
+                    return;
+                }
+            }
+        }
+    }
+
+    void expectMatchesDirectPlayback(int width, int height)
+    {
+        RefPtr<SkPicture> picture = recordPicture(width, height);
+        SkBitmap expected;
+        allocate(expected, width, height);
+        SkCanvas canvas(expected);
+        canvas.drawPicture(picture.get());
+
+        SkBitmap actual;
+        allocate(actual, width, height);
+        TiledPictureRasterizer::rasterize(picture.get(), actual);
+        expectSamePixels(expected, actual);
+    }
+
+private:
+    unsigned m_threadCount;
+};
+
+TEST_F(TiledPictureRasterizerTest, TiledPlaybackMatchesDirectPlayback)
+{
+    TiledPictureRasterizer::setThreadCount(1);
+    expectMatchesDirectPlayback(700, 500);
+}
+
+TEST_F(TiledPictureRasterizerTest, ParallelPlaybackMatchesDirectPlayback)
+{
+    ImmediateThreadPlatform platform;
+    TiledPictureRasterizer::setThreadCount(4);
+    expectMatchesDirectPlayback(1000, 700);
+    // TileWorkerPool keeps its threads, so an earlier test may have made them.
+    EXPECT_LE(platform.threadCount(), 3u);
+}
+
+TEST_F(TiledPictureRasterizerTest, SmallPicturesStayOnTheCallingThread)
+{
+    ImmediateThreadPlatform platform;
+    TiledPictureRasterizer::setThreadCount(4);
+    expectMatchesDirectPlayback(300, 200);
+    EXPECT_EQ(0u, platform.threadCount());
+}
+
+TEST_F(TiledPictureRasterizerTest, DrawsOverExistingContents)
+{
+    SkPictureRecorder recorder;
+    SkCanvas* recordingCanvas = recorder.beginRecording(600, 600, 0);
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    recordingCanvas->drawRect(SkRect::MakeXYWH(250, 250, 20, 20), paint);
+    RefPtr<SkPicture> picture = adoptRef(recorder.endRecording());
+
+    SkBitmap bitmap;
+    allocate(bitmap, 600, 600);
+    TiledPictureRasterizer::rasterize(picture.get(), bitmap);
+
+    SkAutoLockPixels lock(bitmap);
+    EXPECT_EQ(SK_ColorRED, bitmap.getColor(255, 255));
+    EXPECT_EQ(SK_ColorRED, bitmap.getColor(260, 260));
+    EXPECT_EQ(SK_ColorWHITE, bitmap.getColor(245, 255));
+    EXPECT_EQ(SK_ColorWHITE, bitmap.getColor(0, 0));
+    EXPECT_EQ(SK_ColorWHITE, bitmap.getColor(599, 599));
+}
+
+} // namespace
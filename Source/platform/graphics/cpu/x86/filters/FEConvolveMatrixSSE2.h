@@ -0,0 +1,91 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FEConvolveMatrixSSE2_h
+#define FEConvolveMatrixSSE2_h
+
+#if CPU(X86) || CPU(X86_64)
+
+#include "platform/graphics/filters/FEConvolveMatrix.h"
+#include "wtf/Uint8ClampedArray.h"
+#include <emmintrin.h>
+
+namespace blink {
+
+// Same as fastSetInteriorPixels(), with the four channels of a pixel held in
+// the lanes of one register. Every lane goes through the multiplies and adds
+// of the scalar loop in the same order, so the results are bit-exact.
+template<bool preserveAlphaValues>
+inline void FEConvolveMatrix::fastSetInteriorPixelsSSE2(PaintingData& paintingData, int clipRight, int clipBottom, int yStart, int yEnd)
+{
+    // edge mode does not affect these pixels
+    int pixel = (m_targetOffset.y() * paintingData.width + m_targetOffset.x()) * 4;
+    int kernelIncrease = clipRight * 4;
+    int xIncrease = (m_kernelSize.width() - 1) * 4;
+
+    // m_divisor cannot be 0, SVGFEConvolveMatrixElement ensures this
+    ASSERT(m_divisor);
+
+    // Skip the first '(clipBottom - yEnd)' lines
+    pixel += (clipBottom - yEnd) * (xIncrease + (clipRight + 1) * 4);
+    int startKernelPixel = (clipBottom - yEnd) * (xIncrease + (clipRight + 1) * 4);
+
+    const unsigned char* source = paintingData.srcPixelArray->data();
+    unsigned char* destination = paintingData.dstPixelArray->data();
+    const float* kernel = m_kernelMatrix.data();
+    const int kernelWidth = m_kernelSize.width();
+    const int kernelHeight = m_kernelSize.height();
+    ASSERT(static_cast<int>(m_kernelMatrix.size()) == kernelWidth * kernelHeight);
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 zeroFloat = _mm_setzero_ps();
+    const __m128 maxChannel = _mm_set1_ps(255);
+    const __m128 divisor = _mm_set1_ps(m_divisor);
+    const __m128 bias = _mm_set1_ps(paintingData.bias);
+
+    for (int y = yEnd + 1; y > yStart; --y) {
+        for (int x = clipRight + 1; x > 0; --x) {
+            int kernelValue = m_kernelMatrix.size() - 1;
+            int kernelPixel = startKernelPixel;
+            __m128 totals = zeroFloat;
+
+            for (int kernelY = 0; kernelY < kernelHeight; ++kernelY) {
+                for (int kernelX = 0; kernelX < kernelWidth; ++kernelX) {
+                    __m128i sourcePixel = _mm_cvtsi32_si128(*reinterpret_cast<const int*>(source + kernelPixel));
+                    sourcePixel = _mm_unpacklo_epi16(_mm_unpacklo_epi8(sourcePixel, zero), zero);
+                    totals = _mm_add_ps(totals, _mm_mul_ps(_mm_set1_ps(kernel[kernelValue]), _mm_cvtepi32_ps(sourcePixel)));
+                    kernelPixel += 4;
+                    --kernelValue;
+                }
+                kernelPixel += kernelIncrease;
+            }
+
+            // clampRGBAValue() clamps to [0, max] and then truncates, which is
+            // what min/max followed by a truncating conversion does.
+            __m128 result = _mm_add_ps(_mm_div_ps(totals, divisor), bias);
+            result = _mm_min_ps(_mm_max_ps(result, zeroFloat), maxChannel);
+            if (!preserveAlphaValues) {
+                // Color channels are clamped to the truncated alpha.
+                int alpha = _mm_cvtsi128_si32(_mm_shuffle_epi32(_mm_cvttps_epi32(result), _MM_SHUFFLE(3, 3, 3, 3)));
+                result = _mm_min_ps(result, _mm_set1_ps(static_cast<float>(alpha)));
+            }
+            __m128i channels = _mm_cvttps_epi32(result);
+            channels = _mm_packus_epi16(_mm_packs_epi32(channels, zero), zero);
+            *reinterpret_cast<int*>(destination + pixel) = _mm_cvtsi128_si32(channels);
+            if (preserveAlphaValues)
+                destination[pixel + 3] = source[pixel + 3];
+
+            pixel += 4;
+            startKernelPixel += 4;
+        }
+        pixel += xIncrease;
+        startKernelPixel += xIncrease;
+    }
+}
+
+} // namespace blink
+
+#endif // CPU(X86) || CPU(X86_64)
+
+#endif // FEConvolveMatrixSSE2_h
@@ -0,0 +1,66 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FELightingSSE2_h
+#define FELightingSSE2_h
+
+#if CPU(X86) || CPU(X86_64)
+
+#include "platform/graphics/filters/FELighting.h"
+#include <emmintrin.h>
+
+namespace blink {
+
+// Lights the four consecutive pixels starting at |offset| like
+// inlineSetPixel() would, for a diffuse surface under a distant light. The
+// light vector of a distant light is the same for every pixel, so only the
+// normals differ between the lanes. Each lane does the multiplies, adds,
+// square root and divisions of the scalar code in the same order, so the
+// results are bit-exact. The scalar shortcut for flat pixels is not needed:
+// a normal of (0, 0, 1) produces the same value through the general formula.
+inline void FELighting::setDistantDiffusePixelsSSE2(int offset, LightingData& data, LightSource::PaintingData& paintingData,
+    float factorX, float factorY, const IntPoint normalVectors[4])
+{
+    ASSERT(m_lightingType == DiffuseLighting && data.lightSource->type() == LS_DISTANT);
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1);
+    const __m128 surfaceScale = _mm_set1_ps(data.surfaceScale);
+
+    __m128 normalX = _mm_cvtepi32_ps(_mm_setr_epi32(normalVectors[0].x(), normalVectors[1].x(), normalVectors[2].x(), normalVectors[3].x()));
+    __m128 normalY = _mm_cvtepi32_ps(_mm_setr_epi32(normalVectors[0].y(), normalVectors[1].y(), normalVectors[2].y(), normalVectors[3].y()));
+    normalX = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(factorX), normalX), surfaceScale);
+    normalY = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(factorY), normalY), surfaceScale);
+
+    // FloatPoint3D::length() and FloatPoint3D::dot() with a z of one.
+    __m128 normalLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, normalX), _mm_mul_ps(normalY, normalY)), one));
+    __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, _mm_set1_ps(paintingData.lightVector.x())),
+        _mm_mul_ps(normalY, _mm_set1_ps(paintingData.lightVector.y()))), _mm_set1_ps(paintingData.lightVector.z()));
+
+    __m128 lightStrength = _mm_div_ps(_mm_mul_ps(_mm_set1_ps(m_diffuseConstant), dot),
+        _mm_mul_ps(normalLength, _mm_set1_ps(paintingData.lightVectorLength)));
+    lightStrength = _mm_max_ps(_mm_min_ps(lightStrength, one), zero);
+
+    int red[4];
+    int green[4];
+    int blue[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(red), _mm_cvttps_epi32(_mm_mul_ps(lightStrength, _mm_set1_ps(paintingData.colorVector.x()))));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(green), _mm_cvttps_epi32(_mm_mul_ps(lightStrength, _mm_set1_ps(paintingData.colorVector.y()))));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(blue), _mm_cvttps_epi32(_mm_mul_ps(lightStrength, _mm_set1_ps(paintingData.colorVector.z()))));
+
+    // Alpha is left alone: neighbouring rows, possibly lit on other threads,
+    // still read it to compute their normals.
+    unsigned char* pixels = data.pixels->data() + offset;
+    for (int i = 0; i < 4; ++i, pixels += 4) {
+        pixels[0] = static_cast<unsigned char>(red[i]);
+        pixels[1] = static_cast<unsigned char>(green[i]);
+        pixels[2] = static_cast<unsigned char>(blue[i]);
+    }
+}
+
+} // namespace blink
+
+#endif // CPU(X86) || CPU(X86_64)
+
+#endif // FELightingSSE2_h
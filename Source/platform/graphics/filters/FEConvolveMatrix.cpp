@@ -26,7 +26,9 @@
 #include "platform/graphics/filters/FEConvolveMatrix.h"
 
 #include "SkMatrixConvolutionImageFilter.h"
-#include "platform/graphics/filters/ParallelJobs.h"
+#include "platform/RuntimeEnabledFeatures.h"
+#include "platform/graphics/TileWorkerPool.h"
+#include "platform/graphics/cpu/x86/filters/FEConvolveMatrixSSE2.h"
 #include "platform/graphics/filters/SkiaImageFilterBuilder.h"
 #include "platform/text/TextStream.h"
 #include "wtf/OwnPtr.h"
@@ -403,6 +405,15 @@ ALWAYS_INLINE void FEConvolveMatrix::setInteriorPixels(PaintingData& paintingDat
 {
     // Must be implemented here, since it refers another ALWAYS_INLINE
     // function, which defined in this C++ source file as well
+#if CPU(X86) || CPU(X86_64)
+    if (RuntimeEnabledFeatures::filterSIMDKernelsEnabled()) {
+        if (m_preserveAlpha)
+            fastSetInteriorPixelsSSE2<true>(paintingData, clipRight, clipBottom, yStart, yEnd);
+        else
+            fastSetInteriorPixelsSSE2<false>(paintingData, clipRight, clipBottom, yStart, yEnd);
+        return;
+    }
+#endif
     if (m_preserveAlpha)
         fastSetInteriorPixels<true>(paintingData, clipRight, clipBottom, yStart, yEnd);
     else
@@ -419,9 +430,14 @@ ALWAYS_INLINE void FEConvolveMatrix::setOuterPixels(PaintingData& paintingData,
         fastSetOuterPixels<false>(paintingData, x1, y1, x2, y2);
 }
 
-void FEConvolveMatrix::setInteriorPixelsWorker(InteriorPixelParameters* param)
+void FEConvolveMatrix::setInteriorPixelsTile(void* parameters, size_t tile)
 {
-    param->filter->setInteriorPixels(*param->paintingData, param->clipRight, param->clipBottom, param->yStart, param->yEnd);
+    // setInteriorPixels() covers the rows from yStart to yEnd inclusive, and
+    // the interior has clipBottom + 1 of them.
+    InteriorPixelParameters* param = static_cast<InteriorPixelParameters*>(parameters);
+    int yStart = static_cast<int>(tile) * param->rowsPerTile;
+    int yEnd = std::min(yStart + param->rowsPerTile, param->clipBottom + 1) - 1;
+    param->filter->setInteriorPixels(*param->paintingData, param->clipRight, param->clipBottom, yStart, yEnd);
 }
 
 void FEConvolveMatrix::applySoftware()
@@ -460,27 +476,14 @@ void FEConvolveMatrix::applySoftware()
 
         int optimalThreadNumber = (absolutePaintRect().width() * absolutePaintRect().height()) / s_minimalRectDimension;
         if (optimalThreadNumber > 1) {
-            ParallelJobs<InteriorPixelParameters> parallelJobs(&FEConvolveMatrix::setInteriorPixelsWorker, optimalThreadNumber);
-            const int numOfThreads = parallelJobs.numberOfJobs();
-
-            // Split the job into "heightPerThread" jobs but there a few jobs that need to be slightly larger since
-            // heightPerThread * jobs < total size. These extras are handled by the remainder "jobsWithExtra".
-            const int heightPerThread = clipBottom / numOfThreads;
-            const int jobsWithExtra = clipBottom % numOfThreads;
-
-            int startY = 0;
-            for (int job = 0; job < numOfThreads; ++job) {
-                InteriorPixelParameters& param = parallelJobs.parameter(job);
-                param.filter = this;
-                param.paintingData = &paintingData;
-                param.clipRight = clipRight;
-                param.clipBottom = clipBottom;
-                param.yStart = startY;
-                startY += job < jobsWithExtra ? heightPerThread + 1 : heightPerThread;
-                param.yEnd = startY;
-            }
-
-            parallelJobs.execute();
+            InteriorPixelParameters param;
+            param.filter = this;
+            param.paintingData = &paintingData;
+            param.clipRight = clipRight;
+            param.clipBottom = clipBottom;
+            param.rowsPerTile = TileWorkerPool::rowsPerTile(paintSize.width() * 4);
+            size_t tiles = (clipBottom + param.rowsPerTile) / param.rowsPerTile;
+            TileWorkerPool::instance()->runTiles("FEConvolveMatrix", tiles, &FEConvolveMatrix::setInteriorPixelsTile, &param, optimalThreadNumber);
         } else {
             // Fallback to single threaded mode.
             setInteriorPixels(paintingData, clipRight, clipBottom, 0, clipBottom);
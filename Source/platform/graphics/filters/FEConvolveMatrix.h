@@ -92,6 +92,10 @@ private:
 
     template<bool preserveAlphaValues>
     ALWAYS_INLINE void fastSetInteriorPixels(PaintingData&, int clipRight, int clipBottom, int yStart, int yEnd);
+#if CPU(X86) || CPU(X86_64)
+    template<bool preserveAlphaValues>
+    inline void fastSetInteriorPixelsSSE2(PaintingData&, int clipRight, int clipBottom, int yStart, int yEnd);
+#endif
 
     ALWAYS_INLINE int getPixelValue(PaintingData&, int x, int y);
 
@@ -105,19 +109,18 @@ private:
     // Parallelization parts
     static const int s_minimalRectDimension = (100 * 100); // Empirical data limit for parallel jobs
 
-    template<typename Type>
-    friend class ParallelJobs;
+    friend class FilterKernelsTest;
 
     struct InteriorPixelParameters {
         FEConvolveMatrix* filter;
         PaintingData* paintingData;
         int clipBottom;
         int clipRight;
-        int yStart;
-        int yEnd;
+        int rowsPerTile;
     };
 
-    static void setInteriorPixelsWorker(InteriorPixelParameters*);
+    // A TileWorkerPool::TileFunction over bands of rowsPerTile interior rows.
+    static void setInteriorPixelsTile(void* parameters, size_t tile);
 
     IntSize m_kernelSize;
     float m_divisor;
@@ -29,8 +29,10 @@
 #include "platform/graphics/filters/FELighting.h"
 
 #include "SkLightingImageFilter.h"
+#include "platform/RuntimeEnabledFeatures.h"
+#include "platform/graphics/TileWorkerPool.h"
+#include "platform/graphics/cpu/x86/filters/FELightingSSE2.h"
 #include "platform/graphics/filters/DistantLightSource.h"
-#include "platform/graphics/filters/ParallelJobs.h"
 #include "platform/graphics/filters/SkiaImageFilterBuilder.h"
 #include "platform/graphics/skia/NativeImageSkia.h"
 
@@ -243,49 +245,55 @@ inline void FELighting::platformApplyGenericPaint(LightingData& data, LightSourc
     IntPoint normalVector;
     int offset = 0;
 
+#if CPU(X86) || CPU(X86_64)
+    const bool useSSE2 = RuntimeEnabledFeatures::filterSIMDKernelsEnabled()
+        && m_lightingType == DiffuseLighting && data.lightSource->type() == LS_DISTANT;
+    IntPoint normalVectors[4];
+#endif
+
     for (int y = startY; y < endY; ++y) {
         offset = y * data.widthMultipliedByPixelSize + cPixelSize;
-        for (int x = 1; x < data.widthDecreasedByOne; ++x, offset += cPixelSize) {
+        int x = 1;
+#if CPU(X86) || CPU(X86_64)
+        if (useSSE2) {
+            for (; x + 4 <= data.widthDecreasedByOne; x += 4, offset += 4 * cPixelSize) {
+                for (int i = 0; i < 4; ++i)
+                    data.interior(offset + i * cPixelSize, normalVectors[i]);
+                setDistantDiffusePixelsSSE2(offset, data, paintingData, cFactor1div4, cFactor1div4, normalVectors);
+            }
+        }
+#endif
+        for (; x < data.widthDecreasedByOne; ++x, offset += cPixelSize) {
             data.interior(offset, normalVector);
             inlineSetPixel(offset, data, paintingData, x, y, cFactor1div4, cFactor1div4, normalVector);
         }
     }
 }
 
-void FELighting::platformApplyGenericWorker(PlatformApplyGenericParameters* parameters)
+void FELighting::platformApplyGenericTile(void* parameters, size_t tile)
 {
-    parameters->filter->platformApplyGenericPaint(parameters->data, parameters->paintingData, parameters->yStart, parameters->yEnd);
+    PlatformApplyGenericParameters* params = static_cast<PlatformApplyGenericParameters*>(parameters);
+    int yStart = 1 + static_cast<int>(tile) * params->rowsPerTile;
+    int yEnd = std::min(yStart + params->rowsPerTile, params->data.heightDecreasedByOne);
+    // Painting updates the light vector for every pixel, so each tile needs
+    // its own copy of the painting data.
+    LightingData data = params->data;
+    LightSource::PaintingData paintingData = params->paintingData;
+    params->filter->platformApplyGenericPaint(data, paintingData, yStart, yEnd);
 }
 
 inline void FELighting::platformApplyGeneric(LightingData& data, LightSource::PaintingData& paintingData)
 {
     int optimalThreadNumber = ((data.widthDecreasedByOne - 1) * (data.heightDecreasedByOne - 1)) / s_minimalRectDimension;
     if (optimalThreadNumber > 1) {
-        // Initialize parallel jobs
-        ParallelJobs<PlatformApplyGenericParameters> parallelJobs(&platformApplyGenericWorker, optimalThreadNumber);
-
-        // Fill the parameter array
-        int job = parallelJobs.numberOfJobs();
-        if (job > 1) {
-            // Split the job into "yStep"-sized jobs but there a few jobs that need to be slightly larger since
-            // yStep * jobs < total size. These extras are handled by the remainder "jobsWithExtra".
-            const int yStep = (data.heightDecreasedByOne - 1) / job;
-            const int jobsWithExtra = (data.heightDecreasedByOne - 1) % job;
-
-            int yStart = 1;
-            for (--job; job >= 0; --job) {
-                PlatformApplyGenericParameters& params = parallelJobs.parameter(job);
-                params.filter = this;
-                params.data = data;
-                params.paintingData = paintingData;
-                params.yStart = yStart;
-                yStart += job < jobsWithExtra ? yStep + 1 : yStep;
-                params.yEnd = yStart;
-            }
-            parallelJobs.execute();
-            return;
-        }
-        // Fallback to single threaded mode.
+        PlatformApplyGenericParameters params;
+        params.filter = this;
+        params.data = data;
+        params.paintingData = paintingData;
+        params.rowsPerTile = TileWorkerPool::rowsPerTile(data.widthMultipliedByPixelSize);
+        size_t tiles = (data.heightDecreasedByOne - 1 + params.rowsPerTile - 1) / params.rowsPerTile;
+        TileWorkerPool::instance()->runTiles("FELighting", tiles, &FELighting::platformApplyGenericTile, &params, optimalThreadNumber);
+        return;
     }
 
     platformApplyGenericPaint(data, paintingData, 1, data.heightDecreasedByOne);
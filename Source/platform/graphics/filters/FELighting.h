@@ -72,21 +72,20 @@ protected:
         inline void bottomRight(int offset, IntPoint& normalVector);
     };
 
-    template<typename Type>
-    friend class ParallelJobs;
+    friend class FilterKernelsTest;
 
     struct PlatformApplyGenericParameters {
         FELighting* filter;
         LightingData data;
         LightSource::PaintingData paintingData;
-        int yStart;
-        int yEnd;
+        int rowsPerTile;
     };
 
     virtual FloatRect mapPaintRect(const FloatRect&, bool forward = true) OVERRIDE FINAL;
     virtual bool affectsTransparentPixels() OVERRIDE { return true; }
 
-    static void platformApplyGenericWorker(PlatformApplyGenericParameters*);
+    // A TileWorkerPool::TileFunction over bands of rowsPerTile interior rows.
+    static void platformApplyGenericTile(void* parameters, size_t tile);
 
     FELighting(Filter*, LightingType, const Color&, float, float, float, float, float, float, PassRefPtr<LightSource>);
 
@@ -98,6 +97,11 @@ protected:
     void setPixel(int offset, LightingData&, LightSource::PaintingData&,
                   int lightX, int lightY, float factorX, float factorY, IntPoint& normalVector);
 
+#if CPU(X86) || CPU(X86_64)
+    inline void setDistantDiffusePixelsSSE2(int offset, LightingData&, LightSource::PaintingData&,
+        float factorX, float factorY, const IntPoint normalVectors[4]);
+#endif
+
     inline void platformApply(LightingData&, LightSource::PaintingData&);
 
     inline void platformApplyGenericPaint(LightingData&, LightSource::PaintingData&, int startX, int startY);
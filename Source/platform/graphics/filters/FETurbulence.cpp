@@ -28,7 +28,7 @@
 
 #include "SkPerlinNoiseShader.h"
 #include "SkRectShaderImageFilter.h"
-#include "platform/graphics/filters/ParallelJobs.h"
+#include "platform/graphics/TileWorkerPool.h"
 #include "platform/graphics/filters/SkiaImageFilterBuilder.h"
 #include "platform/text/TextStream.h"
 #include "wtf/MathExtras.h"
@@ -346,9 +346,12 @@ inline void FETurbulence::fillRegion(Uint8ClampedArray* pixelArray, PaintingData
     }
 }
 
-void FETurbulence::fillRegionWorker(FillRegionParameters* parameters)
+void FETurbulence::fillRegionTile(void* parameters, size_t tile)
 {
-    parameters->filter->fillRegion(parameters->pixelArray, *parameters->paintingData, parameters->startY, parameters->endY, parameters->baseFrequencyX, parameters->baseFrequencyY);
+    FillRegionParameters* params = static_cast<FillRegionParameters*>(parameters);
+    int startY = static_cast<int>(tile) * params->rowsPerTile;
+    int endY = std::min(startY + params->rowsPerTile, params->height);
+    params->filter->fillRegion(params->pixelArray, *params->paintingData, startY, endY, params->baseFrequencyX, params->baseFrequencyY);
 }
 
 void FETurbulence::applySoftware()
@@ -367,37 +370,20 @@ void FETurbulence::applySoftware()
 
     int optimalThreadNumber = (absolutePaintRect().width() * absolutePaintRect().height()) / s_minimalRectDimension;
     if (optimalThreadNumber > 1) {
-        // Initialize parallel jobs
-        ParallelJobs<FillRegionParameters> parallelJobs(&FETurbulence::fillRegionWorker, optimalThreadNumber);
-
-        // Fill the parameter array
-        int i = parallelJobs.numberOfJobs();
-        if (i > 1) {
-            // Split the job into "stepY"-sized jobs but there a few jobs that need to be slightly larger since
-            // stepY * jobs < total size. These extras are handled by the remainder "jobsWithExtra".
-            const int stepY = absolutePaintRect().height() / i;
-            const int jobsWithExtra = absolutePaintRect().height() % i;
-
-            int startY = 0;
-            for (; i > 0; --i) {
-                FillRegionParameters& params = parallelJobs.parameter(i-1);
-                params.filter = this;
-                params.pixelArray = pixelArray;
-                params.paintingData = &paintingData;
-                params.startY = startY;
-                startY += i < jobsWithExtra ? stepY + 1 : stepY;
-                params.endY = startY;
-                params.baseFrequencyX = m_baseFrequencyX;
-                params.baseFrequencyY = m_baseFrequencyY;
-            }
-
-            // Execute parallel jobs
-            parallelJobs.execute();
-            return;
-        }
+        FillRegionParameters params;
+        params.filter = this;
+        params.pixelArray = pixelArray;
+        params.paintingData = &paintingData;
+        params.height = absolutePaintRect().height();
+        params.rowsPerTile = TileWorkerPool::rowsPerTile(absolutePaintRect().width() * 4);
+        params.baseFrequencyX = m_baseFrequencyX;
+        params.baseFrequencyY = m_baseFrequencyY;
+        size_t tiles = (params.height + params.rowsPerTile - 1) / params.rowsPerTile;
+        TileWorkerPool::instance()->runTiles("FETurbulence", tiles, &FETurbulence::fillRegionTile, &params, optimalThreadNumber);
+        return;
     }
 
-    // Fallback to single threaded mode if there is no room for a new thread or the paint area is too small.
+    // Fallback to single threaded mode if the paint area is too small.
     fillRegion(pixelArray, paintingData, 0, absolutePaintRect().height(), m_baseFrequencyX, m_baseFrequencyY);
 }
 
@@ -58,8 +58,6 @@ public:
     bool stitchTiles() const;
     bool setStitchTiles(bool);
 
-    static void fillRegionWorker(void*);
-
     virtual TextStream& externalRepresentation(TextStream&, int indention) const OVERRIDE;
 
 private:
@@ -98,20 +96,18 @@ private:
         int wrapY;
     };
 
-    template<typename Type>
-    friend class ParallelJobs;
-
     struct FillRegionParameters {
         FETurbulence* filter;
         Uint8ClampedArray* pixelArray;
         PaintingData* paintingData;
-        int startY;
-        int endY;
+        int height;
+        int rowsPerTile;
         float baseFrequencyX;
         float baseFrequencyY;
     };
 
-    static void fillRegionWorker(FillRegionParameters*);
+    // A TileWorkerPool::TileFunction over bands of rowsPerTile rows.
+    static void fillRegionTile(void* parameters, size_t tile);
 
     FETurbulence(Filter*, TurbulenceType, float, float, int, float, bool);
 
@@ -282,6 +282,45 @@ void FilterEffect::clearResultsRecursive()
         m_inputEffects.at(i).get()->clearResultsRecursive();
 }
 
+FloatRect FilterEffect::invalidateResultsRecursive(const FloatRect& sourceDirtyRect)
+{
+    FloatRect dirtyRect;
+    if (filterEffectType() == FilterEffectTypeSourceInput) {
+        dirtyRect = sourceDirtyRect;
+    } else if (filterEffectType() == FilterEffectTypeImage) {
+        // feImage can draw an element that repaints without the filter being rebuilt.
+        dirtyRect = m_absolutePaintRect;
+    } else {
+        FloatRect inputDirtyRect;
+        unsigned size = m_inputEffects.size();
+        for (unsigned i = 0; i < size; ++i)
+            inputDirtyRect.unite(m_inputEffects.at(i)->invalidateResultsRecursive(sourceDirtyRect));
+        if (!inputDirtyRect.isEmpty())
+            dirtyRect = mapPaintRect(inputDirtyRect, true);
+    }
+
+    dirtyRect.intersect(m_absolutePaintRect);
+    if (dirtyRect.isEmpty())
+        return FloatRect();
+
+    IntRect absolutePaintRect = m_absolutePaintRect;
+    clearResult();
+    m_absolutePaintRect = absolutePaintRect;
+    return dirtyRect;
+}
+
+size_t FilterEffect::resultMemoryUsage() const
+{
+    size_t bytes = 0;
+    if (m_imageBufferResult)
+        bytes += 4 * static_cast<size_t>(m_imageBufferResult->size().width()) * m_imageBufferResult->size().height();
+    if (m_unmultipliedImageResult)
+        bytes += m_unmultipliedImageResult->length();
+    if (m_premultipliedImageResult)
+        bytes += m_premultipliedImageResult->length();
+    return bytes;
+}
+
 ImageBuffer* FilterEffect::asImageBuffer()
 {
     if (!hasResult())
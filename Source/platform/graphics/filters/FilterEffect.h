@@ -73,6 +73,17 @@ public:
     void clearResult();
     void clearResultsRecursive();
 
+    // Clears the results made stale by a repaint of |sourceDirtyRect| in the
+    // filter's source image, which is mapped forward through the effect graph
+    // with mapPaintRect(). The other results are kept for the next apply(),
+    // and paint rects are left alone so that recomputed results line up with
+    // the kept ones. Returns the part of this effect's paint rect that changed.
+    // Note: This works in absolute coordinates!
+    FloatRect invalidateResultsRecursive(const FloatRect& sourceDirtyRect);
+
+    // The number of bytes held by the result of this effect.
+    size_t resultMemoryUsage() const;
+
     ImageBuffer* asImageBuffer();
     PassRefPtr<Uint8ClampedArray> asUnmultipliedImage(const IntRect&);
     PassRefPtr<Uint8ClampedArray> asPremultipliedImage(const IntRect&);
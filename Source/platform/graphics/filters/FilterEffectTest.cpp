@@ -0,0 +1,125 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/filters/FilterEffect.h"
+
+#include "platform/graphics/ImageBuffer.h"
+#include "platform/graphics/filters/FEFlood.h"
+#include "platform/graphics/filters/FEMerge.h"
+#include "platform/graphics/filters/FEOffset.h"
+#include "platform/graphics/filters/Filter.h"
+#include "platform/graphics/filters/SourceGraphic.h"
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+class SourceImageFilter : public Filter {
+public:
+    static PassRefPtr<SourceImageFilter> create(const IntRect& sourceImageRect)
+    {
+        return adoptRef(new SourceImageFilter(sourceImageRect));
+    }
+
+    virtual IntRect sourceImageRect() const OVERRIDE { return m_sourceImageRect; }
+
+private:
+    explicit SourceImageFilter(const IntRect& sourceImageRect)
+        : Filter(AffineTransform())
+        , m_sourceImageRect(sourceImageRect)
+    {
+        setSourceImage(ImageBuffer::create(sourceImageRect.size()));
+        setFilterRegion(sourceImageRect);
+    }
+
+    IntRect m_sourceImageRect;
+};
+
+// merge(offset(SourceGraphic), flood) over a 100x100 source.
+class FilterEffectTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        m_filter = SourceImageFilter::create(IntRect(0, 0, 100, 100));
+        m_source = SourceGraphic::create(m_filter.get());
+        m_offset = FEOffset::create(m_filter.get(), 10, 0);
+        m_offset->inputEffects().append(m_source);
+        m_flood = FEFlood::create(m_filter.get(), Color::black, 1);
+        m_merge = FEMerge::create(m_filter.get());
+        m_merge->inputEffects().append(m_offset);
+        m_merge->inputEffects().append(m_flood);
+
+        m_source->setClipsToBounds(false);
+        m_flood->setClipsToBounds(false);
+        m_merge->setClipsToBounds(false);
+        m_merge->setMaxEffectRect(FloatRect(0, 0, 100, 100));
+    }
+
+    void applyAll()
+    {
+        m_merge->apply();
+        ASSERT_TRUE(m_source->hasResult());
+        ASSERT_TRUE(m_offset->hasResult());
+        ASSERT_TRUE(m_flood->hasResult());
+        ASSERT_TRUE(m_merge->hasResult());
+    }
+
+    RefPtr<SourceImageFilter> m_filter;
+    RefPtr<FilterEffect> m_source;
+    RefPtr<FilterEffect> m_offset;
+    RefPtr<FilterEffect> m_flood;
+    RefPtr<FilterEffect> m_merge;
+};
+
+TEST_F(FilterEffectTest, DirtySourceClearsDependentResultsOnly)
+{
+    m_offset->setClipsToBounds(false);
+    applyAll();
+    IntRect mergePaintRect = m_merge->absolutePaintRect();
+
+    EXPECT_EQ(FloatRect(10, 0, 5, 5), m_merge->invalidateResultsRecursive(FloatRect(0, 0, 5, 5)));
+    EXPECT_FALSE(m_source->hasResult());
+    EXPECT_FALSE(m_offset->hasResult());
+    EXPECT_FALSE(m_merge->hasResult());
+    EXPECT_TRUE(m_flood->hasResult());
+    EXPECT_EQ(mergePaintRect, m_merge->absolutePaintRect());
+
+    applyAll();
+    EXPECT_EQ(mergePaintRect, m_merge->absolutePaintRect());
+}
+
+TEST_F(FilterEffectTest, DirtyRectOutsidePaintRectsKeepsResults)
+{
+    // The offset only needs the right half of the source.
+    m_offset->setClipsToBounds(true);
+    m_offset->setMaxEffectRect(FloatRect(50, 0, 50, 100));
+    applyAll();
+
+    EXPECT_TRUE(m_merge->invalidateResultsRecursive(FloatRect(0, 0, 5, 5)).isEmpty());
+    EXPECT_TRUE(m_source->hasResult());
+    EXPECT_TRUE(m_offset->hasResult());
+    EXPECT_TRUE(m_flood->hasResult());
+    EXPECT_TRUE(m_merge->hasResult());
+
+    EXPECT_FALSE(m_merge->invalidateResultsRecursive(FloatRect(45, 0, 5, 5)).isEmpty());
+    EXPECT_FALSE(m_source->hasResult());
+    EXPECT_FALSE(m_merge->hasResult());
+    EXPECT_TRUE(m_flood->hasResult());
+}
+
+TEST_F(FilterEffectTest, ResultMemoryUsage)
+{
+    m_offset->setClipsToBounds(false);
+    EXPECT_EQ(0u, m_merge->resultMemoryUsage());
+
+    applyAll();
+    EXPECT_EQ(100u * 100 * 4, m_merge->resultMemoryUsage());
+
+    m_merge->clearResult();
+    EXPECT_EQ(0u, m_merge->resultMemoryUsage());
+}
+
+} // namespace
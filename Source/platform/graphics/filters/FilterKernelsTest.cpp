@@ -0,0 +1,130 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+
+#include "platform/RuntimeEnabledFeatures.h"
+#include "platform/graphics/filters/DistantLightSource.h"
+#include "platform/graphics/filters/FEConvolveMatrix.h"
+#include "platform/graphics/filters/FEDiffuseLighting.h"
+#include "platform/graphics/filters/ReferenceFilter.h"
+#include "wtf/Uint8ClampedArray.h"
+#include <gtest/gtest.h>
+
+namespace blink {
+
+// The SIMD kernels must produce exactly the same pixels as the scalar loops
+// they replace. Each test runs an effect both ways on the same input.
+class FilterKernelsTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        m_simdKernelsWereEnabled = RuntimeEnabledFeatures::filterSIMDKernelsEnabled();
+        m_filter = ReferenceFilter::create();
+    }
+
+    virtual void TearDown()
+    {
+        RuntimeEnabledFeatures::setFilterSIMDKernelsEnabled(m_simdKernelsWereEnabled);
+    }
+
+    // A deterministic, noisy image so that every pixel takes a different path.
+    static PassRefPtr<Uint8ClampedArray> createPixels(int width, int height)
+    {
+        RefPtr<Uint8ClampedArray> pixels = Uint8ClampedArray::createUninitialized(width * height * 4);
+        unsigned seed = 12345;
+        for (unsigned i = 0; i < pixels->length(); ++i) {
+            seed = seed * 1103515245 + 12345;
+            pixels->set(i, (seed >> 16) & 0xff);
+        }
+        return pixels.release();
+    }
+
+    static void expectSamePixels(Uint8ClampedArray* expected, Uint8ClampedArray* actual)
+    {
+        ASSERT_EQ(expected->length(), actual->length());
+        for (unsigned i = 0; i < expected->length(); ++i)
+            ASSERT_EQ(expected->item(i), actual->item(i)) << "at byte " << i;
+    }
+
+    PassRefPtr<Uint8ClampedArray> convolveInteriorPixels(FEConvolveMatrix* effect, Uint8ClampedArray* source, int width, int height, bool useSIMD)
+    {
+        RuntimeEnabledFeatures::setFilterSIMDKernelsEnabled(useSIMD);
+        RefPtr<Uint8ClampedArray> destination = Uint8ClampedArray::create(source->length());
+
+        FEConvolveMatrix::PaintingData paintingData;
+        paintingData.srcPixelArray = source;
+        paintingData.dstPixelArray = destination.get();
+        paintingData.width = width;
+        paintingData.height = height;
+        paintingData.bias = effect->bias() * 255;
+
+        FEConvolveMatrix::InteriorPixelParameters parameters;
+        parameters.filter = effect;
+        parameters.paintingData = &paintingData;
+        parameters.clipRight = width - effect->kernelSize().width();
+        parameters.clipBottom = height - effect->kernelSize().height();
+        parameters.rowsPerTile = parameters.clipBottom + 1;
+        FEConvolveMatrix::setInteriorPixelsTile(&parameters, 0);
+        return destination.release();
+    }
+
+    void testConvolveMatrix(const IntSize& kernelSize, const IntPoint& targetOffset, float divisor, float bias, bool preserveAlpha)
+    {
+        Vector<float> kernel;
+        for (int i = 0; i < kernelSize.width() * kernelSize.height(); ++i)
+            kernel.append((i % 3 - 1) * 0.75f + i * 0.125f);
+        RefPtr<FEConvolveMatrix> effect = FEConvolveMatrix::create(m_filter.get(), kernelSize, divisor, bias, targetOffset,
+            EDGEMODE_DUPLICATE, FloatPoint(1, 1), preserveAlpha, kernel);
+
+        const int width = 37;
+        const int height = 23;
+        RefPtr<Uint8ClampedArray> source = createPixels(width, height);
+        RefPtr<Uint8ClampedArray> scalar = convolveInteriorPixels(effect.get(), source.get(), width, height, false);
+        RefPtr<Uint8ClampedArray> simd = convolveInteriorPixels(effect.get(), source.get(), width, height, true);
+        expectSamePixels(scalar.get(), simd.get());
+    }
+
+    PassRefPtr<Uint8ClampedArray> drawDiffuseLighting(Uint8ClampedArray* source, int width, int height, bool useSIMD)
+    {
+        RuntimeEnabledFeatures::setFilterSIMDKernelsEnabled(useSIMD);
+        RefPtr<FEDiffuseLighting> effect = FEDiffuseLighting::create(m_filter.get(), Color(255, 200, 120), 5, 1.5f, 1, 1,
+            DistantLightSource::create(45, 30));
+        RefPtr<Uint8ClampedArray> pixels = Uint8ClampedArray::create(source->data(), source->length());
+        EXPECT_TRUE(static_cast<FELighting*>(effect.get())->drawLighting(pixels.get(), width, height));
+        return pixels.release();
+    }
+
+    RefPtr<ReferenceFilter> m_filter;
+    bool m_simdKernelsWereEnabled;
+};
+
+TEST_F(FilterKernelsTest, convolveMatrixMatchesScalar)
+{
+    testConvolveMatrix(IntSize(3, 3), IntPoint(1, 1), 2, 0, false);
+}
+
+TEST_F(FilterKernelsTest, convolveMatrixPreserveAlphaMatchesScalar)
+{
+    testConvolveMatrix(IntSize(3, 3), IntPoint(1, 1), 2, 0, true);
+}
+
+TEST_F(FilterKernelsTest, convolveMatrixWithBiasAndOffsetMatchesScalar)
+{
+    testConvolveMatrix(IntSize(5, 2), IntPoint(3, 0), -3, 0.25f, false);
+    testConvolveMatrix(IntSize(5, 2), IntPoint(3, 0), -3, 0.25f, true);
+}
+
+TEST_F(FilterKernelsTest, distantDiffuseLightingMatchesScalar)
+{
+    // The width leaves a remainder after the groups of four interior pixels.
+    const int width = 42;
+    const int height = 17;
+    RefPtr<Uint8ClampedArray> source = createPixels(width, height);
+    RefPtr<Uint8ClampedArray> scalar = drawDiffuseLighting(source.get(), width, height, false);
+    RefPtr<Uint8ClampedArray> simd = drawDiffuseLighting(source.get(), width, height, true);
+    expectSamePixels(scalar.get(), simd.get());
+}
+
+} // namespace blink
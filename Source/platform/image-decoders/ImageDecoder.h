@@ -118,6 +118,13 @@ public:
     // return the actual decoded size.
     virtual IntSize decodedSize() const { return size(); }
 
+    // Asks decoders that can cheaply scale down while decoding, such as JPEG,
+    // to produce an image no smaller than |size| instead of the full image.
+    // decodedSize() reports the size they settle on; other decoders ignore
+    // this. Must be called before the size is known.
+    void setTargetDecodedSize(const IntSize& size) { m_targetDecodedSize = size; }
+    IntSize targetDecodedSize() const { return m_targetDecodedSize; }
+
     // Decoders which support YUV decoding can override this to
     // give potentially different sizes per component.
     virtual IntSize decodedYUVSize(int component, SizeType) const { return decodedSize(); }
@@ -310,6 +317,9 @@ protected:
     // memory devices.
     size_t m_maxDecodedBytes;
 
+    // See setTargetDecodedSize(). Empty means decode at full size.
+    IntSize m_targetDecodedSize;
+
 private:
     // Some code paths compute the size of the image as "width * height * 4"
     // and return it as a (signed) int.  Avoid overflow.
@@ -726,17 +726,31 @@ IntSize JPEGImageDecoder::decodedYUVSize(int component, ImageDecoder::SizeType s
     return computeYUVSize(info, component, sizeType);
 }
 
+// Matches the rounding of jpeg_calc_output_dimensions().
+static int scaledDimension(int dimension, unsigned scaleNumerator)
+{
+    return (static_cast<uint64_t>(dimension) * scaleNumerator + scaleDenominator - 1) / scaleDenominator;
+}
+
 unsigned JPEGImageDecoder::desiredScaleNumerator() const
 {
+    unsigned scaleNumerator = scaleDenominator;
     size_t originalBytes = size().width() * size().height() * 4;
-    if (originalBytes <= m_maxDecodedBytes) {
-        return scaleDenominator;
+    if (originalBytes > m_maxDecodedBytes) {
+        // Downsample according to the maximum decoded size.
+        scaleNumerator = static_cast<unsigned>(floor(sqrt(
+            // MSVC needs explicit parameter type for sqrt().
+            static_cast<float>(m_maxDecodedBytes * scaleDenominator * scaleDenominator / originalBytes))));
     }
 
-    // Downsample according to the maximum decoded size.
-    unsigned scaleNumerator = static_cast<unsigned>(floor(sqrt(
-        // MSVC needs explicit parameter type for sqrt().
-        static_cast<float>(m_maxDecodedBytes * scaleDenominator * scaleDenominator / originalBytes))));
+    // Let the IDCT scale down as far as it can without going below the
+    // target size.
+    if (!m_targetDecodedSize.isEmpty()) {
+        while (scaleNumerator > 1
+            && scaledDimension(size().width(), scaleNumerator - 1) >= m_targetDecodedSize.width()
+            && scaledDimension(size().height(), scaleNumerator - 1) >= m_targetDecodedSize.height())
+            --scaleNumerator;
+    }
 
     return scaleNumerator;
 }
@@ -37,9 +37,11 @@
 #include "public/platform/WebData.h"
 #include "public/platform/WebSize.h"
 #include "public/platform/WebUnitTestSupport.h"
+#include "wtf/MathExtras.h"
 #include "wtf/OwnPtr.h"
 #include "wtf/PassOwnPtr.h"
 #include "wtf/StringHasher.h"
+#include "wtf/Vector.h"
 
 #include <gtest/gtest.h>
 
@@ -79,6 +81,22 @@ void downsample(size_t maxDecodedBytes, unsigned* outputWidth, unsigned* outputH
     EXPECT_EQ(IntSize(*outputWidth, *outputHeight), decoder->decodedSize());
 }
 
+void decodeToSize(size_t maxDecodedBytes, const IntSize& targetSize, unsigned* outputWidth, unsigned* outputHeight, const char* imageFilePath)
+{
+    RefPtr<SharedBuffer> data = readFile(imageFilePath);
+    ASSERT_TRUE(data.get());
+
+    OwnPtr<JPEGImageDecoder> decoder = createDecoder(maxDecodedBytes);
+    decoder->setTargetDecodedSize(targetSize);
+    decoder->setData(data.get(), true);
+
+    ImageFrame* frame = decoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    *outputWidth = frame->getSkBitmap().width();
+    *outputHeight = frame->getSkBitmap().height();
+    EXPECT_EQ(IntSize(*outputWidth, *outputHeight), decoder->decodedSize());
+}
+
 void readYUV(size_t maxDecodedBytes, unsigned* outputYWidth, unsigned* outputYHeight, unsigned* outputUVWidth, unsigned* outputUVHeight, const char* imageFilePath)
 {
     RefPtr<SharedBuffer> data = readFile(imageFilePath);
@@ -213,6 +231,32 @@ TEST(JPEGImageDecoderTest, upsample)
     EXPECT_EQ(256u, outputHeight);
 }
 
+// Tests that a target size makes the decoder scale down as far as it can
+// without going below the target.
+TEST(JPEGImageDecoderTest, decodeToTargetSize)
+{
+    const char* jpegFile = "/LayoutTests/fast/images/resources/lenna.jpg"; // 256x256
+    unsigned outputWidth, outputHeight;
+
+    decodeToSize(LargeEnoughSize, IntSize(60, 60), &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(64u, outputWidth);
+    EXPECT_EQ(64u, outputHeight);
+
+    decodeToSize(LargeEnoughSize, IntSize(64, 64), &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(64u, outputWidth);
+    EXPECT_EQ(64u, outputHeight);
+
+    // The larger dimension of the target decides.
+    decodeToSize(LargeEnoughSize, IntSize(10, 100), &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(128u, outputWidth);
+    EXPECT_EQ(128u, outputHeight);
+
+    // The memory limit still applies.
+    decodeToSize(100 * 100 * 4, IntSize(200, 200), &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(96u, outputWidth);
+    EXPECT_EQ(96u, outputHeight);
+}
+
 TEST(JPEGImageDecoderTest, yuv)
 {
     const char* jpegFile = "/LayoutTests/fast/images/resources/lenna.jpg"; // 256x256, YUV 4:2:0
@@ -223,3 +267,61 @@ TEST(JPEGImageDecoderTest, yuv)
     EXPECT_EQ(128u, outputUVWidth);
     EXPECT_EQ(128u, outputUVHeight);
 }
+
+TEST(JPEGImageDecoderTest, yuvMatchesRGBA)
+{
+    const char* jpegFile = "/LayoutTests/fast/images/resources/lenna.jpg"; // 256x256, YUV 4:2:0
+    RefPtr<SharedBuffer> data = readFile(jpegFile);
+    ASSERT_TRUE(data.get());
+
+    OwnPtr<JPEGImageDecoder> yuvDecoder = createDecoder(LargeEnoughSize);
+    yuvDecoder->setData(data.get(), true);
+    yuvDecoder->setImagePlanes(adoptPtr(new ImagePlanes()));
+    ASSERT_TRUE(yuvDecoder->isSizeAvailable());
+
+    // libjpeg writes whole DCT blocks, so the planes are allocated with the
+    // padded sizes but only the actual sizes hold image data.
+    void* planes[3];
+    size_t rowBytes[3];
+    Vector<char> planeStorage[3];
+    size_t planarBytes = 0;
+    for (int i = 0; i < 3; ++i) {
+        IntSize allocationSize = yuvDecoder->decodedYUVSize(i, ImageDecoder::SizeForMemoryAllocation);
+        planeStorage[i].resize(allocationSize.width() * allocationSize.height());
+        planes[i] = planeStorage[i].data();
+        rowBytes[i] = allocationSize.width();
+        planarBytes += yuvDecoder->decodedYUVSize(i, ImageDecoder::ActualSize).area();
+    }
+    yuvDecoder->setImagePlanes(adoptPtr(new ImagePlanes(planes, rowBytes)));
+    ASSERT_TRUE(yuvDecoder->decodeToYUV());
+
+    OwnPtr<JPEGImageDecoder> rgbaDecoder = createDecoder(LargeEnoughSize);
+    rgbaDecoder->setData(data.get(), true);
+    ImageFrame* frame = rgbaDecoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    ASSERT_EQ(ImageFrame::FrameComplete, frame->status());
+    const SkBitmap& bitmap = frame->getSkBitmap();
+    ASSERT_EQ(256, bitmap.width());
+    ASSERT_EQ(256, bitmap.height());
+
+    // 4:2:0 planes take 1.5 bytes per pixel against 4 for RGBA.
+    size_t rgbaBytes = bitmap.width() * bitmap.height() * 4;
+    EXPECT_EQ(256u * 256u + 2 * 128u * 128u, planarBytes);
+    EXPECT_EQ(rgbaBytes * 3, planarBytes * 8);
+
+    // The chroma terms cancel out when luma is computed back from the RGB
+    // output, so whatever upsampling libjpeg used for the RGB decode, the
+    // luma of each pixel only differs from the Y plane by rounding and
+    // clamping.
+    SkAutoLockPixels lock(bitmap);
+    const unsigned char* yPlane = static_cast<const unsigned char*>(planes[0]);
+    double totalDifference = 0;
+    for (int y = 0; y < bitmap.height(); ++y) {
+        for (int x = 0; x < bitmap.width(); ++x) {
+            SkColor color = bitmap.getColor(x, y);
+            double luma = 0.299 * SkColorGetR(color) + 0.587 * SkColorGetG(color) + 0.114 * SkColorGetB(color);
+            totalDifference += fabs(luma - yPlane[y * rowBytes[0] + x]);
+        }
+    }
+    EXPECT_LT(totalDifference / (bitmap.width() * bitmap.height()), 1.0);
+}
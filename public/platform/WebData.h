@@ -45,6 +45,17 @@ class WebDataPrivate;
 //
 class BLINK_PLATFORM_EXPORT WebData {
 public:
+    // Immutable memory owned by the embedder, such as a memory-mapped file
+    // backing a file:// load or a disk cache hit. It is referenced rather
+    // than copied, and deleted once Blink no longer needs it, possibly on
+    // another thread.
+    class ExternalMemory {
+    public:
+        virtual ~ExternalMemory() { }
+        virtual const char* data() const = 0;
+        virtual size_t size() const = 0;
+    };
+
     ~WebData() { reset(); }
 
     WebData() { }
@@ -71,6 +82,8 @@ public:
     void reset();
     void assign(const WebData&);
     void assign(const char* data, size_t size);
+    // Takes ownership of |memory|.
+    void assign(ExternalMemory*);
 
     size_t size() const;
     const char* data() const;